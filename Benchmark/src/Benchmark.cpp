@@ -0,0 +1,624 @@
+#include "Benchmark.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <regex>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+
+#include <unistd.h>
+
+namespace zen::benchmark {
+    namespace {
+        /* Calibration stops growing the iteration count here */
+        constexpr size_t MAX_ITERATIONS = 1000000000;
+
+        double cpuSeconds() {
+            timespec now;
+            clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &now);
+
+            return static_cast<double>(now.tv_sec) + static_cast<double>(now.tv_nsec) * 1e-9;
+        }
+
+        std::vector<std::unique_ptr<Benchmark>>& registry() {
+            static std::vector<std::unique_ptr<Benchmark>> benchmarks;
+            return benchmarks;
+        }
+
+        /* Maps 64 random bits to [0, limit) without modulo bias worth measuring; identical on every platform */
+        uint64_t below(std::mt19937_64& generator, uint64_t limit) {
+            return static_cast<uint64_t>((static_cast<__uint128_t>(generator()) * limit) >> 64);
+        }
+
+        double unit(std::mt19937_64& generator) {
+            return static_cast<double>(generator() >> 11) * 0x1.0p-53;
+        }
+
+        struct Options {
+            std::string filter;
+            double minTime = 0.5;
+            size_t repetitions = 1;
+            std::string jsonPath;
+            bool list = false;
+        };
+
+        struct Result {
+            std::string name;
+            std::string aggregate;          ///< Empty for a measured run, "median" for aggregate rows
+            size_t iterations = 0;
+            double realTime = 0;            ///< Nanoseconds per iteration
+            double cpuTime = 0;             ///< Nanoseconds of process CPU time per iteration
+            double itemsPerSecond = 0;
+            double bytesPerSecond = 0;
+            std::string label;
+            std::vector<std::pair<std::string, double>> counters;
+            std::vector<std::pair<std::string, double>> percentiles;
+        };
+
+        std::string formatTime(double nanoseconds) {
+            char buffer[32];
+
+            if (nanoseconds < 1e3) {
+                std::snprintf(buffer, sizeof(buffer), "%.2f ns", nanoseconds);
+            } else if (nanoseconds < 1e6) {
+                std::snprintf(buffer, sizeof(buffer), "%.2f us", nanoseconds / 1e3);
+            } else if (nanoseconds < 1e9) {
+                std::snprintf(buffer, sizeof(buffer), "%.2f ms", nanoseconds / 1e6);
+            } else {
+                std::snprintf(buffer, sizeof(buffer), "%.3f s", nanoseconds / 1e9);
+            }
+
+            return buffer;
+        }
+
+        std::string formatRate(double value, const char* suffix) {
+            static const char* prefixes[] = {"", "k", "M", "G", "T"};
+            size_t prefix = 0;
+
+            while (value >= 1000 && prefix + 1 < std::size(prefixes)) {
+                value /= 1000;
+                prefix++;
+            }
+
+            char buffer[48];
+            std::snprintf(buffer, sizeof(buffer), "%.2f%s%s", value, prefixes[prefix], suffix);
+
+            return buffer;
+        }
+
+        std::string escapeJson(const std::string& text) {
+            std::string result;
+            result.reserve(text.size());
+
+            for (char character : text) {
+                switch (character) {
+                    case '"':
+                        result += "\\\"";
+                        break;
+                    case '\\':
+                        result += "\\\\";
+                        break;
+                    case '\n':
+                        result += "\\n";
+                        break;
+                    case '\t':
+                        result += "\\t";
+                        break;
+                    default:
+                        if (static_cast<unsigned char>(character) < 0x20) {
+                            char buffer[8];
+                            std::snprintf(buffer, sizeof(buffer), "\\u%04x", character);
+                            result += buffer;
+                        } else {
+                            result += character;
+                        }
+                }
+            }
+
+            return result;
+        }
+
+        std::string formatNumber(double value) {
+            if (!std::isfinite(value)) {
+                return "null";
+            }
+
+            char buffer[32];
+            std::snprintf(buffer, sizeof(buffer), "%.17g", value);
+
+            return buffer;
+        }
+
+        void printUsage(const char* program) {
+            std::cerr << "usage: " << program
+                      << " [--filter=REGEX] [--min-time=SECONDS] [--repetitions=N] [--json=PATH] [--list]" << std::endl;
+        }
+
+        bool parseOptions(int argc, char** argv, Options& options) {
+            for (int i = 1; i < argc; i++) {
+                std::string argument = argv[i];
+                auto value = [&argument](const std::string& prefix) {
+                    return argument.substr(prefix.size());
+                };
+
+                try {
+                    if (argument.starts_with("--filter=")) {
+                        options.filter = value("--filter=");
+                    } else if (argument.starts_with("--min-time=")) {
+                        options.minTime = std::stod(value("--min-time="));
+                    } else if (argument.starts_with("--repetitions=")) {
+                        options.repetitions = std::max<size_t>(1, std::stoul(value("--repetitions=")));
+                    } else if (argument.starts_with("--json=")) {
+                        options.jsonPath = value("--json=");
+                    } else if (argument == "--list") {
+                        options.list = true;
+                    } else {
+                        return false;
+                    }
+                } catch (const std::exception&) {
+                    return false;
+                }
+            }
+
+            return true;
+        }
+    }
+
+    /**
+     * @brief Calibrates, runs and reports the registered benchmarks
+     */
+    class Runner {
+        private:
+            const Options& options;
+            std::vector<Result> results;
+
+            static std::string instanceName(const Benchmark& benchmark, const std::vector<int64_t>& arguments) {
+                std::string name = benchmark.name;
+
+                for (int64_t argument : arguments) {
+                    name += "/" + std::to_string(argument);
+                }
+
+                return name;
+            }
+
+            Result measure(const Benchmark& benchmark, const std::vector<int64_t>& arguments) const {
+                size_t iterations = benchmark.fixedIterations > 0 ? benchmark.fixedIterations : 1;
+
+                while (true) {
+                    State state(iterations, arguments);
+                    benchmark.function(state);
+
+                    if (state.remaining == iterations) {
+                        throw std::logic_error("the benchmark never called keepRunning()");
+                    }
+
+                    double seconds = std::chrono::duration<double>(state.elapsed).count();
+
+                    if (benchmark.fixedIterations > 0 || seconds >= options.minTime || iterations >= MAX_ITERATIONS) {
+                        return summarize(state, seconds);
+                    }
+
+                    /* Aim 40% past the minimum so the next run is very likely the last */
+                    double factor = seconds <= options.minTime / 100 ? 10 : options.minTime * 1.4 / seconds;
+                    size_t next = static_cast<size_t>(static_cast<double>(iterations) * factor);
+
+                    iterations = std::clamp(next, iterations + 1, MAX_ITERATIONS);
+                }
+            }
+
+            static Result summarize(State& state, double seconds) {
+                Result result;
+                result.iterations = state.iterations;
+                result.realTime = seconds * 1e9 / static_cast<double>(state.iterations);
+                result.cpuTime = state.cpuElapsed * 1e9 / static_cast<double>(state.iterations);
+                result.itemsPerSecond = seconds > 0 ? static_cast<double>(state.items) / seconds : 0;
+                result.bytesPerSecond = seconds > 0 ? static_cast<double>(state.bytes) / seconds : 0;
+                result.label = state.label;
+                result.counters = state.counters;
+
+                if (!state.samples.empty()) {
+                    std::vector<double>& samples = state.samples;
+                    std::sort(samples.begin(), samples.end());
+
+                    for (auto [name, quantile] : {std::pair<const char*, double>{"p50", 0.5}, {"p90", 0.9}, {"p99", 0.99}, {"p999", 0.999}}) {
+                        size_t index = std::min(samples.size() - 1, static_cast<size_t>(quantile * static_cast<double>(samples.size())));
+                        result.percentiles.emplace_back(name, samples[index]);
+                    }
+                }
+
+                return result;
+            }
+
+            static Result median(const std::vector<Result>& runs) {
+                auto middle = [&runs](auto field) {
+                    std::vector<double> values;
+                    for (const Result& run : runs) {
+                        values.push_back(run.*field);
+                    }
+
+                    std::sort(values.begin(), values.end());
+                    return values[values.size() / 2];
+                };
+
+                Result result = runs[runs.size() / 2];
+                result.aggregate = "median";
+                result.realTime = middle(&Result::realTime);
+                result.cpuTime = middle(&Result::cpuTime);
+                result.itemsPerSecond = middle(&Result::itemsPerSecond);
+                result.bytesPerSecond = middle(&Result::bytesPerSecond);
+
+                return result;
+            }
+
+            static void print(const Result& result) {
+                std::string name = result.aggregate.empty() ? result.name : result.name + "_" + result.aggregate;
+                std::printf("%-48s %12s %12s %12zu", name.c_str(), formatTime(result.realTime).c_str(),
+                            formatTime(result.cpuTime).c_str(), result.iterations);
+
+                if (result.itemsPerSecond > 0) {
+                    std::printf(" items/s=%s", formatRate(result.itemsPerSecond, "").c_str());
+                }
+
+                if (result.bytesPerSecond > 0) {
+                    std::printf(" bytes/s=%s", formatRate(result.bytesPerSecond, "B").c_str());
+                }
+
+                for (const auto& [counter, value] : result.counters) {
+                    std::printf(" %s=%.4g", counter.c_str(), value);
+                }
+
+                for (const auto& [percentile, value] : result.percentiles) {
+                    std::printf(" %s=%s", percentile.c_str(), formatTime(value).c_str());
+                }
+
+                if (!result.label.empty()) {
+                    std::printf(" %s", result.label.c_str());
+                }
+
+                std::printf("\n");
+                std::fflush(stdout);
+            }
+
+            void writeJson(std::ostream& output, const char* program) const {
+                char date[32];
+                std::time_t now = std::time(nullptr);
+                std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S%z", std::localtime(&now));
+
+                char host[256] = {};
+                gethostname(host, sizeof(host) - 1);
+
+#ifdef NDEBUG
+                const char* build = "release";
+#else
+                const char* build = "debug";
+#endif
+
+                output << "{\n  \"context\": {\n"
+                       << "    \"date\": \"" << date << "\",\n"
+                       << "    \"host_name\": \"" << escapeJson(host) << "\",\n"
+                       << "    \"executable\": \"" << escapeJson(program) << "\",\n"
+                       << "    \"num_cpus\": " << std::thread::hardware_concurrency() << ",\n"
+                       << "    \"library_build_type\": \"" << build << "\",\n"
+                       << "    \"seed\": " << DEFAULT_SEED << ",\n"
+                       << "    \"min_time\": " << formatNumber(options.minTime) << "\n"
+                       << "  },\n  \"benchmarks\": [";
+
+                for (size_t i = 0; i < results.size(); i++) {
+                    const Result& result = results[i];
+
+                    output << (i == 0 ? "\n" : ",\n") << "    {\n"
+                           << "      \"name\": \"" << escapeJson(result.aggregate.empty() ? result.name : result.name + "_" + result.aggregate) << "\",\n"
+                           << "      \"run_name\": \"" << escapeJson(result.name) << "\",\n"
+                           << "      \"run_type\": \"" << (result.aggregate.empty() ? "iteration" : "aggregate") << "\",\n";
+
+                    if (!result.aggregate.empty()) {
+                        output << "      \"aggregate_name\": \"" << result.aggregate << "\",\n";
+                    }
+
+                    output << "      \"iterations\": " << result.iterations << ",\n"
+                           << "      \"real_time\": " << formatNumber(result.realTime) << ",\n"
+                           << "      \"cpu_time\": " << formatNumber(result.cpuTime) << ",\n"
+                           << "      \"time_unit\": \"ns\"";
+
+                    if (result.itemsPerSecond > 0) {
+                        output << ",\n      \"items_per_second\": " << formatNumber(result.itemsPerSecond);
+                    }
+
+                    if (result.bytesPerSecond > 0) {
+                        output << ",\n      \"bytes_per_second\": " << formatNumber(result.bytesPerSecond);
+                    }
+
+                    for (const auto& [counter, value] : result.counters) {
+                        output << ",\n      \"" << escapeJson(counter) << "\": " << formatNumber(value);
+                    }
+
+                    for (const auto& [percentile, value] : result.percentiles) {
+                        output << ",\n      \"" << percentile << "\": " << formatNumber(value);
+                    }
+
+                    if (!result.label.empty()) {
+                        output << ",\n      \"label\": \"" << escapeJson(result.label) << "\"";
+                    }
+
+                    output << "\n    }";
+                }
+
+                output << "\n  ]\n}\n";
+            }
+
+        public:
+            explicit Runner(const Options& options) : options(options) {}
+
+            int run(const char* program) {
+                std::regex filter(options.filter.empty() ? ".*" : options.filter);
+                bool failed = false;
+
+                if (!options.list) {
+                    std::printf("%-48s %12s %12s %12s\n", "Benchmark", "Time", "CPU", "Iterations");
+                    std::printf("%s\n", std::string(87, '-').c_str());
+                }
+
+                for (const auto& benchmark : registry()) {
+                    std::vector<std::vector<int64_t>> instances = benchmark->instances;
+                    if (instances.empty()) {
+                        instances.emplace_back();
+                    }
+
+                    for (const auto& arguments : instances) {
+                        std::string name = instanceName(*benchmark, arguments);
+                        if (!std::regex_search(name, filter)) {
+                            continue;
+                        }
+
+                        if (options.list) {
+                            std::printf("%s\n", name.c_str());
+                            continue;
+                        }
+
+                        try {
+                            std::vector<Result> runs;
+
+                            for (size_t repetition = 0; repetition < options.repetitions; repetition++) {
+                                runs.push_back(measure(*benchmark, arguments));
+                                runs.back().name = name;
+                                print(runs.back());
+                            }
+
+                            results.insert(results.end(), runs.begin(), runs.end());
+
+                            if (runs.size() > 1) {
+                                results.push_back(median(runs));
+                                print(results.back());
+                            }
+                        } catch (const std::exception& error) {
+                            std::fprintf(stderr, "%s failed: %s\n", name.c_str(), error.what());
+                            failed = true;
+                        }
+                    }
+                }
+
+                if (!options.jsonPath.empty() && !options.list) {
+                    if (options.jsonPath == "-") {
+                        writeJson(std::cout, program);
+                    } else {
+                        std::ofstream file(options.jsonPath);
+                        if (!file) {
+                            throw std::runtime_error("Failed to open file: " + options.jsonPath);
+                        }
+
+                        writeJson(file, program);
+                    }
+                }
+
+                return failed ? 1 : 0;
+            }
+    };
+
+    State::State(size_t iterations, std::vector<int64_t> arguments)
+        : iterations(iterations), remaining(iterations), arguments(std::move(arguments)) {}
+
+    void State::startTimer() {
+        running = true;
+        cpuStarted = cpuSeconds();
+        started = Clock::now();
+    }
+
+    void State::stopTimer() {
+        elapsed += Clock::now() - started;
+        cpuElapsed += cpuSeconds() - cpuStarted;
+        running = false;
+    }
+
+    void State::pauseTiming() {
+        if (running) {
+            stopTimer();
+        }
+    }
+
+    void State::resumeTiming() {
+        if (!running) {
+            startTimer();
+        }
+    }
+
+    void State::setCounter(const std::string& name, double value) {
+        for (auto& counter : counters) {
+            if (counter.first == name) {
+                counter.second = value;
+                return;
+            }
+        }
+
+        counters.emplace_back(name, value);
+    }
+
+    Benchmark::Benchmark(std::string name, std::function<void(State&)> function)
+        : name(std::move(name)), function(std::move(function)) {}
+
+    Benchmark* Benchmark::arg(int64_t value) {
+        instances.push_back({value});
+        return this;
+    }
+
+    Benchmark* Benchmark::args(std::vector<int64_t> values) {
+        instances.push_back(std::move(values));
+        return this;
+    }
+
+    Benchmark* Benchmark::range(int64_t from, int64_t to, int64_t multiplier) {
+        if (from <= 0 || to < from || multiplier < 2) {
+            throw std::invalid_argument("range needs 0 < from <= to and multiplier >= 2");
+        }
+
+        for (int64_t value = from; value < to; value *= multiplier) {
+            instances.push_back({value});
+        }
+
+        instances.push_back({to});
+        return this;
+    }
+
+    Benchmark* Benchmark::ranges(const std::vector<std::vector<int64_t>>& lists) {
+        std::vector<std::vector<int64_t>> combinations = {{}};
+
+        for (const auto& list : lists) {
+            std::vector<std::vector<int64_t>> next;
+
+            for (const auto& prefix : combinations) {
+                for (int64_t value : list) {
+                    next.push_back(prefix);
+                    next.back().push_back(value);
+                }
+            }
+
+            combinations = std::move(next);
+        }
+
+        instances.insert(instances.end(), combinations.begin(), combinations.end());
+        return this;
+    }
+
+    Benchmark* Benchmark::iterations(size_t count) {
+        fixedIterations = count;
+        return this;
+    }
+
+    Benchmark* registerBenchmark(const std::string& name, std::function<void(State&)> function) {
+        registry().push_back(std::make_unique<Benchmark>(name, std::move(function)));
+        return registry().back().get();
+    }
+
+    int run(int argc, char** argv) {
+        Options options;
+
+        if (!parseOptions(argc, argv, options)) {
+            printUsage(argv[0]);
+            return 1;
+        }
+
+        try {
+            return Runner(options).run(argv[0]);
+        } catch (const std::exception& error) {
+            std::cerr << error.what() << std::endl;
+            return 1;
+        }
+    }
+
+    std::vector<uint64_t> randomIntegers(size_t count, uint64_t limit, uint64_t seed) {
+        std::mt19937_64 generator(seed);
+        std::vector<uint64_t> values(count);
+
+        for (uint64_t& value : values) {
+            value = limit == std::numeric_limits<uint64_t>::max() ? generator() : below(generator, limit);
+        }
+
+        return values;
+    }
+
+    std::vector<double> randomDoubles(size_t count, double lower, double upper, uint64_t seed) {
+        std::mt19937_64 generator(seed);
+        std::vector<double> values(count);
+
+        for (double& value : values) {
+            value = lower + (upper - lower) * unit(generator);
+        }
+
+        return values;
+    }
+
+    std::vector<std::string> randomStrings(size_t count, size_t length, uint64_t seed) {
+        std::mt19937_64 generator(seed);
+        std::vector<std::string> values(count, std::string(length, ' '));
+
+        for (std::string& value : values) {
+            for (char& character : value) {
+                character = static_cast<char>('a' + below(generator, 26));
+            }
+        }
+
+        return values;
+    }
+
+    std::string randomText(size_t bytes, uint64_t seed) {
+        std::mt19937_64 generator(seed);
+        std::string text;
+        text.reserve(bytes + 16);
+
+        while (text.size() < bytes) {
+            if (below(generator, 8) == 0) {
+                text += '\n';
+                continue;
+            }
+
+            size_t words = 1 + below(generator, 12);
+            for (size_t word = 0; word < words; word++) {
+                size_t length = 1 + below(generator, 10);
+
+                for (size_t i = 0; i < length; i++) {
+                    text += static_cast<char>('a' + below(generator, 26));
+                }
+
+                text += word + 1 < words ? ' ' : '\n';
+            }
+        }
+
+        return text;
+    }
+
+    std::vector<uint64_t> zipfIntegers(size_t count, uint64_t limit, double exponent, uint64_t seed) {
+        std::vector<double> cumulative(limit);
+        double total = 0;
+
+        for (uint64_t rank = 0; rank < limit; rank++) {
+            total += 1.0 / std::pow(static_cast<double>(rank + 1), exponent);
+            cumulative[rank] = total;
+        }
+
+        std::mt19937_64 generator(seed);
+        std::vector<uint64_t> values(count);
+
+        for (uint64_t& value : values) {
+            double target = unit(generator) * total;
+            value = std::min<uint64_t>(limit - 1, std::lower_bound(cumulative.begin(), cumulative.end(), target) - cumulative.begin());
+        }
+
+        return values;
+    }
+
+    std::string temporaryPath(const std::string& name) {
+        return (std::filesystem::temp_directory_path() / ("zen-benchmark-" + std::to_string(getpid()) + "-" + name)).string();
+    }
+}
+
+int main(int argc, char** argv) {
+    return zen::benchmark::run(argc, argv);
+}
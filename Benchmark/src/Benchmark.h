@@ -0,0 +1,309 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * @namespace zen::benchmark
+ * @brief A small, self-contained microbenchmark harness for zen-libs
+ *
+ * Modeled on Google Benchmark: a benchmark is a function taking a State,
+ * registered with ZEN_BENCHMARK and run for as many iterations as needed
+ * to measure it reliably. Each module has its own benchmark program, built
+ * from Benchmark.cpp, the module's benchmark files and the module's .cpp
+ * files (Terminal also needs TextFile.cpp, which its logger writes through):
+ *
+ * @code
+ * g++ -std=c++20 -O2 -DNDEBUG -o system-benchmark Benchmark/src/Benchmark.cpp
+ *     Benchmark/src/SystemBenchmark.cpp System/src/System.cpp
+ *
+ * ./system-benchmark --filter=Memory --json=system.json
+ * @endcode
+ *
+ * The CoreX program is built from CoreXBenchmark.cpp,
+ * CoreXContainerBenchmark.cpp and CoreXConcurrencyBenchmark.cpp together.
+ *
+ * Command line options:
+ * - --filter=REGEX      Run only benchmarks whose name matches
+ * - --min-time=SECONDS  Minimum measured time per benchmark (default 0.5)
+ * - --repetitions=N     Run every benchmark N times and add median rows
+ * - --json=PATH         Also write the results as JSON ("-" for stdout)
+ * - --list              Print the benchmark names and exit
+ *
+ * All input data comes from the generators below with fixed seeds, so two
+ * runs of the same build measure exactly the same work.
+ */
+namespace zen::benchmark {
+    /** @brief Seed used by the data generators unless another one is given */
+    constexpr uint64_t DEFAULT_SEED = 42;
+
+    /**
+     * @brief Per-run state handed to a benchmark function
+     *
+     * The function prepares its input, then repeats the measured operation
+     * while keepRunning() returns true. Only the time between the first and
+     * the last call of keepRunning() is measured.
+     *
+     * Example usage:
+     * @code
+     * void arraySum(zen::benchmark::State& state) {
+     *     zen::corex::Array<double> values(zen::benchmark::randomDoubles(state.range()));
+     *
+     *     while (state.keepRunning()) {
+     *         zen::benchmark::doNotOptimize(values.sum());
+     *     }
+     *
+     *     state.setItemsProcessed(state.getIterations() * state.range());
+     * }
+     * ZEN_BENCHMARK(arraySum)->range(1 << 10, 1 << 20);
+     * @endcode
+     */
+    class State {
+        private:
+            using Clock = std::chrono::steady_clock;
+
+            size_t iterations;
+            size_t remaining;
+            std::vector<int64_t> arguments;
+
+            Clock::time_point started;
+            Clock::duration elapsed{};
+            double cpuStarted = 0;
+            double cpuElapsed = 0;
+            bool running = false;
+
+            int64_t items = 0;
+            int64_t bytes = 0;
+            std::string label;
+            std::vector<std::pair<std::string, double>> counters;
+            std::vector<double> samples;
+
+            void startTimer();
+
+            void stopTimer();
+
+            friend class Runner;
+
+        public:
+            /**
+             * @brief Creates the state of one run
+             *
+             * @param iterations Number of times keepRunning() returns true
+             * @param arguments Arguments of this instance of the benchmark
+             */
+            State(size_t iterations, std::vector<int64_t> arguments);
+
+            /**
+             * @brief Returns true while the measured loop must continue
+             *
+             * Starts the timer on the first call and stops it on the last one.
+             */
+            bool keepRunning() {
+                if (remaining > 0) [[likely]] {
+                    if (remaining-- == iterations) [[unlikely]] {
+                        startTimer();
+                    }
+
+                    return true;
+                }
+
+                if (running) {
+                    stopTimer();
+                }
+
+                return false;
+            }
+
+            /**
+             * @brief Returns an argument of this benchmark instance
+             *
+             * @param index Position of the argument, 0 for the first
+             * @return int64_t The argument, 0 if the instance has fewer arguments
+             */
+            int64_t range(size_t index = 0) const {
+                return index < arguments.size() ? arguments[index] : 0;
+            }
+
+            /**
+             * @brief Returns the number of iterations of this run
+             */
+            size_t getIterations() const {
+                return iterations;
+            }
+
+            /**
+             * @brief Stops the timer, e.g. to rebuild the input inside the loop
+             */
+            void pauseTiming();
+
+            /**
+             * @brief Restarts the timer after pauseTiming()
+             */
+            void resumeTiming();
+
+            /**
+             * @brief Sets the number of processed items, reported as items per second
+             */
+            void setItemsProcessed(int64_t count) {
+                items = count;
+            }
+
+            /**
+             * @brief Sets the number of processed bytes, reported as bytes per second
+             */
+            void setBytesProcessed(int64_t count) {
+                bytes = count;
+            }
+
+            /**
+             * @brief Attaches a short free-form note to the result
+             */
+            void setLabel(const std::string& text) {
+                label = text;
+            }
+
+            /**
+             * @brief Reports a named value, such as a measured error rate or bits per key
+             */
+            void setCounter(const std::string& name, double value);
+
+            /**
+             * @brief Records the latency of one operation in nanoseconds
+             *
+             * Runs with samples also report their p50, p90, p99 and p99.9.
+             */
+            void addSample(double nanoseconds) {
+                samples.push_back(nanoseconds);
+            }
+    };
+
+    /**
+     * @brief Registration handle used to attach arguments to a benchmark
+     *
+     * Every argument set becomes its own instance, named
+     * "function/argument1/argument2".
+     */
+    class Benchmark {
+        private:
+            std::string name;
+            std::function<void(State&)> function;
+            std::vector<std::vector<int64_t>> instances;
+            size_t fixedIterations = 0;
+
+            friend class Runner;
+
+        public:
+            Benchmark(std::string name, std::function<void(State&)> function);
+
+            /**
+             * @brief Adds an instance with one argument
+             */
+            Benchmark* arg(int64_t value);
+
+            /**
+             * @brief Adds an instance with several arguments
+             */
+            Benchmark* args(std::vector<int64_t> values);
+
+            /**
+             * @brief Adds instances for from, from * multiplier, ... up to and including to
+             */
+            Benchmark* range(int64_t from, int64_t to, int64_t multiplier = 8);
+
+            /**
+             * @brief Adds instances for every combination of the given argument lists
+             *
+             * Example usage:
+             * @code
+             * ZEN_BENCHMARK(queuePingPong)->ranges({{1, 2, 4}, {64, 4096}});   // 6 instances
+             * @endcode
+             */
+            Benchmark* ranges(const std::vector<std::vector<int64_t>>& lists);
+
+            /**
+             * @brief Runs a fixed number of iterations instead of calibrating
+             *
+             * For operations so slow (or memory hungry) that a few runs are enough.
+             */
+            Benchmark* iterations(size_t count);
+    };
+
+    /**
+     * @brief Registers a benchmark function under a name
+     *
+     * @return Benchmark* Handle for adding arguments; owned by the registry
+     */
+    Benchmark* registerBenchmark(const std::string& name, std::function<void(State&)> function);
+
+    /**
+     * @brief Runs the registered benchmarks selected by the command line
+     *
+     * @return int Process exit code
+     */
+    int run(int argc, char** argv);
+
+    /**
+     * @brief Prevents the compiler from discarding a value computed in a benchmark
+     */
+    template <typename T>
+    inline void doNotOptimize(const T& value) {
+        asm volatile("" : : "r,m"(value) : "memory");
+    }
+
+    /**
+     * @brief Forces pending memory writes to be treated as observed
+     */
+    inline void clobberMemory() {
+        asm volatile("" : : : "memory");
+    }
+
+    /**
+     * @brief Returns count uniformly distributed integers in [0, limit)
+     */
+    std::vector<uint64_t> randomIntegers(size_t count, uint64_t limit = std::numeric_limits<uint64_t>::max(),
+                                         uint64_t seed = DEFAULT_SEED);
+
+    /**
+     * @brief Returns count uniformly distributed doubles in [lower, upper)
+     */
+    std::vector<double> randomDoubles(size_t count, double lower = 0, double upper = 1, uint64_t seed = DEFAULT_SEED);
+
+    /**
+     * @brief Returns count random lowercase strings of the given length
+     */
+    std::vector<std::string> randomStrings(size_t count, size_t length, uint64_t seed = DEFAULT_SEED);
+
+    /**
+     * @brief Returns text of random words separated by spaces and newlines
+     *
+     * About one line in eight is empty, so every TextFile::count() mode has
+     * something to count.
+     */
+    std::string randomText(size_t bytes, uint64_t seed = DEFAULT_SEED);
+
+    /**
+     * @brief Returns count integers in [0, limit) following a Zipf distribution
+     *
+     * Small values are much more frequent, like keys in a real cache.
+     *
+     * @param exponent Skew; 0 is uniform, around 1 is typical for web traffic
+     */
+    std::vector<uint64_t> zipfIntegers(size_t count, uint64_t limit, double exponent = 1.0, uint64_t seed = DEFAULT_SEED);
+
+    /**
+     * @brief Returns a path in the temporary directory for scratch files
+     */
+    std::string temporaryPath(const std::string& name);
+}
+
+/**
+ * @brief Registers a benchmark function under its own name
+ */
+#define ZEN_BENCHMARK(function) \
+    static ::zen::benchmark::Benchmark* zenBenchmark_##function = ::zen::benchmark::registerBenchmark(#function, function)
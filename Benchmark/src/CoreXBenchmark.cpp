@@ -0,0 +1,497 @@
+#include "Benchmark.h"
+
+#include <cstdio>
+#include <fstream>
+#include <random>
+
+#include "../../CoreX/src/Array.h"
+#include "../../CoreX/src/Random.h"
+#include "../../CoreX/src/Serialization.h"
+#include "../../CoreX/src/String.h"
+
+/*
+ * Benchmarks of Array, String, the numeric reductions, deduplication and
+ * binary serialization. Every benchmark also has the baseline it was
+ * written to beat: add() in a loop, a contains() scan, text streams.
+ */
+
+namespace {
+    using zen::benchmark::State;
+    using zen::benchmark::doNotOptimize;
+    using zen::corex::Array;
+    using zen::corex::String;
+    using zen::corex::Summation;
+
+    Array<int32_t> randomInt32(size_t count, uint64_t limit = 1u << 30) {
+        return Array<int32_t>(zen::benchmark::randomIntegers(count, limit));
+    }
+
+    Array<double> randomDouble(size_t count) {
+        return Array<double>(zen::benchmark::randomDoubles(count, -1000, 1000));
+    }
+
+    /* Building arrays */
+
+    /* The baseline: every add() reallocates and copies the whole array */
+    void arrayAddLoop(State& state) {
+        std::vector<int32_t> values(state.range(), 7);
+
+        while (state.keepRunning()) {
+            Array<int32_t> array;
+
+            for (int32_t value : values) {
+                array.add(value);
+            }
+
+            doNotOptimize(array.getSize());
+        }
+
+        state.setItemsProcessed(state.getIterations() * values.size());
+    }
+
+    void arrayInsertRange(State& state) {
+        std::vector<int32_t> values(state.range(), 7);
+
+        while (state.keepRunning()) {
+            Array<int32_t> array;
+            array.insert(0, values.begin(), values.end());
+            doNotOptimize(array.getSize());
+        }
+
+        state.setItemsProcessed(state.getIterations() * values.size());
+    }
+
+    void arrayAssign(State& state) {
+        std::vector<int32_t> values(state.range(), 7);
+        Array<int32_t> array;
+
+        while (state.keepRunning()) {
+            array.assign(values.begin(), values.end());
+            doNotOptimize(array.getSize());
+        }
+
+        state.setItemsProcessed(state.getIterations() * values.size());
+    }
+
+    void arrayResize(State& state) {
+        size_t size = state.range();
+
+        while (state.keepRunning()) {
+            Array<int32_t> array;
+            array.resize(size, 7);
+            doNotOptimize(array.getSize());
+        }
+
+        state.setItemsProcessed(state.getIterations() * size);
+    }
+
+    /* Fill with a 4-byte and a 12-byte pattern, the AVX2 and the memcpy path */
+    void arrayFill(State& state) {
+        size_t size = state.range();
+
+        if (state.range(1) == 4) {
+            Array<int32_t> array;
+            array.resize(size);
+
+            while (state.keepRunning()) {
+                array.fill(7);
+                zen::benchmark::clobberMemory();
+            }
+        } else {
+            struct Triple {
+                int32_t a, b, c;
+            };
+
+            Array<Triple> array;
+            array.resize(size);
+
+            while (state.keepRunning()) {
+                array.fill(Triple{1, 2, 3});
+                zen::benchmark::clobberMemory();
+            }
+        }
+
+        state.setBytesProcessed(state.getIterations() * size * state.range(1));
+    }
+
+    /* Reordering */
+
+    void arrayReverse(State& state) {
+        Array<int32_t> array = randomInt32(state.range());
+
+        while (state.keepRunning()) {
+            array.reverse();
+            zen::benchmark::clobberMemory();
+        }
+
+        state.setBytesProcessed(state.getIterations() * array.getSize() * sizeof(int32_t));
+    }
+
+    void arrayRotate(State& state) {
+        Array<int32_t> array = randomInt32(state.range());
+        size_t k = array.getSize() / 3;
+
+        while (state.keepRunning()) {
+            array.rotate(k);
+            zen::benchmark::clobberMemory();
+        }
+
+        state.setBytesProcessed(state.getIterations() * array.getSize() * sizeof(int32_t));
+    }
+
+    /* Second argument: 0 shuffles with FastRandom, 1 with std::mt19937_64 */
+    void arrayShuffle(State& state) {
+        Array<int32_t> array = randomInt32(state.range());
+        zen::corex::FastRandom fast(zen::benchmark::DEFAULT_SEED);
+        std::mt19937_64 twister(zen::benchmark::DEFAULT_SEED);
+
+        while (state.keepRunning()) {
+            if (state.range(1) == 0) {
+                array.shuffle(fast);
+            } else {
+                array.shuffle(twister);
+            }
+
+            zen::benchmark::clobberMemory();
+        }
+
+        state.setItemsProcessed(state.getIterations() * array.getSize());
+    }
+
+    /* Comparison */
+
+    /* Two equal arrays, the worst case: every element is compared */
+    void arrayEquals(State& state) {
+        Array<int32_t> first = randomInt32(state.range());
+        Array<int32_t> second;
+        second = first;
+
+        while (state.keepRunning()) {
+            doNotOptimize(first == second);
+        }
+
+        state.setBytesProcessed(state.getIterations() * first.getSize() * sizeof(int32_t));
+    }
+
+    /* Arrays differing in their last element; uint8_t takes the memcmp path */
+    void arrayCompare(State& state) {
+        Array<uint8_t> first(zen::benchmark::randomIntegers(state.range(), 256));
+        Array<uint8_t> second;
+        second = first;
+        second[second.getSize() - 1]++;
+
+        while (state.keepRunning()) {
+            doNotOptimize(first <=> second);
+        }
+
+        state.setBytesProcessed(state.getIterations() * first.getSize());
+    }
+
+    void stringAppend(State& state) {
+        String piece("lorem ipsum ");
+        size_t count = state.range();
+
+        while (state.keepRunning()) {
+            String text;
+
+            for (size_t i = 0; i < count; i++) {
+                text.append(piece);
+            }
+
+            doNotOptimize(text.getSize());
+        }
+
+        state.setItemsProcessed(state.getIterations() * count);
+    }
+
+    /* Strings sharing all but their last byte */
+    void stringCompare(State& state) {
+        std::string text = zen::benchmark::randomText(state.range());
+        String first(text);
+        text.back() = text.back() == 'x' ? 'y' : 'x';
+        String second(text);
+
+        while (state.keepRunning()) {
+            doNotOptimize(first == second);
+            doNotOptimize(first <=> second);
+        }
+
+        state.setBytesProcessed(state.getIterations() * 2 * text.size());
+    }
+
+    void stringReplace(State& state) {
+        std::string text = zen::benchmark::randomText(state.range());
+
+        while (state.keepRunning()) {
+            state.pauseTiming();
+            String copy(text);
+            state.resumeTiming();
+
+            copy.replace(" ", "__");
+            doNotOptimize(copy.getSize());
+        }
+
+        state.setBytesProcessed(state.getIterations() * text.size());
+    }
+
+    /* Numeric reductions */
+
+    /* Second argument: the Summation method */
+    void arraySumDouble(State& state) {
+        Array<double> array = randomDouble(state.range());
+        auto method = static_cast<Summation>(state.range(1));
+
+        while (state.keepRunning()) {
+            doNotOptimize(array.sum(method));
+        }
+
+        state.setItemsProcessed(state.getIterations() * array.getSize());
+    }
+
+    /* The reference the kernels are measured against: a plain loop */
+    void arraySumLoop(State& state) {
+        Array<double> array = randomDouble(state.range());
+
+        while (state.keepRunning()) {
+            double total = 0;
+
+            for (size_t i = 0; i < array.getSize(); i++) {
+                total += array[i];
+            }
+
+            doNotOptimize(total);
+        }
+
+        state.setItemsProcessed(state.getIterations() * array.getSize());
+    }
+
+    void arraySumInt32(State& state) {
+        Array<int32_t> array = randomInt32(state.range());
+
+        while (state.keepRunning()) {
+            doNotOptimize(array.sum());
+        }
+
+        state.setItemsProcessed(state.getIterations() * array.getSize());
+    }
+
+    void arrayMinmax(State& state) {
+        Array<double> array = randomDouble(state.range());
+
+        while (state.keepRunning()) {
+            doNotOptimize(array.minmax());
+        }
+
+        state.setItemsProcessed(state.getIterations() * array.getSize());
+    }
+
+    void arrayVariance(State& state) {
+        Array<double> array = randomDouble(state.range());
+
+        while (state.keepRunning()) {
+            doNotOptimize(array.variance());
+        }
+
+        state.setItemsProcessed(state.getIterations() * array.getSize());
+    }
+
+    void arrayHistogram(State& state) {
+        Array<double> array = randomDouble(state.range());
+
+        while (state.keepRunning()) {
+            doNotOptimize(array.histogram(64, -1000, 1000));
+        }
+
+        state.setItemsProcessed(state.getIterations() * array.getSize());
+    }
+
+    /* Deduplication, about 10% distinct values */
+
+    /* The baseline distinct() replaced: a contains() scan per element */
+    void arrayDistinctNaive(State& state) {
+        Array<int32_t> array = randomInt32(state.range(), state.range() / 10 + 1);
+
+        while (state.keepRunning()) {
+            Array<int32_t> result;
+
+            for (size_t i = 0; i < array.getSize(); i++) {
+                if (!result.contains(array[i])) {
+                    result.add(array[i]);
+                }
+            }
+
+            doNotOptimize(result.getSize());
+        }
+
+        state.setItemsProcessed(state.getIterations() * array.getSize());
+    }
+
+    void arrayDistinct(State& state) {
+        Array<int32_t> array = randomInt32(state.range(), state.range() / 10 + 1);
+
+        while (state.keepRunning()) {
+            doNotOptimize(array.distinct().getSize());
+        }
+
+        state.setItemsProcessed(state.getIterations() * array.getSize());
+    }
+
+    void arrayDistinctSorted(State& state) {
+        Array<int32_t> array = randomInt32(state.range(), state.range() / 10 + 1);
+
+        while (state.keepRunning()) {
+            doNotOptimize(array.distinctSorted().getSize());
+        }
+
+        state.setItemsProcessed(state.getIterations() * array.getSize());
+    }
+
+    void arrayUnique(State& state) {
+        Array<int32_t> array = randomInt32(state.range(), state.range() / 10 + 1).distinctSorted();
+        Array<int32_t> runs;
+        runs.resize(array.getSize() * 10);
+
+        for (size_t i = 0; i < runs.getSize(); i++) {
+            runs[i] = array[i / 10];
+        }
+
+        while (state.keepRunning()) {
+            doNotOptimize(runs.unique().getSize());
+        }
+
+        state.setItemsProcessed(state.getIterations() * runs.getSize());
+    }
+
+    /* Serialization */
+
+    /* A scratch path that is deleted when the benchmark returns */
+    struct ScratchPath {
+        std::string path = zen::benchmark::temporaryPath("array.bin");
+
+        ~ScratchPath() {
+            std::remove(path.c_str());
+        }
+    };
+
+    void arraySave(State& state) {
+        ScratchPath scratch;
+        Array<double> array = randomDouble(state.range());
+
+        while (state.keepRunning()) {
+            array.save(scratch.path);
+        }
+
+        state.setBytesProcessed(state.getIterations() * array.getSize() * sizeof(double));
+    }
+
+    void arrayLoad(State& state) {
+        ScratchPath scratch;
+        Array<double> array = randomDouble(state.range());
+        array.save(scratch.path);
+
+        while (state.keepRunning()) {
+            doNotOptimize(Array<double>::load(scratch.path).getSize());
+        }
+
+        state.setBytesProcessed(state.getIterations() * array.getSize() * sizeof(double));
+    }
+
+    /* Mapping without the checksum pass, then reading every element */
+    void mappedArraySum(State& state) {
+        ScratchPath scratch;
+        Array<double> array = randomDouble(state.range());
+        array.save(scratch.path);
+
+        while (state.keepRunning()) {
+            zen::corex::MappedArray<double> mapped(scratch.path, false);
+            double total = 0;
+
+            for (double value : mapped) {
+                total += value;
+            }
+
+            doNotOptimize(total);
+        }
+
+        state.setBytesProcessed(state.getIterations() * array.getSize() * sizeof(double));
+    }
+
+    /* The baseline save() replaced: one formatted value per line */
+    void textStreamSave(State& state) {
+        ScratchPath scratch;
+        Array<double> array = randomDouble(state.range());
+
+        while (state.keepRunning()) {
+            std::ofstream output(scratch.path);
+
+            for (size_t i = 0; i < array.getSize(); i++) {
+                output << array[i] << '\n';
+            }
+        }
+
+        state.setBytesProcessed(state.getIterations() * array.getSize() * sizeof(double));
+    }
+
+    void textStreamLoad(State& state) {
+        ScratchPath scratch;
+        Array<double> array = randomDouble(state.range());
+
+        {
+            std::ofstream output(scratch.path);
+
+            for (size_t i = 0; i < array.getSize(); i++) {
+                output << array[i] << '\n';
+            }
+        }
+
+        while (state.keepRunning()) {
+            std::ifstream input(scratch.path);
+            std::vector<double> values;
+            double value;
+
+            while (input >> value) {
+                values.push_back(value);
+            }
+
+            doNotOptimize(values.size());
+        }
+
+        state.setBytesProcessed(state.getIterations() * array.getSize() * sizeof(double));
+    }
+}
+
+ZEN_BENCHMARK(arrayAddLoop)->range(1 << 6, 1 << 12);
+ZEN_BENCHMARK(arrayInsertRange)->range(1 << 6, 1 << 18);
+ZEN_BENCHMARK(arrayAssign)->range(1 << 6, 1 << 18);
+ZEN_BENCHMARK(arrayResize)->range(1 << 6, 1 << 18);
+ZEN_BENCHMARK(arrayFill)->ranges({{1 << 10, 1 << 20}, {4, 12}});
+
+ZEN_BENCHMARK(arrayReverse)->range(1 << 10, 1 << 20);
+ZEN_BENCHMARK(arrayRotate)->range(1 << 10, 1 << 20);
+ZEN_BENCHMARK(arrayShuffle)->ranges({{1 << 10, 1 << 20}, {0, 1}});
+
+ZEN_BENCHMARK(arrayEquals)->range(1 << 10, 1 << 20);
+ZEN_BENCHMARK(arrayCompare)->range(1 << 10, 1 << 20);
+ZEN_BENCHMARK(stringAppend)->range(1 << 4, 1 << 12);
+ZEN_BENCHMARK(stringCompare)->range(1 << 6, 1 << 16);
+ZEN_BENCHMARK(stringReplace)->range(1 << 10, 1 << 16);
+
+ZEN_BENCHMARK(arraySumDouble)->ranges({{1 << 10, 1 << 20}, {static_cast<int64_t>(Summation::Fast),
+                                                           static_cast<int64_t>(Summation::Pairwise),
+                                                           static_cast<int64_t>(Summation::Kahan)}});
+ZEN_BENCHMARK(arraySumLoop)->range(1 << 10, 1 << 20);
+ZEN_BENCHMARK(arraySumInt32)->range(1 << 10, 1 << 20);
+ZEN_BENCHMARK(arrayMinmax)->range(1 << 10, 1 << 20);
+ZEN_BENCHMARK(arrayVariance)->range(1 << 10, 1 << 20);
+ZEN_BENCHMARK(arrayHistogram)->range(1 << 10, 1 << 20);
+
+ZEN_BENCHMARK(arrayDistinctNaive)->range(1 << 8, 1 << 14);
+ZEN_BENCHMARK(arrayDistinct)->range(1 << 8, 1 << 20);
+ZEN_BENCHMARK(arrayDistinctSorted)->range(1 << 8, 1 << 20);
+ZEN_BENCHMARK(arrayUnique)->range(1 << 8, 1 << 20);
+
+ZEN_BENCHMARK(arraySave)->range(1 << 10, 1 << 22);
+ZEN_BENCHMARK(arrayLoad)->range(1 << 10, 1 << 22);
+ZEN_BENCHMARK(mappedArraySum)->range(1 << 10, 1 << 22);
+ZEN_BENCHMARK(textStreamSave)->range(1 << 10, 1 << 20);
+ZEN_BENCHMARK(textStreamLoad)->range(1 << 10, 1 << 20);
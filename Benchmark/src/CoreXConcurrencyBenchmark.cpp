@@ -0,0 +1,366 @@
+#include "Benchmark.h"
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "../../CoreX/src/Array.h"
+#include "../../CoreX/src/BlockingQueue.h"
+#include "../../CoreX/src/ConcurrentArray.h"
+#include "../../CoreX/src/Execution.h"
+#include "../../CoreX/src/MpmcQueue.h"
+#include "../../CoreX/src/SpscQueue.h"
+#include "../../CoreX/src/ThreadPool.h"
+
+/*
+ * Benchmarks of the thread pool, the queues, ConcurrentArray and the
+ * parallel Array algorithms. Most take a thread count as their last
+ * argument; 0 means the Sequential policy, the baseline for the scaling
+ * curve. Results are only meaningful up to the number of cores.
+ */
+
+namespace {
+    using zen::benchmark::State;
+    using zen::benchmark::doNotOptimize;
+    using zen::corex::Array;
+    using zen::corex::Parallel;
+    using zen::corex::Sequential;
+    using zen::corex::ThreadPool;
+
+    /* Elements moved through a queue per iteration */
+    constexpr size_t QUEUE_ITEMS = 1 << 16;
+
+    /* Calls function with Sequential, or with Parallel over a pool of state.range(index) threads */
+    template <typename F>
+    void withPolicy(State& state, size_t index, F&& function) {
+        if (state.range(index) == 0) {
+            function(Sequential());
+            return;
+        }
+
+        ThreadPool pool(state.range(index));
+        function(Parallel(pool));
+    }
+
+    /* Thread pool */
+
+    /* Round trip of one task: submit, then wait for its result */
+    void threadPoolSubmit(State& state) {
+        ThreadPool pool(state.range());
+
+        while (state.keepRunning()) {
+            auto future = pool.submit([] {
+                return 42;
+            });
+
+            doNotOptimize(pool.wait(future));
+        }
+
+        state.setItemsProcessed(state.getIterations());
+    }
+
+    /* Throughput of small tasks: a batch of execute() calls, then wait for all of them */
+    void threadPoolExecute(State& state) {
+        ThreadPool pool(state.range());
+        constexpr size_t BATCH = 1024;
+
+        while (state.keepRunning()) {
+            std::atomic<size_t> done{0};
+
+            for (size_t i = 0; i < BATCH; i++) {
+                pool.execute([&done] {
+                    done.fetch_add(1, std::memory_order_relaxed);
+                });
+            }
+
+            pool.helpWhile([&done] {
+                return done.load(std::memory_order_relaxed) < BATCH;
+            });
+        }
+
+        state.setItemsProcessed(state.getIterations() * BATCH);
+    }
+
+    /* First argument: elements; second: threads */
+    void threadPoolParallelFor(State& state) {
+        ThreadPool pool(state.range(1));
+        std::vector<double> values(state.range());
+
+        while (state.keepRunning()) {
+            pool.parallelFor(0, values.size(), [&values](size_t i) {
+                values[i] = static_cast<double>(i) * 0.5;
+            });
+        }
+
+        state.setItemsProcessed(state.getIterations() * values.size());
+    }
+
+    /* Queues */
+
+    /* One producer thread, the benchmark thread consumes; second argument: batch size */
+    void spscQueueTransfer(State& state) {
+        zen::corex::SpscQueue<uint64_t> queue(state.range());
+        size_t batch = state.range(1);
+
+        while (state.keepRunning()) {
+            std::thread producer([&queue, batch] {
+                std::vector<uint64_t> items(batch, 1);
+
+                for (size_t sent = 0; sent < QUEUE_ITEMS;) {
+                    size_t pushed = queue.tryPushBatch(items.data(), std::min(batch, QUEUE_ITEMS - sent));
+                    sent += pushed;
+
+                    if (pushed == 0) {
+                        std::this_thread::yield();
+                    }
+                }
+            });
+
+            std::vector<uint64_t> items(batch);
+            for (size_t received = 0; received < QUEUE_ITEMS;) {
+                size_t popped = queue.tryPopBatch(items.data(), batch);
+                received += popped;
+
+                if (popped == 0) {
+                    std::this_thread::yield();
+                }
+            }
+
+            producer.join();
+        }
+
+        state.setItemsProcessed(state.getIterations() * QUEUE_ITEMS);
+    }
+
+    /* Arguments: producers, consumers */
+    void mpmcQueueTransfer(State& state) {
+        zen::corex::MpmcQueue<uint64_t> queue(1024);
+        size_t producers = state.range(0);
+        size_t consumers = state.range(1);
+
+        while (state.keepRunning()) {
+            std::atomic<size_t> remaining{QUEUE_ITEMS};
+            std::vector<std::thread> threads;
+
+            for (size_t p = 0; p < producers; p++) {
+                threads.emplace_back([&queue, p, producers] {
+                    size_t share = QUEUE_ITEMS / producers + (p < QUEUE_ITEMS % producers);
+
+                    for (size_t sent = 0; sent < share;) {
+                        if (queue.tryPush(sent)) {
+                            sent++;
+                        } else {
+                            std::this_thread::yield();
+                        }
+                    }
+                });
+            }
+
+            for (size_t c = 0; c < consumers; c++) {
+                threads.emplace_back([&queue, &remaining] {
+                    uint64_t item;
+
+                    while (remaining.load(std::memory_order_relaxed) > 0) {
+                        if (queue.tryPop(item)) {
+                            remaining.fetch_sub(1, std::memory_order_relaxed);
+                        } else {
+                            std::this_thread::yield();
+                        }
+                    }
+                });
+            }
+
+            for (std::thread& thread : threads) {
+                thread.join();
+            }
+        }
+
+        state.setItemsProcessed(state.getIterations() * QUEUE_ITEMS);
+    }
+
+    /* Arguments: producers, consumers; waiting threads sleep instead of spinning */
+    void blockingQueueTransfer(State& state) {
+        size_t producers = state.range(0);
+        size_t consumers = state.range(1);
+
+        while (state.keepRunning()) {
+            zen::corex::BlockingQueue<uint64_t> queue(1024);
+            std::atomic<size_t> finished{0};
+            std::vector<std::thread> threads;
+
+            for (size_t p = 0; p < producers; p++) {
+                threads.emplace_back([&queue, &finished, p, producers] {
+                    size_t share = QUEUE_ITEMS / producers + (p < QUEUE_ITEMS % producers);
+
+                    for (size_t sent = 0; sent < share; sent++) {
+                        queue.push(sent);
+                    }
+
+                    if (finished.fetch_add(1) + 1 == producers) {
+                        queue.close();
+                    }
+                });
+            }
+
+            for (size_t c = 0; c < consumers; c++) {
+                threads.emplace_back([&queue] {
+                    uint64_t item;
+
+                    while (queue.pop(item)) {
+                        doNotOptimize(item);
+                    }
+                });
+            }
+
+            for (std::thread& thread : threads) {
+                thread.join();
+            }
+        }
+
+        state.setItemsProcessed(state.getIterations() * QUEUE_ITEMS);
+    }
+
+    /* Concurrent appends: first argument elements, second threads */
+
+    void concurrentArrayAdd(State& state) {
+        ThreadPool pool(state.range(1));
+        size_t count = state.range();
+
+        while (state.keepRunning()) {
+            zen::corex::ConcurrentArray<uint64_t> array;
+
+            pool.parallelFor(0, count, [&array](size_t i) {
+                array.add(i);
+            });
+
+            doNotOptimize(array.getSize());
+        }
+
+        state.setItemsProcessed(state.getIterations() * count);
+    }
+
+    /* The baseline ConcurrentArray replaces: a vector behind a mutex */
+    void mutexVectorAdd(State& state) {
+        ThreadPool pool(state.range(1));
+        size_t count = state.range();
+
+        while (state.keepRunning()) {
+            std::mutex mutex;
+            std::vector<uint64_t> vector;
+
+            pool.parallelFor(0, count, [&mutex, &vector](size_t i) {
+                std::lock_guard<std::mutex> lock(mutex);
+                vector.push_back(i);
+            });
+
+            doNotOptimize(vector.size());
+        }
+
+        state.setItemsProcessed(state.getIterations() * count);
+    }
+
+    /*
+     * Parallel Array algorithms: first argument elements, second threads.
+     * The input has about one distinct value per ten elements.
+     */
+
+    Array<int32_t> parallelInput(size_t count) {
+        return Array<int32_t>(zen::benchmark::randomIntegers(count, count / 10 + 1));
+    }
+
+    void parallelMap(State& state) {
+        Array<int32_t> array = parallelInput(state.range());
+
+        withPolicy(state, 1, [&](const auto& policy) {
+            while (state.keepRunning()) {
+                doNotOptimize(array.map(policy, [](int32_t value) {
+                    return static_cast<int64_t>(value) * 3 + 1;
+                }).getSize());
+            }
+        });
+
+        state.setItemsProcessed(state.getIterations() * array.getSize());
+    }
+
+    void parallelFilter(State& state) {
+        Array<int32_t> array = parallelInput(state.range());
+
+        withPolicy(state, 1, [&](const auto& policy) {
+            while (state.keepRunning()) {
+                doNotOptimize(array.filter(policy, [](int32_t value) {
+                    return (value & 1) == 0;
+                }).getSize());
+            }
+        });
+
+        state.setItemsProcessed(state.getIterations() * array.getSize());
+    }
+
+    void parallelReduce(State& state) {
+        Array<int32_t> array = parallelInput(state.range());
+
+        withPolicy(state, 1, [&](const auto& policy) {
+            while (state.keepRunning()) {
+                doNotOptimize(array.reduce(policy, 0, [](int32_t first, int32_t second) {
+                    return first ^ second;
+                }));
+            }
+        });
+
+        state.setItemsProcessed(state.getIterations() * array.getSize());
+    }
+
+    void parallelDistinct(State& state) {
+        Array<int32_t> array = parallelInput(state.range());
+
+        withPolicy(state, 1, [&](const auto& policy) {
+            while (state.keepRunning()) {
+                doNotOptimize(array.distinct(policy).getSize());
+            }
+        });
+
+        state.setItemsProcessed(state.getIterations() * array.getSize());
+    }
+
+    void parallelDistinctSorted(State& state) {
+        Array<int32_t> array = parallelInput(state.range());
+
+        withPolicy(state, 1, [&](const auto& policy) {
+            while (state.keepRunning()) {
+                doNotOptimize(array.distinctSorted(policy).getSize());
+            }
+        });
+
+        state.setItemsProcessed(state.getIterations() * array.getSize());
+    }
+
+    /* 100 million elements: a few fixed iterations instead of calibration */
+    constexpr int64_t LARGE = 100000000;
+}
+
+ZEN_BENCHMARK(threadPoolSubmit)->arg(1)->arg(2)->arg(4);
+ZEN_BENCHMARK(threadPoolExecute)->arg(1)->arg(2)->arg(4)->arg(8);
+ZEN_BENCHMARK(threadPoolParallelFor)->ranges({{1 << 20}, {1, 2, 4, 8}});
+
+ZEN_BENCHMARK(spscQueueTransfer)->ranges({{1024}, {1, 64}});
+ZEN_BENCHMARK(mpmcQueueTransfer)->ranges({{1, 2, 4}, {1, 2, 4}});
+ZEN_BENCHMARK(blockingQueueTransfer)->ranges({{1, 2, 4}, {1, 2, 4}});
+
+ZEN_BENCHMARK(concurrentArrayAdd)->ranges({{1 << 20}, {1, 2, 4, 8}});
+ZEN_BENCHMARK(mutexVectorAdd)->ranges({{1 << 20}, {1, 2, 4, 8}});
+
+ZEN_BENCHMARK(parallelMap)->ranges({{1 << 16, 1 << 20, 1 << 24}, {0, 1, 2, 4, 8}});
+ZEN_BENCHMARK(parallelFilter)->ranges({{1 << 16, 1 << 20, 1 << 24}, {0, 1, 2, 4, 8}});
+ZEN_BENCHMARK(parallelReduce)->ranges({{1 << 16, 1 << 20, 1 << 24}, {0, 1, 2, 4, 8}});
+ZEN_BENCHMARK(parallelDistinct)->ranges({{1 << 16, 1 << 20, 1 << 24}, {0, 1, 2, 4, 8}});
+ZEN_BENCHMARK(parallelDistinctSorted)->ranges({{1 << 16, 1 << 20, 1 << 24}, {0, 1, 2, 4, 8}});
+
+static auto* largeMap = zen::benchmark::registerBenchmark("parallelMapLarge", parallelMap)
+    ->ranges({{LARGE}, {0, 1, 2, 4, 8}})->iterations(3);
+static auto* largeFilter = zen::benchmark::registerBenchmark("parallelFilterLarge", parallelFilter)
+    ->ranges({{LARGE}, {0, 1, 2, 4, 8}})->iterations(3);
+static auto* largeReduce = zen::benchmark::registerBenchmark("parallelReduceLarge", parallelReduce)
+    ->ranges({{LARGE}, {0, 1, 2, 4, 8}})->iterations(3);
+static auto* largeDistinct = zen::benchmark::registerBenchmark("parallelDistinctLarge", parallelDistinct)
+    ->ranges({{LARGE}, {0, 1, 2, 4, 8}})->iterations(1);
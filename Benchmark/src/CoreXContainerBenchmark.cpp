@@ -0,0 +1,627 @@
+#include "Benchmark.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <deque>
+#include <map>
+#include <unordered_map>
+
+#include "../../CoreX/src/Arena.h"
+#include "../../CoreX/src/BitArray.h"
+#include "../../CoreX/src/BloomFilter.h"
+#include "../../CoreX/src/CuckooFilter.h"
+#include "../../CoreX/src/DDSketch.h"
+#include "../../CoreX/src/FlatMap.h"
+#include "../../CoreX/src/HashMap.h"
+#include "../../CoreX/src/HyperLogLog.h"
+#include "../../CoreX/src/LruCache.h"
+#include "../../CoreX/src/ObjectPool.h"
+#include "../../CoreX/src/RingArray.h"
+#include "../../CoreX/src/SegmentedArray.h"
+#include "../../CoreX/src/SoaArray.h"
+
+/*
+ * Benchmarks of the CoreX containers against their standard library
+ * counterparts, and of the probabilistic structures. Filters and sketches
+ * also report their measured accuracy as counters, since a fast filter
+ * with a bad false positive rate is no win.
+ */
+
+namespace {
+    using zen::benchmark::State;
+    using zen::benchmark::doNotOptimize;
+
+    /* Keys that were never inserted: the generator with another seed, shifted past the limit */
+    std::vector<uint64_t> absentKeys(size_t count) {
+        std::vector<uint64_t> keys = zen::benchmark::randomIntegers(count, 1ull << 62, zen::benchmark::DEFAULT_SEED + 1);
+
+        for (uint64_t& key : keys) {
+            key |= 1ull << 63;
+        }
+
+        return keys;
+    }
+
+    /* Hash maps: lookups of present keys in random order */
+
+    void hashMapGet(State& state) {
+        std::vector<uint64_t> keys = zen::benchmark::randomIntegers(state.range(), 1ull << 62);
+        zen::corex::HashMap<uint64_t, uint64_t> map;
+
+        for (uint64_t key : keys) {
+            map.put(key, key);
+        }
+
+        size_t i = 0;
+        while (state.keepRunning()) {
+            doNotOptimize(map.find(keys[i]));
+            i = i + 1 == keys.size() ? 0 : i + 1;
+        }
+
+        state.setItemsProcessed(state.getIterations());
+    }
+
+    void unorderedMapGet(State& state) {
+        std::vector<uint64_t> keys = zen::benchmark::randomIntegers(state.range(), 1ull << 62);
+        std::unordered_map<uint64_t, uint64_t> map;
+
+        for (uint64_t key : keys) {
+            map.emplace(key, key);
+        }
+
+        size_t i = 0;
+        while (state.keepRunning()) {
+            doNotOptimize(map.find(keys[i]));
+            i = i + 1 == keys.size() ? 0 : i + 1;
+        }
+
+        state.setItemsProcessed(state.getIterations());
+    }
+
+    void hashMapPut(State& state) {
+        std::vector<uint64_t> keys = zen::benchmark::randomIntegers(state.range(), 1ull << 62);
+
+        while (state.keepRunning()) {
+            zen::corex::HashMap<uint64_t, uint64_t> map;
+
+            for (uint64_t key : keys) {
+                map.put(key, key);
+            }
+
+            doNotOptimize(map.getSize());
+        }
+
+        state.setItemsProcessed(state.getIterations() * keys.size());
+    }
+
+    void unorderedMapPut(State& state) {
+        std::vector<uint64_t> keys = zen::benchmark::randomIntegers(state.range(), 1ull << 62);
+
+        while (state.keepRunning()) {
+            std::unordered_map<uint64_t, uint64_t> map;
+
+            for (uint64_t key : keys) {
+                map.emplace(key, key);
+            }
+
+            doNotOptimize(map.size());
+        }
+
+        state.setItemsProcessed(state.getIterations() * keys.size());
+    }
+
+    /* Ordered maps: second argument 0 is the sorted layout, 1 the Eytzinger layout */
+
+    void flatMapGet(State& state) {
+        std::vector<uint64_t> keys = zen::benchmark::randomIntegers(state.range(), 1ull << 62);
+        std::vector<std::pair<uint64_t, uint64_t>> items;
+
+        for (uint64_t key : keys) {
+            items.emplace_back(key, key);
+        }
+
+        auto layout = state.range(1) == 0 ? zen::corex::FlatLayout::Sorted : zen::corex::FlatLayout::Eytzinger;
+        zen::corex::FlatMap<uint64_t, uint64_t> map(std::move(items), layout);
+
+        size_t i = 0;
+        while (state.keepRunning()) {
+            doNotOptimize(map.find(keys[i]));
+            i = i + 1 == keys.size() ? 0 : i + 1;
+        }
+
+        state.setItemsProcessed(state.getIterations());
+    }
+
+    void stdMapGet(State& state) {
+        std::vector<uint64_t> keys = zen::benchmark::randomIntegers(state.range(), 1ull << 62);
+        std::map<uint64_t, uint64_t> map;
+
+        for (uint64_t key : keys) {
+            map.emplace(key, key);
+        }
+
+        size_t i = 0;
+        while (state.keepRunning()) {
+            doNotOptimize(map.find(keys[i]));
+            i = i + 1 == keys.size() ? 0 : i + 1;
+        }
+
+        state.setItemsProcessed(state.getIterations());
+    }
+
+    /* Allocation: state.range() small objects, then everything released at once */
+
+    struct Node {
+        uint64_t key;
+        uint64_t value;
+        Node* next;
+    };
+
+    void arenaAllocate(State& state) {
+        zen::corex::Arena arena;
+        size_t count = state.range();
+
+        while (state.keepRunning()) {
+            for (size_t i = 0; i < count; i++) {
+                doNotOptimize(arena.create<Node>(Node{i, i, nullptr}));
+            }
+
+            arena.reset();
+        }
+
+        state.setItemsProcessed(state.getIterations() * count);
+    }
+
+    void mallocAllocate(State& state) {
+        size_t count = state.range();
+        std::vector<Node*> nodes(count);
+
+        while (state.keepRunning()) {
+            for (size_t i = 0; i < count; i++) {
+                nodes[i] = static_cast<Node*>(std::malloc(sizeof(Node)));
+                *nodes[i] = Node{i, i, nullptr};
+                doNotOptimize(nodes[i]);
+            }
+
+            for (Node* node : nodes) {
+                std::free(node);
+            }
+        }
+
+        state.setItemsProcessed(state.getIterations() * count);
+    }
+
+    void objectPoolCreate(State& state) {
+        zen::corex::ObjectPool<Node> pool;
+        size_t count = state.range();
+        std::vector<Node*> nodes(count);
+
+        while (state.keepRunning()) {
+            for (size_t i = 0; i < count; i++) {
+                nodes[i] = pool.create(Node{i, i, nullptr});
+                doNotOptimize(nodes[i]);
+            }
+
+            for (Node* node : nodes) {
+                pool.destroy(node);
+            }
+        }
+
+        state.setItemsProcessed(state.getIterations() * count);
+    }
+
+    void newCreate(State& state) {
+        size_t count = state.range();
+        std::vector<Node*> nodes(count);
+
+        while (state.keepRunning()) {
+            for (size_t i = 0; i < count; i++) {
+                nodes[i] = new Node{i, i, nullptr};
+                doNotOptimize(nodes[i]);
+            }
+
+            for (Node* node : nodes) {
+                delete node;
+            }
+        }
+
+        state.setItemsProcessed(state.getIterations() * count);
+    }
+
+    /* Layout: advance particle positions, reading two of the seven fields of each */
+
+    struct Particle {
+        float x, y, z;
+        float vx, vy, vz;
+        uint32_t flags;
+    };
+
+    void soaUpdate(State& state) {
+        zen::corex::SoaArray<float, float, float, float, float, float, uint32_t> particles;
+        std::vector<double> values = zen::benchmark::randomDoubles(state.range());
+
+        for (double value : values) {
+            float f = static_cast<float>(value);
+            particles.add(f, f, f, f, f, f, 0u);
+        }
+
+        while (state.keepRunning()) {
+            auto x = particles.column<0>();
+            auto vx = particles.column<3>();
+
+            for (size_t i = 0; i < x.size(); i++) {
+                x[i] += vx[i] * 0.01f;
+            }
+
+            zen::benchmark::clobberMemory();
+        }
+
+        state.setItemsProcessed(state.getIterations() * values.size());
+    }
+
+    void aosUpdate(State& state) {
+        std::vector<Particle> particles;
+        std::vector<double> values = zen::benchmark::randomDoubles(state.range());
+
+        for (double value : values) {
+            float f = static_cast<float>(value);
+            particles.push_back(Particle{f, f, f, f, f, f, 0u});
+        }
+
+        while (state.keepRunning()) {
+            for (Particle& particle : particles) {
+                particle.x += particle.vx * 0.01f;
+            }
+
+            zen::benchmark::clobberMemory();
+        }
+
+        state.setItemsProcessed(state.getIterations() * values.size());
+    }
+
+    /* Sequences */
+
+    /* A FIFO holding state.range() elements: push one, pop one */
+    void ringArrayQueue(State& state) {
+        zen::corex::RingArray<uint64_t> ring;
+
+        for (int64_t i = 0; i < state.range(); i++) {
+            ring.pushBack(i);
+        }
+
+        while (state.keepRunning()) {
+            ring.pushBack(ring.popFront());
+        }
+
+        state.setItemsProcessed(state.getIterations());
+    }
+
+    void dequeQueue(State& state) {
+        std::deque<uint64_t> deque;
+
+        for (int64_t i = 0; i < state.range(); i++) {
+            deque.push_back(i);
+        }
+
+        while (state.keepRunning()) {
+            deque.push_back(deque.front());
+            deque.pop_front();
+        }
+
+        state.setItemsProcessed(state.getIterations());
+    }
+
+    void segmentedArrayAdd(State& state) {
+        size_t count = state.range();
+
+        while (state.keepRunning()) {
+            zen::corex::SegmentedArray<uint64_t> array;
+
+            for (size_t i = 0; i < count; i++) {
+                array.add(i);
+            }
+
+            doNotOptimize(array.getSize());
+        }
+
+        state.setItemsProcessed(state.getIterations() * count);
+    }
+
+    void vectorPushBack(State& state) {
+        size_t count = state.range();
+
+        while (state.keepRunning()) {
+            std::vector<uint64_t> vector;
+
+            for (size_t i = 0; i < count; i++) {
+                vector.push_back(i);
+            }
+
+            doNotOptimize(vector.size());
+        }
+
+        state.setItemsProcessed(state.getIterations() * count);
+    }
+
+    /* Bit arrays with about half the bits set */
+
+    zen::corex::BitArray randomBits(size_t size) {
+        zen::corex::BitArray bits(size);
+        std::vector<uint64_t> values = zen::benchmark::randomIntegers(size, 2);
+
+        for (size_t i = 0; i < size; i++) {
+            bits.set(i, values[i] != 0);
+        }
+
+        return bits;
+    }
+
+    void bitArrayCount(State& state) {
+        zen::corex::BitArray bits = randomBits(state.range());
+
+        while (state.keepRunning()) {
+            doNotOptimize(bits.count());
+        }
+
+        state.setBytesProcessed(state.getIterations() * bits.getSize() / 8);
+    }
+
+    void bitArrayRank(State& state) {
+        zen::corex::BitArray bits = randomBits(state.range());
+        std::vector<uint64_t> positions = zen::benchmark::randomIntegers(4096, bits.getSize());
+        bits.buildIndex();
+
+        size_t i = 0;
+        while (state.keepRunning()) {
+            doNotOptimize(bits.rank(positions[i]));
+            i = (i + 1) & 4095;
+        }
+
+        state.setItemsProcessed(state.getIterations());
+    }
+
+    void bitArraySelect(State& state) {
+        zen::corex::BitArray bits = randomBits(state.range());
+        std::vector<uint64_t> ranks = zen::benchmark::randomIntegers(4096, bits.count());
+        bits.buildIndex();
+
+        size_t i = 0;
+        while (state.keepRunning()) {
+            doNotOptimize(bits.select(ranks[i]));
+            i = (i + 1) & 4095;
+        }
+
+        state.setItemsProcessed(state.getIterations());
+    }
+
+    void bitArrayIterate(State& state) {
+        zen::corex::BitArray bits = randomBits(state.range());
+
+        while (state.keepRunning()) {
+            size_t visited = 0;
+
+            for (size_t i = bits.findFirstSet(); i != zen::corex::BitArray::NOT_FOUND; i = bits.findNextSet(i + 1)) {
+                visited++;
+            }
+
+            doNotOptimize(visited);
+        }
+
+        state.setBytesProcessed(state.getIterations() * bits.getSize() / 8);
+    }
+
+    /* Caches: Zipf-distributed keys over ten times as many keys as the cache holds */
+
+    void lruCacheZipf(State& state) {
+        size_t capacity = state.range();
+        std::vector<uint64_t> keys = zen::benchmark::zipfIntegers(1 << 20, capacity * 10);
+
+        zen::corex::LruCacheOptions options;
+        options.capacity = capacity;
+        zen::corex::LruCache<uint64_t, uint64_t> cache(options);
+
+        size_t i = 0;
+        while (state.keepRunning()) {
+            uint64_t key = keys[i];
+            doNotOptimize(cache.getOrCompute(key, [key] { return key * 2; }));
+            i = (i + 1) & ((1 << 20) - 1);
+        }
+
+        zen::corex::LruCacheStats stats = cache.getStats();
+        state.setCounter("hit_rate", static_cast<double>(stats.hits) / static_cast<double>(stats.hits + stats.misses));
+        state.setItemsProcessed(state.getIterations());
+    }
+
+    /*
+     * Filters holding state.range() keys. Lookups are half present, half
+     * absent keys; fpr is measured on absent keys only.
+     */
+
+    template <typename F>
+    void reportFilter(State& state, const F& filter, size_t count) {
+        std::vector<uint64_t> absent = absentKeys(100000);
+        size_t positives = 0;
+
+        for (uint64_t key : absent) {
+            positives += filter.contains(key);
+        }
+
+        state.setCounter("fpr", static_cast<double>(positives) / static_cast<double>(absent.size()));
+        state.setCounter("bits_per_key", static_cast<double>(filter.getMemoryUsage() * 8) / static_cast<double>(count));
+    }
+
+    /* Second argument: wanted false positive rate, in parts per ten thousand */
+    void bloomFilterContains(State& state) {
+        std::vector<uint64_t> keys = zen::benchmark::randomIntegers(state.range(), 1ull << 62);
+        std::vector<uint64_t> absent = absentKeys(keys.size());
+        zen::corex::BloomFilter<uint64_t> filter(keys.size(), static_cast<double>(state.range(1)) / 10000);
+        filter.addAll(keys.data(), keys.size());
+
+        size_t i = 0;
+        while (state.keepRunning()) {
+            doNotOptimize(filter.contains((i & 1) ? keys[i] : absent[i]));
+            i = i + 1 == keys.size() ? 0 : i + 1;
+        }
+
+        reportFilter(state, filter, keys.size());
+        state.setItemsProcessed(state.getIterations());
+    }
+
+    /* The batched, prefetching lookup */
+    void bloomFilterContainsAll(State& state) {
+        std::vector<uint64_t> keys = zen::benchmark::randomIntegers(state.range(), 1ull << 62);
+        zen::corex::BloomFilter<uint64_t> filter(keys.size(), 0.01);
+        filter.addAll(keys.data(), keys.size());
+        std::unique_ptr<bool[]> results(new bool[keys.size()]);
+
+        while (state.keepRunning()) {
+            doNotOptimize(filter.containsAll(keys.data(), keys.size(), results.get()));
+        }
+
+        state.setItemsProcessed(state.getIterations() * keys.size());
+    }
+
+    void bloomFilterAdd(State& state) {
+        std::vector<uint64_t> keys = zen::benchmark::randomIntegers(state.range(), 1ull << 62);
+
+        while (state.keepRunning()) {
+            zen::corex::BloomFilter<uint64_t> filter(keys.size(), 0.01);
+
+            for (uint64_t key : keys) {
+                filter.add(key);
+            }
+
+            doNotOptimize(filter.getCount());
+        }
+
+        state.setItemsProcessed(state.getIterations() * keys.size());
+    }
+
+    void cuckooFilterContains(State& state) {
+        std::vector<uint64_t> keys = zen::benchmark::randomIntegers(state.range(), 1ull << 62);
+        std::vector<uint64_t> absent = absentKeys(keys.size());
+        zen::corex::CuckooFilter<uint64_t> filter(keys.size());
+
+        for (uint64_t key : keys) {
+            filter.add(key);
+        }
+
+        size_t i = 0;
+        while (state.keepRunning()) {
+            doNotOptimize(filter.contains((i & 1) ? keys[i] : absent[i]));
+            i = i + 1 == keys.size() ? 0 : i + 1;
+        }
+
+        reportFilter(state, filter, keys.size());
+        state.setCounter("load_factor", filter.getLoadFactor());
+        state.setItemsProcessed(state.getIterations());
+    }
+
+    void cuckooFilterAdd(State& state) {
+        std::vector<uint64_t> keys = zen::benchmark::randomIntegers(state.range(), 1ull << 62);
+
+        while (state.keepRunning()) {
+            zen::corex::CuckooFilter<uint64_t> filter(keys.size());
+
+            for (uint64_t key : keys) {
+                filter.add(key);
+            }
+
+            doNotOptimize(filter.getCount());
+        }
+
+        state.setItemsProcessed(state.getIterations() * keys.size());
+    }
+
+    /* Sketches: throughput of add(), with the observed error as a counter */
+
+    /* First argument: distinct keys; second: precision */
+    void hyperLogLogAdd(State& state) {
+        std::vector<uint64_t> keys = zen::benchmark::randomIntegers(state.range(), 1ull << 62);
+        zen::corex::HyperLogLog<uint64_t> sketch(static_cast<unsigned int>(state.range(1)));
+
+        size_t i = 0;
+        while (state.keepRunning()) {
+            sketch.add(keys[i]);
+            i = i + 1 == keys.size() ? 0 : i + 1;
+        }
+
+        zen::corex::HyperLogLog<uint64_t> full(static_cast<unsigned int>(state.range(1)));
+        for (uint64_t key : keys) {
+            full.add(key);
+        }
+
+        double actual = static_cast<double>(keys.size());
+        state.setCounter("relative_error", std::abs(full.count() - actual) / actual);
+        state.setCounter("expected_error", full.getRelativeError());
+        state.setItemsProcessed(state.getIterations());
+    }
+
+    /* Log-normal latencies around 1 ms; argument: relative accuracy in parts per thousand */
+    void ddSketchAdd(State& state) {
+        std::vector<double> uniform = zen::benchmark::randomDoubles(1 << 16, -3, 3);
+        std::vector<double> values(uniform.size());
+
+        for (size_t i = 0; i < values.size(); i++) {
+            values[i] = 1e6 * std::exp(uniform[i]);
+        }
+
+        zen::corex::DDSketch sketch(static_cast<double>(state.range()) / 1000);
+
+        size_t i = 0;
+        while (state.keepRunning()) {
+            sketch.add(values[i]);
+            i = (i + 1) & ((1 << 16) - 1);
+        }
+
+        zen::corex::DDSketch full(static_cast<double>(state.range()) / 1000);
+        for (double value : values) {
+            full.add(value);
+        }
+
+        std::vector<double> sorted = values;
+        std::sort(sorted.begin(), sorted.end());
+        double exact = sorted[static_cast<size_t>(0.99 * (sorted.size() - 1))];
+
+        state.setCounter("p99_error", std::abs(full.quantile(0.99) - exact) / exact);
+        state.setCounter("buckets", static_cast<double>(full.getBucketCount()));
+        state.setItemsProcessed(state.getIterations());
+    }
+}
+
+ZEN_BENCHMARK(hashMapGet)->range(1 << 10, 1 << 22);
+ZEN_BENCHMARK(unorderedMapGet)->range(1 << 10, 1 << 22);
+ZEN_BENCHMARK(hashMapPut)->range(1 << 10, 1 << 20);
+ZEN_BENCHMARK(unorderedMapPut)->range(1 << 10, 1 << 20);
+ZEN_BENCHMARK(flatMapGet)->ranges({{1 << 10, 1 << 16, 1 << 22}, {0, 1}});
+ZEN_BENCHMARK(stdMapGet)->ranges({{1 << 10, 1 << 16, 1 << 22}});
+
+ZEN_BENCHMARK(arenaAllocate)->range(1 << 10, 1 << 16);
+ZEN_BENCHMARK(mallocAllocate)->range(1 << 10, 1 << 16);
+ZEN_BENCHMARK(objectPoolCreate)->range(1 << 10, 1 << 16);
+ZEN_BENCHMARK(newCreate)->range(1 << 10, 1 << 16);
+
+ZEN_BENCHMARK(soaUpdate)->range(1 << 10, 1 << 20);
+ZEN_BENCHMARK(aosUpdate)->range(1 << 10, 1 << 20);
+
+ZEN_BENCHMARK(ringArrayQueue)->range(1 << 4, 1 << 16);
+ZEN_BENCHMARK(dequeQueue)->range(1 << 4, 1 << 16);
+ZEN_BENCHMARK(segmentedArrayAdd)->range(1 << 10, 1 << 20);
+ZEN_BENCHMARK(vectorPushBack)->range(1 << 10, 1 << 20);
+
+ZEN_BENCHMARK(bitArrayCount)->range(1 << 10, 1 << 24);
+ZEN_BENCHMARK(bitArrayRank)->range(1 << 10, 1 << 24);
+ZEN_BENCHMARK(bitArraySelect)->range(1 << 10, 1 << 24);
+ZEN_BENCHMARK(bitArrayIterate)->range(1 << 10, 1 << 20);
+
+ZEN_BENCHMARK(lruCacheZipf)->range(1 << 10, 1 << 16);
+
+ZEN_BENCHMARK(bloomFilterContains)->ranges({{1 << 16, 1 << 22}, {1000, 100, 10}});
+ZEN_BENCHMARK(bloomFilterContainsAll)->range(1 << 16, 1 << 22);
+ZEN_BENCHMARK(bloomFilterAdd)->range(1 << 16, 1 << 22);
+ZEN_BENCHMARK(cuckooFilterContains)->range(1 << 16, 1 << 22);
+ZEN_BENCHMARK(cuckooFilterAdd)->range(1 << 16, 1 << 22);
+
+ZEN_BENCHMARK(hyperLogLogAdd)->ranges({{1 << 20}, {10, 14, 18}});
+ZEN_BENCHMARK(ddSketchAdd)->arg(5)->arg(10)->arg(20);
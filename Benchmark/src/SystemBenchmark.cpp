@@ -0,0 +1,56 @@
+#include "Benchmark.h"
+
+#include "../../System/src/System.h"
+
+/*
+ * Benchmarks of the System module. Every call reads /proc or the C
+ * library, so these measure the cost of polling system state in a loop.
+ * Clipboard and file-opening functions are left out: they start external
+ * programs and have visible side effects.
+ */
+
+namespace {
+    using zen::benchmark::State;
+    using zen::benchmark::doNotOptimize;
+
+    void readSystemInfo(State& state) {
+        while (state.keepRunning()) {
+            doNotOptimize(zen::sys::readSystemInfo());
+        }
+
+        state.setItemsProcessed(state.getIterations());
+    }
+
+    void readCpuInfo(State& state) {
+        while (state.keepRunning()) {
+            doNotOptimize(zen::sys::readCpuInfo());
+        }
+
+        state.setItemsProcessed(state.getIterations());
+    }
+
+    void readMemoryInfo(State& state) {
+        while (state.keepRunning()) {
+            doNotOptimize(zen::sys::readMemoryInfo());
+        }
+
+        state.setItemsProcessed(state.getIterations());
+    }
+
+    void getTimeDate(State& state) {
+        auto format = static_cast<zen::sys::TimeFormat>(state.range());
+
+        while (state.keepRunning()) {
+            doNotOptimize(zen::sys::getTimeDate(format));
+        }
+
+        state.setItemsProcessed(state.getIterations());
+    }
+}
+
+ZEN_BENCHMARK(readSystemInfo);
+ZEN_BENCHMARK(readCpuInfo);
+ZEN_BENCHMARK(readMemoryInfo);
+ZEN_BENCHMARK(getTimeDate)->arg(static_cast<int64_t>(zen::sys::TimeFormat::Time))
+                          ->arg(static_cast<int64_t>(zen::sys::TimeFormat::Date))
+                          ->arg(static_cast<int64_t>(zen::sys::TimeFormat::Both));
@@ -0,0 +1,131 @@
+#include "Benchmark.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+#include "../../Terminal/src/Logger.h"
+#include "../../Terminal/src/RateLimit.h"
+
+/*
+ * Benchmarks of the Terminal module that do not need an interactive
+ * terminal: the asynchronous logger writing to a scratch file, the rate
+ * limiter and the color lookups done on every print.
+ */
+
+namespace {
+    using zen::benchmark::State;
+    using zen::benchmark::doNotOptimize;
+    using zen::terminal::Logger;
+    using zen::terminal::LoggerOptions;
+    using zen::terminal::MessageType;
+
+    using Clock = std::chrono::steady_clock;
+
+    /* A file-only logger whose file is deleted when the benchmark returns */
+    struct ScratchLogger {
+        std::string path;
+        LoggerOptions options;
+
+        ScratchLogger() : path(zen::benchmark::temporaryPath("logger.log")) {
+            options.console = false;
+            options.filePath = path;
+        }
+
+        ~ScratchLogger() {
+            std::remove(path.c_str());
+        }
+    };
+
+    /*
+     * Latency of a single log call as seen by the caller, with
+     * state.range() - 1 other threads logging at the same time. Only the
+     * benchmark thread is measured; every call is sampled for percentiles.
+     */
+    void loggerLatency(State& state) {
+        ScratchLogger scratch;
+        Logger logger(scratch.options);
+
+        std::atomic<bool> stop{false};
+        std::vector<std::thread> others;
+        for (int64_t i = 1; i < state.range(); i++) {
+            others.emplace_back([&] {
+                while (!stop.load(std::memory_order_relaxed)) {
+                    logger.log("background message from another thread", MessageType::Information);
+                }
+            });
+        }
+
+        while (state.keepRunning()) {
+            auto started = Clock::now();
+            logger.log("request handled in 42 ms", MessageType::Information);
+            state.addSample(std::chrono::duration<double, std::nano>(Clock::now() - started).count());
+        }
+
+        stop.store(true, std::memory_order_relaxed);
+        for (std::thread& thread : others) {
+            thread.join();
+        }
+
+        logger.flush();
+        state.setCounter("dropped", static_cast<double>(logger.getDroppedCount()));
+        state.setItemsProcessed(state.getIterations());
+    }
+
+    /* Messages per second until they are all in the file, flush included */
+    void loggerThroughput(State& state) {
+        ScratchLogger scratch;
+        scratch.options.overflow = zen::terminal::OverflowPolicy::Block;
+        Logger logger(scratch.options);
+        size_t batch = state.range();
+
+        while (state.keepRunning()) {
+            for (size_t i = 0; i < batch; i++) {
+                logger.log(i, MessageType::Normal);
+            }
+
+            logger.flush();
+        }
+
+        state.setItemsProcessed(state.getIterations() * batch);
+    }
+
+    /* A limiter that is almost always empty, the case it exists for */
+    void rateLimiterTryAcquire(State& state) {
+        zen::terminal::RateLimiter limiter(100, 10);
+
+        while (state.keepRunning()) {
+            doNotOptimize(limiter.tryAcquire());
+        }
+
+        state.setCounter("suppressed", static_cast<double>(limiter.takeSuppressed()));
+        state.setItemsProcessed(state.getIterations());
+    }
+
+    void foregroundColor(State& state) {
+        uint8_t channel = 0;
+
+        while (state.keepRunning()) {
+            doNotOptimize(zen::terminal::foregroundColor(channel, 128, 255 - channel));
+            channel++;
+        }
+
+        state.setItemsProcessed(state.getIterations());
+    }
+
+    void messageColor(State& state) {
+        while (state.keepRunning()) {
+            doNotOptimize(zen::terminal::messageColor(MessageType::Warning));
+        }
+
+        state.setItemsProcessed(state.getIterations());
+    }
+}
+
+ZEN_BENCHMARK(loggerLatency)->arg(1)->arg(2)->arg(4);
+ZEN_BENCHMARK(loggerThroughput)->arg(1000)->arg(100000);
+ZEN_BENCHMARK(rateLimiterTryAcquire);
+ZEN_BENCHMARK(foregroundColor);
+ZEN_BENCHMARK(messageColor);
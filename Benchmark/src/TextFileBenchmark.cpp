@@ -0,0 +1,111 @@
+#include "Benchmark.h"
+
+#include <cstdio>
+
+#include "../../TextFile/src/TextFile.h"
+
+/*
+ * Benchmarks of the TextFile module over generated files of 4 KiB to
+ * 16 MiB. The file is written once per run, outside the measured loop,
+ * and stays in the page cache, so the numbers are parsing throughput
+ * rather than disk speed.
+ */
+
+namespace {
+    using zen::benchmark::State;
+    using zen::benchmark::doNotOptimize;
+    using zen::file::text::CountItem;
+    using zen::file::text::TextFile;
+
+    /* A generated text file that is deleted when the benchmark returns */
+    struct ScratchFile {
+        std::string path;
+        std::string text;
+
+        explicit ScratchFile(size_t bytes) : path(zen::benchmark::temporaryPath("text.txt")), text(zen::benchmark::randomText(bytes)) {
+            TextFile(path).write(text);
+        }
+
+        ~ScratchFile() {
+            std::remove(path.c_str());
+        }
+    };
+
+    void textFileWrite(State& state) {
+        ScratchFile scratch(state.range());
+        TextFile file(scratch.path);
+
+        while (state.keepRunning()) {
+            doNotOptimize(file.write(scratch.text));
+        }
+
+        state.setBytesProcessed(state.getIterations() * scratch.text.size());
+    }
+
+    void textFileRead(State& state) {
+        ScratchFile scratch(state.range());
+        TextFile file(scratch.path);
+
+        while (state.keepRunning()) {
+            doNotOptimize(file.read());
+        }
+
+        state.setBytesProcessed(state.getIterations() * scratch.text.size());
+    }
+
+    void textFileReadAllLines(State& state) {
+        ScratchFile scratch(state.range());
+        TextFile file(scratch.path);
+
+        while (state.keepRunning()) {
+            doNotOptimize(file.readAllLines());
+        }
+
+        state.setBytesProcessed(state.getIterations() * scratch.text.size());
+    }
+
+    void textFileReadLastLine(State& state) {
+        ScratchFile scratch(state.range());
+        TextFile file(scratch.path);
+
+        while (state.keepRunning()) {
+            doNotOptimize(file.readLastLine());
+        }
+
+        state.setItemsProcessed(state.getIterations());
+    }
+
+    void textFileFind(State& state) {
+        ScratchFile scratch(state.range());
+        TextFile file(scratch.path);
+        bool caseSensitive = state.range(1) != 0;
+
+        /* A key that does not occur, so the whole file is scanned */
+        while (state.keepRunning()) {
+            doNotOptimize(file.find("zzzzzzzzzzzz", caseSensitive, false));
+        }
+
+        state.setBytesProcessed(state.getIterations() * scratch.text.size());
+    }
+
+    void textFileCount(State& state) {
+        ScratchFile scratch(state.range());
+        TextFile file(scratch.path);
+        auto item = static_cast<CountItem>(state.range(1));
+
+        while (state.keepRunning()) {
+            doNotOptimize(file.count(item));
+        }
+
+        state.setBytesProcessed(state.getIterations() * scratch.text.size());
+    }
+}
+
+ZEN_BENCHMARK(textFileWrite)->range(4 << 10, 16 << 20, 64);
+ZEN_BENCHMARK(textFileRead)->range(4 << 10, 16 << 20, 64);
+ZEN_BENCHMARK(textFileReadAllLines)->range(4 << 10, 16 << 20, 64);
+ZEN_BENCHMARK(textFileReadLastLine)->range(4 << 10, 16 << 20, 64);
+ZEN_BENCHMARK(textFileFind)->ranges({{64 << 10, 16 << 20}, {0, 1}});
+ZEN_BENCHMARK(textFileCount)->ranges({{64 << 10, 16 << 20},
+                                      {static_cast<int64_t>(CountItem::Words), static_cast<int64_t>(CountItem::Characters),
+                                       static_cast<int64_t>(CountItem::Lines), static_cast<int64_t>(CountItem::EmptyLines)}});
@@ -0,0 +1,105 @@
+#include "Arena.h"
+
+#include <algorithm>
+
+namespace zen::corex {
+    Arena::Arena(size_t chunkSize, std::pmr::memory_resource* upstream)
+        : upstream(upstream), chunkSize(std::max<size_t>(chunkSize, 256)) {}
+
+    Arena::~Arena() {
+        release();
+    }
+
+    void* Arena::allocateSlow(size_t bytes, size_t alignment) {
+        size_t needed = bytes + alignment - 1;
+
+        if (current) {
+            committed += position - current->begin();
+        }
+
+        /* Reuse the chunks left behind by reset() or rewind() when they are big enough */
+        Chunk* previous = current;
+        Chunk* next = current ? current->next : first;
+
+        while (next && next->size < needed) {
+            previous = next;
+            next = next->next;
+        }
+
+        if (!next) {
+            size_t size = std::max(chunkSize, needed);
+
+            next = static_cast<Chunk*>(upstream->allocate(sizeof(Chunk) + size, alignof(Chunk)));
+            next->size = size;
+            next->next = nullptr;
+            reserved += size;
+
+            if (previous) {
+                previous->next = next;
+            } else {
+                first = next;
+            }
+        }
+
+        current = next;
+        position = current->begin();
+        limit = current->end();
+
+        uintptr_t aligned = (reinterpret_cast<uintptr_t>(position) + alignment - 1) & ~(alignment - 1);
+        position = reinterpret_cast<char*>(aligned + bytes);
+
+        return reinterpret_cast<void*>(aligned);
+    }
+
+    void* Arena::do_allocate(size_t bytes, size_t alignment) {
+        return allocate(bytes, alignment);
+    }
+
+    void Arena::do_deallocate(void*, size_t, size_t) {}
+
+    bool Arena::do_is_equal(const std::pmr::memory_resource& other) const noexcept {
+        return this == &other;
+    }
+
+    Arena::Marker Arena::mark() const {
+        return Marker{current, position, committed};
+    }
+
+    void Arena::rewind(const Marker& marker) {
+        if (!marker.chunk) {
+            reset();
+            return;
+        }
+
+        current = marker.chunk;
+        position = marker.position;
+        limit = current->end();
+        committed = marker.committed;
+    }
+
+    void Arena::reset() {
+        current = nullptr;
+        position = nullptr;
+        limit = nullptr;
+        committed = 0;
+    }
+
+    void Arena::release() {
+        while (first) {
+            Chunk* next = first->next;
+            upstream->deallocate(first, sizeof(Chunk) + first->size, alignof(Chunk));
+            first = next;
+        }
+
+        reserved = 0;
+        reset();
+    }
+
+    size_t Arena::getUsed() const {
+        return committed + (current ? position - current->begin() : 0);
+    }
+
+    size_t Arena::getReserved() const {
+        return reserved;
+    }
+}
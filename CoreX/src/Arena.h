@@ -0,0 +1,180 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <new>
+#include <utility>
+
+namespace zen::corex {
+    /**
+     * @brief Monotonic bump allocator with chunk chaining
+     *
+     * An Arena hands out memory by moving a pointer forward inside a large
+     * chunk; when the chunk is full a new one is chained after it. Single
+     * objects are never freed: the whole arena is released at once by
+     * reset(), or back to a saved point by rewind(). Chunks are kept for
+     * reuse, so an arena that is reset between batches of work stops
+     * calling malloc after the first batch.
+     *
+     * Arena is a std::pmr::memory_resource, so it can back std::pmr
+     * containers as well as CoreX containers that accept a resource
+     * (HashMap, HashSet).
+     *
+     * Example usage:
+     * @code
+     * zen::corex::Arena arena;
+     *
+     * for (const auto& file : files) {
+     *     zen::corex::HashMap<std::string_view, int> counts(&arena);
+     *     countWords(file, counts);
+     *
+     *     arena.reset();   // everything of this file is gone in O(chunks)
+     * }
+     * @endcode
+     *
+     * @note Destructors of objects built with create() are not run; use the
+     *       arena for trivially destructible data or objects whose
+     *       destruction you manage yourself. An arena is not thread-safe.
+     */
+    class Arena : public std::pmr::memory_resource {
+        private:
+            struct Chunk {
+                Chunk* next;        ///< Following chunk in allocation order
+                size_t size;        ///< Usable bytes after the header
+
+                char* begin() {
+                    return reinterpret_cast<char*>(this + 1);
+                }
+
+                char* end() {
+                    return begin() + size;
+                }
+            };
+
+            std::pmr::memory_resource* upstream;
+            size_t chunkSize;
+
+            Chunk* first = nullptr;         ///< Oldest chunk, start of the chain
+            Chunk* current = nullptr;       ///< Chunk being bumped
+            char* position = nullptr;       ///< Next free byte in current
+            char* limit = nullptr;          ///< End of current
+
+            size_t reserved = 0;            ///< Bytes in all chunks
+            size_t committed = 0;           ///< Bytes of chunks before current that are in use
+
+            void* allocateSlow(size_t bytes, size_t alignment);
+
+        protected:
+            void* do_allocate(size_t bytes, size_t alignment) override;
+
+            void do_deallocate(void* pointer, size_t bytes, size_t alignment) override;
+
+            bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+
+        public:
+            /**
+             * @brief Saved allocation point, see mark() and rewind()
+             */
+            struct Marker {
+                Chunk* chunk = nullptr;
+                char* position = nullptr;
+                size_t committed = 0;
+            };
+
+            /**
+             * @brief Constructs an empty arena
+             *
+             * No memory is allocated until the first allocation.
+             *
+             * @param chunkSize Usable bytes of each chunk; bigger requests get a chunk of their own
+             * @param upstream Resource the chunks come from
+             */
+            explicit Arena(size_t chunkSize = 64 * 1024,
+                           std::pmr::memory_resource* upstream = std::pmr::new_delete_resource());
+
+            /**
+             * @brief Returns every chunk to the upstream resource
+             */
+            ~Arena() override;
+
+            Arena(const Arena&) = delete;
+
+            Arena& operator=(const Arena&) = delete;
+
+            /**
+             * @brief Allocates uninitialized memory
+             *
+             * @param bytes Number of bytes
+             * @param alignment Alignment, a power of two
+             * @return Pointer to the memory, valid until reset(), a rewind() past it or destruction
+             *
+             * @complexity O(1); a pointer bump unless a new chunk is needed
+             */
+            void* allocate(size_t bytes, size_t alignment = alignof(std::max_align_t)) {
+                uintptr_t aligned = (reinterpret_cast<uintptr_t>(position) + alignment - 1) & ~(alignment - 1);
+
+                if (position && aligned + bytes <= reinterpret_cast<uintptr_t>(limit)) {
+                    position = reinterpret_cast<char*>(aligned + bytes);
+                    return reinterpret_cast<void*>(aligned);
+                }
+
+                return allocateSlow(bytes, alignment);
+            }
+
+            /**
+             * @brief Allocates and constructs an object
+             *
+             * @param args Arguments forwarded to the constructor
+             * @return Pointer to the new object; its destructor will not be run by the arena
+             */
+            template <typename T, typename... Args>
+            T* create(Args&&... args) {
+                return new (allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+            }
+
+            /**
+             * @brief Allocates an uninitialized array
+             *
+             * @param count Number of elements
+             */
+            template <typename T>
+            T* allocateArray(size_t count) {
+                return static_cast<T*>(allocate(sizeof(T) * count, alignof(T)));
+            }
+
+            /**
+             * @brief Returns the current allocation point
+             */
+            Marker mark() const;
+
+            /**
+             * @brief Frees everything allocated after a marker
+             *
+             * @param marker Value returned by mark() on this arena since the last reset()
+             *
+             * @complexity O(1); later chunks are kept for reuse
+             */
+            void rewind(const Marker& marker);
+
+            /**
+             * @brief Frees every allocation and keeps the chunks for reuse
+             */
+            void reset();
+
+            /**
+             * @brief Frees every allocation and returns the chunks to the upstream resource
+             */
+            void release();
+
+            /**
+             * @brief Returns the number of bytes handed out since the last reset (padding included)
+             */
+            size_t getUsed() const;
+
+            /**
+             * @brief Returns the number of bytes held in chunks
+             */
+            size_t getReserved() const;
+    };
+}
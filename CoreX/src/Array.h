@@ -4,6 +4,22 @@
 #include <memory>
 #include <vector>
 #include <array>
+#include <atomic>
+#include <compare>
+#include <cstring>
+#include <iterator>
+#include <ranges>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+#include "Execution.h"
+#include "HashSet.h"
+#include "Numeric.h"
+#include "Random.h"
+#include "Serialization.h"
+#include "String.h"
 
 using std::cout, std::cin, std::endl;
 
@@ -35,6 +51,85 @@ namespace zen::corex {
             std::unique_ptr<T[]> data;  ///< Underlying dynamic array storage
             size_t size;                 ///< Current number of elements
 
+            template <typename>
+            friend class Array;
+
+            /**
+             * @brief Copies count elements starting at first into destination
+             *
+             * Uses a single memcpy when the source is contiguous storage of a
+             * trivially copyable T.
+             */
+            template <typename I>
+            static void copyElements(T* destination, I first, size_t count) {
+                if constexpr (std::contiguous_iterator<I> && std::is_same_v<std::iter_value_t<I>, T> &&
+                              std::is_trivially_copyable_v<T>) {
+                    if (count > 0) {
+                        std::memcpy(destination, std::to_address(first), count * sizeof(T));
+                    }
+                } else {
+                    for (size_t i = 0; i < count; i++, ++first) {
+                        destination[i] = *first;
+                    }
+                }
+            }
+
+            /**
+             * @brief True if two elements are equal exactly when their bytes are
+             *
+             * Holds for integers, enums and pointers, but not for floating
+             * point (0.0 == -0.0, NaN != NaN) or classes with their own operator==.
+             */
+            static constexpr bool BITWISE_COMPARABLE = std::is_integral_v<T> || std::is_enum_v<T> || std::is_pointer_v<T>;
+
+            /**
+             * @brief Returns the index of the first of count elements that differs from input
+             *
+             * Returns count if they are all equal. Bitwise comparable elements
+             * skip the equal prefix with memcmp of 256-byte blocks.
+             */
+            size_t mismatch(const Array& input, size_t count) const {
+                size_t i = 0;
+
+                if constexpr (BITWISE_COMPARABLE) {
+                    constexpr size_t block = std::max<size_t>(1, 256 / sizeof(T));
+
+                    while (i + block <= count && std::memcmp(data.get() + i, input.data.get() + i, block * sizeof(T)) == 0) {
+                        i += block;
+                    }
+                }
+
+                while (i < count && data[i] == input.data[i]) {
+                    i++;
+                }
+
+                return i;
+            }
+
+            /**
+             * @brief Moves count elements between two distinct buffers
+             */
+            static void moveElements(T* destination, T* source, size_t count) {
+                if constexpr (std::is_trivially_copyable_v<T>) {
+                    if (count > 0) {
+                        std::memcpy(destination, source, count * sizeof(T));
+                    }
+                } else {
+                    std::move(source, source + count, destination);
+                }
+            }
+
+            /**
+             * @brief Assigns value to count consecutive elements
+             */
+            static void fillElements(T* destination, size_t count, const T& value) {
+                if constexpr (std::is_trivially_copyable_v<T>) {
+                    detail::fillPattern(destination, &value, sizeof(T), count);
+                } else {
+                    std::fill_n(destination, count, value);
+                }
+            }
+
         public:
             /**
              * @brief Constructs an empty array
@@ -57,12 +152,10 @@ namespace zen::corex {
              * @complexity O(n) where n is the size of the vector
              */
             Array(const std::vector<T>& items) {
-                data = std::make_unique<T[]>(items.size());
+                data = std::make_unique_for_overwrite<T[]>(items.size());
                 size = items.size();
 
-                for (size_t i = 0; i < items.size(); i++) {
-                    data[i] = items[i];
-                }
+                copyElements(data.get(), items.begin(), size);
             }
 
             /**
@@ -93,6 +186,37 @@ namespace zen::corex {
                 }
             }
 
+            /**
+             * @brief Constructs an array from an iterator pair
+             *
+             * @param first Iterator to the first element to copy
+             * @param last End of the range
+             *
+             * The storage is allocated once when the length of the range is
+             * known up front (forward iterators); contiguous ranges of
+             * trivially copyable elements are copied with memcpy.
+             *
+             * @complexity O(n)
+             */
+            template <std::input_iterator I, std::sentinel_for<I> S>
+                requires std::convertible_to<std::iter_reference_t<I>, T>
+            Array(I first, S last) : data(nullptr), size(0) {
+                insert(0, std::move(first), std::move(last));
+            }
+
+            /**
+             * @brief Constructs an array from any range, such as a std::span or a std::deque
+             *
+             * @param items Range whose elements are converted to T
+             *
+             * @complexity O(n)
+             */
+            template <std::ranges::input_range R>
+                requires std::convertible_to<std::ranges::range_reference_t<const R&>, T>
+            explicit Array(const R& items) : data(nullptr), size(0) {
+                insert(0, items);
+            }
+
             /**
              * @brief Move constructor
              * 
@@ -160,11 +284,11 @@ namespace zen::corex {
              */
             Array& operator=(const Array<T>& input) {
                 if (this != &input) {
-                    clear();
-        
-                    for (size_t i = 0; i < input.size; i++) {
-                        add(input.data[i]);
-                    }
+                    auto newData = std::make_unique_for_overwrite<T[]>(input.size);
+                    copyElements(newData.get(), input.data.get(), input.size);
+
+                    data = std::move(newData);
+                    size = input.size;
                 }
 
                 return *this;
@@ -177,20 +301,21 @@ namespace zen::corex {
              * @return true If arrays have the same size and all elements are equal
              * @return false Otherwise
              * 
-             * @complexity O(n) where n is the size of the arrays
+             * Sizes are compared first. Integers, enums and pointers are then
+             * compared with a single memcmp.
+             * 
+             * @complexity O(1) if the sizes differ, otherwise O(n)
              */
             bool operator==(const Array<T>& input) const {
                 if (input.size != size) {
                     return false;
                 }
 
-                for (size_t i = 0; i < input.size; i++) {
-                    if (data[i] != input[i]) {
-                        return false;
-                    }
+                if constexpr (BITWISE_COMPARABLE) {
+                    return size == 0 || std::memcmp(data.get(), input.data.get(), size * sizeof(T)) == 0;
+                } else {
+                    return mismatch(input, size) == size;
                 }
-
-                return true;
             }
 
             /**
@@ -200,20 +325,45 @@ namespace zen::corex {
              * @return true If arrays differ in size or any element
              * @return false If arrays are identical
              * 
-             * @complexity O(n) where n is the size of the arrays
+             * @complexity O(1) if the sizes differ, otherwise O(n)
              */
             bool operator!=(const Array<T>& input) const {
-                if (input.size != size) {
-                    return true;
-                }
+                return !(*this == input);
+            }
 
-                for (size_t i = 0; i < input.size; i++) {
-                    if (data[i] != input[i]) {
-                        return true;
+            /**
+             * @brief Three-way comparison operator
+             * 
+             * @param input Array to compare with
+             * @return The lexicographic order of the arrays: the first differing
+             *         element decides, and a proper prefix orders first. The
+             *         category is the one of T (std::partial_ordering for floating point).
+             * 
+             * Makes arrays usable as keys of sorted containers and with
+             * std::sort. Single-byte unsigned elements are ordered with one
+             * memcmp; other integers skip the equal prefix with memcmp first.
+             * 
+             * @complexity O(n) where n is the size of the shorter array
+             */
+            auto operator<=>(const Array<T>& input) const requires std::three_way_comparable<T> {
+                using Ordering = std::compare_three_way_result_t<T>;
+                size_t common = std::min(size, input.size);
+
+                if constexpr (BITWISE_COMPARABLE && sizeof(T) == 1 && std::is_unsigned_v<T>) {
+                    int result = common == 0 ? 0 : std::memcmp(data.get(), input.data.get(), common);
+
+                    if (result != 0) {
+                        return Ordering(result <=> 0);
+                    }
+                } else {
+                    size_t index = mismatch(input, common);
+
+                    if (index < common) {
+                        return Ordering(data[index] <=> input.data[index]);
                     }
                 }
 
-                return false;      
+                return Ordering(size <=> input.size);
             }
 
             /**
@@ -305,6 +455,79 @@ namespace zen::corex {
                 size++;
             }
 
+            /**
+             * @brief Inserts a range of elements before an index
+             *
+             * @param index Position of the first inserted element; size appends
+             * @param first Iterator to the first element to insert
+             * @param last End of the range
+             * @throws std::out_of_range if index is greater than size
+             *
+             * Replaces calling add() in a loop, which reallocates for every
+             * element: the array grows once and the existing elements are
+             * moved (memcpy for trivially copyable T). The range may come
+             * from this array itself.
+             *
+             * @complexity O(n + m) where m is the number of inserted elements
+             */
+            template <std::input_iterator I, std::sentinel_for<I> S>
+                requires std::convertible_to<std::iter_reference_t<I>, T>
+            void insert(size_t index, I first, S last) {
+                if (index > size) {
+                    throw std::out_of_range("Index out of range");
+                }
+
+                if constexpr (!std::forward_iterator<I>) {
+                    /* Single-pass input: its length is unknown until it has been read */
+                    std::vector<T> buffer;
+                    for (; first != last; ++first) {
+                        buffer.push_back(*first);
+                    }
+
+                    insert(index, buffer.begin(), buffer.end());
+                } else {
+                    size_t count = static_cast<size_t>(std::ranges::distance(first, last));
+                    if (count == 0) {
+                        return;
+                    }
+
+                    auto newData = std::make_unique_for_overwrite<T[]>(size + count);
+
+                    /* Copy the new elements first: they may still point into the old storage */
+                    copyElements(newData.get() + index, first, count);
+                    moveElements(newData.get(), data.get(), index);
+                    moveElements(newData.get() + index + count, data.get() + index, size - index);
+
+                    data = std::move(newData);
+                    size += count;
+                }
+            }
+
+            /**
+             * @brief Inserts all elements of a range before an index
+             *
+             * @throws std::out_of_range if index is greater than size
+             */
+            template <std::ranges::input_range R>
+                requires std::convertible_to<std::ranges::range_reference_t<const R&>, T>
+            void insert(size_t index, const R& items) {
+                insert(index, std::ranges::begin(items), std::ranges::end(items));
+            }
+
+            /**
+             * @brief Replaces the contents with the elements of an iterator pair
+             *
+             * @complexity O(n), one allocation when the length of the range is known
+             */
+            template <std::input_iterator I, std::sentinel_for<I> S>
+                requires std::convertible_to<std::iter_reference_t<I>, T>
+            void assign(I first, S last) {
+                Array replacement(std::move(first), std::move(last));
+
+                data = std::move(replacement.data);
+                size = replacement.size;
+            }
+
             /**
              * @brief Removes the first occurrence of a specified element
              * 
@@ -353,21 +576,130 @@ namespace zen::corex {
                 size = 0;
             }
 
+            /**
+             * @brief Changes the number of elements
+             *
+             * @param count New size
+             * @param value Copied into the new elements when the array grows
+             *
+             * The existing elements are moved once into storage of the new
+             * size; shrinking drops the elements past count.
+             *
+             * @complexity O(n)
+             */
+            void resize(size_t count, const T& value = T()) {
+                if (count == size) {
+                    return;
+                }
+
+                auto newData = std::make_unique_for_overwrite<T[]>(count);
+                size_t kept = std::min(size, count);
+
+                /* Fill before moving: value may be an element of this array */
+                fillElements(newData.get() + kept, count - kept, value);
+                moveElements(newData.get(), data.get(), kept);
+
+                data = std::move(newData);
+                size = count;
+            }
+
+            /**
+             * @brief Assigns a value to every element
+             *
+             * Trivially copyable elements are written with vector stores of a
+             * repeated pattern (memset for single bytes).
+             *
+             * @complexity O(n)
+             */
+            void fill(const T& value) {
+                fillElements(data.get(), size, value);
+            }
+
             /**
              * @brief Reverses the order of elements in the array
              * 
              * Rearranges the elements so that the first element becomes the last,
-             * the second becomes the second-last, and so on.
+             * the second becomes the second-last, and so on. Works in place;
+             * trivially copyable elements of 1, 2, 4 or 8 bytes are reversed
+             * 32 bytes at a time with vector shuffles.
              * 
-             * @complexity O(n)
+             * @complexity O(n), no allocation
              */
             void reverse() {
-                auto newData = std::make_unique<T[]>(size);
-                for (size_t i = 0; i < size; i++) {
-                    newData[i] = data[size - i - 1];
+                reverse(0, size);
+            }
+
+            /**
+             * @brief Reverses the order of the elements in [from, to) in place
+             *
+             * @param from Index of the first element of the range
+             * @param to Index past the last element of the range
+             * @throws std::out_of_range if from > to or to > size
+             *
+             * @complexity O(to - from), no allocation
+             */
+            void reverse(size_t from, size_t to) {
+                if (from > to || to > size) {
+                    throw std::out_of_range("Index out of range");
                 }
 
-                data = std::move(newData);
+                if constexpr (std::is_trivially_copyable_v<T> &&
+                              (sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8)) {
+                    detail::reverseElements(data.get() + from, sizeof(T), to - from);
+                } else {
+                    std::reverse(data.get() + from, data.get() + to);
+                }
+            }
+
+            /**
+             * @brief Rotates the elements left by k positions in place
+             *
+             * The element at index k becomes the first one and the first k
+             * elements move to the end; k is taken modulo the size. Done as
+             * three in-place reversals, so it gets the vectorized reverse().
+             *
+             * @param k Number of positions to rotate by
+             *
+             * @complexity O(n), no allocation
+             */
+            void rotate(size_t k) {
+                if (size == 0 || k % size == 0) {
+                    return;
+                }
+
+                k %= size;
+                reverse(0, k);
+                reverse(k, size);
+                reverse(0, size);
+            }
+
+            /**
+             * @brief Shuffles the elements in place (Fisher-Yates)
+             *
+             * Every permutation is equally likely, provided the generator is
+             * good. Any std::uniform_random_bit_generator works; FastRandom
+             * is the fastest choice since it draws bounded integers without
+             * division.
+             *
+             * Example usage:
+             * @code
+             * zen::corex::FastRandom random(2024);
+             * deck.shuffle(random);
+             * @endcode
+             *
+             * @param generator Random bit generator, advanced by n - 1 draws or more
+             *
+             * @complexity O(n), no allocation
+             */
+            template <std::uniform_random_bit_generator G>
+            void shuffle(G& generator) {
+                for (size_t i = size; i > 1; i--) {
+                    size_t j = detail::randomBelow(generator, i);
+
+                    if (j != i - 1) {
+                        std::swap(data[i - 1], data[j]);
+                    }
+                }
             }
 
             /**
@@ -475,5 +807,600 @@ namespace zen::corex {
 
                 return items;
             }
+
+            /**
+             * @brief Creates an array of the results of a function applied to each element
+             *
+             * @param function Callable taking const T& and returning the new element
+             * @return Array<R> Array of the same size; the output is allocated once
+             *
+             * @note Like every Array element type, the result type R must be
+             *       default constructible and move assignable: the output is
+             *       allocated with new R[] and each result is assigned into it.
+             *
+             * @complexity O(n)
+             */
+            template <typename F>
+            auto map(F&& function) const {
+                return map(Sequential(), std::forward<F>(function));
+            }
+
+            /**
+             * @brief map() under an execution policy
+             *
+             * @param policy Sequential() or Parallel(pool); with Parallel the
+             *        function is called concurrently and must be thread-safe
+             */
+            template <ExecutionPolicy P, typename F>
+            auto map(const P& policy, F&& function) const {
+                using R = std::decay_t<std::invoke_result_t<F&, const T&>>;
+
+                Array<R> result;
+                if (size == 0) {
+                    return result;
+                }
+
+                result.data = std::make_unique<R[]>(size);
+                result.size = size;
+
+                detail::forEachBlock(policy, size, detail::blockSize(policy, size), [&](size_t, size_t from, size_t to) {
+                    for (size_t i = from; i < to; i++) {
+                        result.data[i] = function(data[i]);
+                    }
+                });
+
+                return result;
+            }
+
+            /**
+             * @brief Creates an array of the elements matching a predicate, in order
+             *
+             * @param predicate Callable taking const T& and returning bool
+             *
+             * @complexity O(n)
+             */
+            template <typename F>
+            Array filter(F&& predicate) const {
+                return filter(Sequential(), std::forward<F>(predicate));
+            }
+
+            /**
+             * @brief filter() under an execution policy
+             *
+             * Each block first evaluates the predicate and counts its matches;
+             * a prefix sum of the counts gives every block its write offset in
+             * an output allocated once, and the blocks then copy their matches
+             * in parallel. The predicate is called once per element.
+             */
+            template <ExecutionPolicy P, typename F>
+            Array filter(const P& policy, F&& predicate) const {
+                Array result;
+                if (size == 0) {
+                    return result;
+                }
+
+                size_t block = detail::blockSize(policy, size);
+                std::vector<size_t> offsets((size + block - 1) / block + 1, 0);
+                std::unique_ptr<bool[]> matches = std::make_unique_for_overwrite<bool[]>(size);
+
+                detail::forEachBlock(policy, size, block, [&](size_t index, size_t from, size_t to) {
+                    size_t count = 0;
+
+                    for (size_t i = from; i < to; i++) {
+                        matches[i] = static_cast<bool>(predicate(data[i]));
+                        count += matches[i];
+                    }
+
+                    offsets[index + 1] = count;
+                });
+
+                for (size_t i = 1; i < offsets.size(); i++) {
+                    offsets[i] += offsets[i - 1];
+                }
+
+                if (offsets.back() == 0) {
+                    return result;
+                }
+
+                result.data = std::make_unique<T[]>(offsets.back());
+                result.size = offsets.back();
+
+                detail::forEachBlock(policy, size, block, [&](size_t index, size_t from, size_t to) {
+                    size_t position = offsets[index];
+
+                    for (size_t i = from; i < to; i++) {
+                        if (matches[i]) {
+                            result.data[position++] = data[i];
+                        }
+                    }
+                });
+
+                return result;
+            }
+
+            /**
+             * @brief Creates an array without adjacent duplicates
+             *
+             * Keeps the first element of every run of equal elements, like
+             * std::unique; on a sorted array the result has no duplicates at all.
+             *
+             * @complexity O(n)
+             */
+            Array unique() const {
+                return unique(Sequential());
+            }
+
+            /**
+             * @brief unique() under an execution policy
+             */
+            template <ExecutionPolicy P>
+            Array unique(const P& policy) const {
+                const T* elements = data.get();
+
+                return filter(policy, [elements](const T& element) {
+                    size_t index = &element - elements;
+                    return index == 0 || !(element == elements[index - 1]);
+                });
+            }
+
+            /**
+             * @brief Creates an array with the first occurrence of every value, in order
+             *
+             * Replaces the O(n^2) pattern of calling contains() on the result
+             * before every add(): each element is looked up once in a HashSet,
+             * so T must be usable as a HashSet key (see Hash and Equal).
+             *
+             * Example usage:
+             * @code
+             * zen::corex::Array<int> ids(std::vector<int>{3, 1, 3, 2, 1});
+             * auto once = ids.distinct();  // {3, 1, 2}
+             * @endcode
+             *
+             * @complexity O(n) expected
+             */
+            Array distinct() const {
+                return distinct(Sequential());
+            }
+
+            /**
+             * @brief distinct() under an execution policy
+             *
+             * With Parallel the elements are split by hash into one shard per
+             * worker. A first pass counts each shard's elements per block and
+             * a second one scatters their indices, in order, into one list per
+             * shard. Each shard then walks only its own list with its own
+             * HashSet, so it sees the first occurrence of each of its values
+             * first, no locking is needed and the total work stays O(n).
+             */
+            template <ExecutionPolicy P>
+            Array distinct(const P& policy) const {
+                if constexpr (std::is_same_v<P, Parallel>) {
+                    if (size > policy.getBlockSize(size)) {
+                        size_t shards = std::min<size_t>(policy.pool.getThreadCount(), 256);
+
+                        /* One shard needs no bucketing; a set grown on demand stays smaller than one reserved for size */
+                        if (shards == 1) {
+                            HashSet<T> seen;
+
+                            return filter(Sequential(), [&seen](const T& element) {
+                                return seen.add(element);
+                            });
+                        }
+
+                        size_t block = policy.getBlockSize(size);
+                        size_t blocks = (size + block - 1) / block;
+
+                        std::unique_ptr<uint8_t[]> shardOf = std::make_unique_for_overwrite<uint8_t[]>(size);
+                        std::unique_ptr<size_t[]> order = std::make_unique_for_overwrite<size_t[]>(size);
+                        std::unique_ptr<bool[]> first = std::make_unique_for_overwrite<bool[]>(size);
+
+                        /* offsets[shard * blocks + b] ends up as the start of block b's elements of that shard */
+                        std::vector<size_t> offsets(shards * blocks + 1, 0);
+
+                        detail::forEachBlock(policy, size, block, [&](size_t index, size_t from, size_t to) {
+                            std::vector<size_t> counts(shards, 0);
+
+                            for (size_t i = from; i < to; i++) {
+                                shardOf[i] = static_cast<uint8_t>(detail::mixHash(Hash<T>()(data[i])) % shards);
+                                counts[shardOf[i]]++;
+                            }
+
+                            for (size_t shard = 0; shard < shards; shard++) {
+                                offsets[shard * blocks + index + 1] = counts[shard];
+                            }
+                        });
+
+                        for (size_t i = 1; i < offsets.size(); i++) {
+                            offsets[i] += offsets[i - 1];
+                        }
+
+                        detail::forEachBlock(policy, size, block, [&](size_t index, size_t from, size_t to) {
+                            std::vector<size_t> positions(shards);
+
+                            for (size_t shard = 0; shard < shards; shard++) {
+                                positions[shard] = offsets[shard * blocks + index];
+                            }
+
+                            for (size_t i = from; i < to; i++) {
+                                order[positions[shardOf[i]]++] = i;
+                            }
+                        });
+
+                        policy.pool.parallelFor(0, shards, [&](size_t shard) {
+                            size_t begin = offsets[shard * blocks];
+                            size_t end = offsets[(shard + 1) * blocks];
+
+                            HashSet<T> seen;
+
+                            for (size_t i = begin; i < end; i++) {
+                                first[order[i]] = seen.add(data[order[i]]);
+                            }
+                        }, 1);
+
+                        const T* elements = data.get();
+                        return filter(policy, [&first, elements](const T& element) {
+                            return first[&element - elements];
+                        });
+                    }
+                }
+
+                HashSet<T> seen;
+                seen.reserve(size);
+
+                return filter(Sequential(), [&seen](const T& element) {
+                    return seen.add(element);
+                });
+            }
+
+            /**
+             * @brief Creates a sorted array of the distinct values
+             *
+             * Sorts a copy and drops adjacent duplicates. Only needs operator<
+             * and operator==, and is often faster than distinct() when most
+             * values repeat rarely and the result is wanted sorted anyway.
+             *
+             * @complexity O(n log n)
+             */
+            Array distinctSorted() const {
+                return distinctSorted(Sequential());
+            }
+
+            /**
+             * @brief distinctSorted() under an execution policy
+             *
+             * With Parallel the copy is sorted in blocks that are merged in
+             * parallel rounds.
+             */
+            template <ExecutionPolicy P>
+            Array distinctSorted(const P& policy) const {
+                Array sorted;
+                sorted = *this;
+
+                detail::sort(policy, sorted.data.get(), sorted.size, std::less<T>());
+                return sorted.unique(policy);
+            }
+
+            /**
+             * @brief Combines all elements with a binary operation
+             *
+             * @param identity Starting value, returned for an empty array
+             * @param operation Callable taking (T, const T&) and returning T
+             *
+             * @complexity O(n)
+             */
+            template <typename F>
+            T reduce(T identity, F&& operation) const {
+                return reduce(Sequential(), std::move(identity), std::forward<F>(operation));
+            }
+
+            /**
+             * @brief reduce() under an execution policy
+             *
+             * With Parallel every block is reduced from identity and the block
+             * results are combined in order, so the operation must be
+             * associative and identity must be its neutral element.
+             */
+            template <ExecutionPolicy P, typename F>
+            T reduce(const P& policy, T identity, F&& operation) const {
+                if (size == 0) {
+                    return identity;
+                }
+
+                size_t block = detail::blockSize(policy, size);
+                size_t blocks = (size + block - 1) / block;
+
+                /* Not std::vector: its bool specialization packs the partials into shared words */
+                std::unique_ptr<T[]> partials = std::make_unique<T[]>(blocks);
+
+                detail::forEachBlock(policy, size, block, [&](size_t index, size_t from, size_t to) {
+                    T accumulator = identity;
+
+                    for (size_t i = from; i < to; i++) {
+                        accumulator = operation(std::move(accumulator), data[i]);
+                    }
+
+                    partials[index] = std::move(accumulator);
+                });
+
+                T result = std::move(partials[0]);
+                for (size_t i = 1; i < blocks; i++) {
+                    result = operation(std::move(result), partials[i]);
+                }
+
+                return result;
+            }
+
+            /**
+             * @brief Calls a function on every element; it may modify them
+             *
+             * @param function Callable taking T&
+             *
+             * @complexity O(n)
+             */
+            template <typename F>
+            void forEach(F&& function) {
+                forEach(Sequential(), std::forward<F>(function));
+            }
+
+            /**
+             * @brief forEach() under an execution policy
+             */
+            template <ExecutionPolicy P, typename F>
+            void forEach(const P& policy, F&& function) {
+                detail::forEachBlock(policy, size, detail::blockSize(policy, size), [&](size_t, size_t from, size_t to) {
+                    for (size_t i = from; i < to; i++) {
+                        function(data[i]);
+                    }
+                });
+            }
+
+            /**
+             * @brief Checks if at least one element matches a predicate
+             *
+             * @complexity O(n), stops at the first match
+             */
+            template <typename F>
+            bool anyOf(F&& predicate) const {
+                return anyOf(Sequential(), std::forward<F>(predicate));
+            }
+
+            /**
+             * @brief anyOf() under an execution policy
+             *
+             * With Parallel, blocks stop early once any block found a match.
+             */
+            template <ExecutionPolicy P, typename F>
+            bool anyOf(const P& policy, F&& predicate) const {
+                std::atomic<bool> found{false};
+
+                detail::forEachBlock(policy, size, detail::blockSize(policy, size), [&](size_t, size_t from, size_t to) {
+                    for (size_t i = from; i < to && !found.load(std::memory_order_relaxed); i++) {
+                        if (predicate(data[i])) {
+                            found.store(true, std::memory_order_relaxed);
+                        }
+                    }
+                });
+
+                return found.load(std::memory_order_relaxed);
+            }
+
+            /**
+             * @brief Checks if every element matches a predicate (true for an empty array)
+             *
+             * @complexity O(n), stops at the first mismatch
+             */
+            template <typename F>
+            bool allOf(F&& predicate) const {
+                return allOf(Sequential(), std::forward<F>(predicate));
+            }
+
+            /**
+             * @brief allOf() under an execution policy
+             */
+            template <ExecutionPolicy P, typename F>
+            bool allOf(const P& policy, F&& predicate) const {
+                return !anyOf(policy, [&predicate](const T& element) {
+                    return !predicate(element);
+                });
+            }
+
+            /**
+             * @brief Returns the sum of the elements
+             *
+             * Integers are summed in 64 bits, so an Array<int> cannot overflow
+             * on realistic sizes. double, float, int32_t and int64_t use AVX2
+             * when the CPU supports it.
+             *
+             * @param method Summation algorithm for floating-point elements; ignored for integers
+             * @return SumType<T> The sum, 0 for an empty array
+             *
+             * @complexity O(n)
+             */
+            SumType<T> sum(Summation method = Summation::Pairwise) const requires std::is_arithmetic_v<T> {
+                return detail::sum(data.get(), size, method);
+            }
+
+            /**
+             * @brief Returns the smallest element
+             *
+             * @throws std::out_of_range if the array is empty
+             *
+             * @complexity O(n)
+             */
+            T min() const requires std::is_arithmetic_v<T> {
+                return minmax().first;
+            }
+
+            /**
+             * @brief Returns the largest element
+             *
+             * @throws std::out_of_range if the array is empty
+             *
+             * @complexity O(n)
+             */
+            T max() const requires std::is_arithmetic_v<T> {
+                return minmax().second;
+            }
+
+            /**
+             * @brief Returns the smallest and the largest element in a single pass
+             *
+             * @throws std::out_of_range if the array is empty
+             * @note With NaN elements the result of the floating-point versions is unspecified
+             *
+             * @complexity O(n)
+             */
+            std::pair<T, T> minmax() const requires std::is_arithmetic_v<T> {
+                if (size == 0) {
+                    throw std::out_of_range("the array is empty");
+                }
+
+                T low, high;
+                detail::minMax(data.get(), size, low, high);
+
+                return {low, high};
+            }
+
+            /**
+             * @brief Returns the arithmetic mean of the elements (0 for an empty array)
+             *
+             * @complexity O(n)
+             */
+            double mean() const requires std::is_arithmetic_v<T> {
+                if (size == 0) {
+                    return 0;
+                }
+
+                return static_cast<double>(sum()) / static_cast<double>(size);
+            }
+
+            /**
+             * @brief Returns the population variance of the elements (0 for an empty array)
+             *
+             * Computed in two passes, the mean and then the squared deviations
+             * from it, which avoids the cancellation of the one-pass formula.
+             *
+             * @complexity O(n)
+             */
+            double variance() const requires std::is_arithmetic_v<T> {
+                if (size == 0) {
+                    return 0;
+                }
+
+                return detail::squaredDeviations(data.get(), size, mean()) / static_cast<double>(size);
+            }
+
+            /**
+             * @brief Counts the elements into equal-width bins over [lower, upper]
+             *
+             * Bin i covers [lower + i * width, lower + (i + 1) * width) and the
+             * last bin also includes upper. Elements outside the range (and
+             * NaN) are not counted.
+             *
+             * @param bins Number of bins
+             * @return Array<size_t> The count of every bin
+             * @throws std::invalid_argument if bins is 0 or lower is not below upper
+             *
+             * @complexity O(n + bins)
+             */
+            Array<size_t> histogram(size_t bins, double lower, double upper) const requires std::is_arithmetic_v<T> {
+                if (bins == 0 || !(lower < upper)) {
+                    throw std::invalid_argument("the histogram needs at least one bin and lower < upper");
+                }
+
+                Array<size_t> counts;
+                counts.data = std::make_unique<size_t[]>(bins);
+                counts.size = bins;
+
+                detail::histogram(data.get(), size, counts.data.get(), bins, lower, upper);
+                return counts;
+            }
+
+            /**
+             * @brief Writes the array to a compact binary file
+             *
+             * The file holds a 64-byte header (signature, element size,
+             * count, checksum) followed by the elements. Trivially copyable
+             * elements are written as raw bytes, so the file can be read back
+             * with load() or mapped without parsing by MappedArray<T>. An
+             * Array<String> is written as a string table (an offset per
+             * string, then the concatenated bytes) readable by load() and
+             * MappedStringTable.
+             *
+             * @param path File to create or overwrite
+             * @throws std::runtime_error if the file cannot be written
+             *
+             * @complexity O(n)
+             */
+            void save(const std::string& path) const {
+                static_assert(std::is_trivially_copyable_v<T> || std::is_same_v<T, String>,
+                              "only arrays of trivially copyable types or String can be saved");
+
+                detail::BinaryHeader header;
+                header.count = size;
+
+                if constexpr (std::is_same_v<T, String>) {
+                    header.kind = detail::BinaryKind::StringTable;
+
+                    std::vector<char> payload = detail::encodeStringTable(size, [this](size_t i) {
+                        return std::string_view(data[i].toCharArray(), data[i].getSize());
+                    });
+                    std::span<const char> parts[] = {payload};
+
+                    detail::writeBinary(path, header, parts);
+                } else {
+                    header.elementSize = sizeof(T);
+
+                    std::span<const char> parts[] = {{reinterpret_cast<const char*>(data.get()), size * sizeof(T)}};
+                    detail::writeBinary(path, header, parts);
+                }
+            }
+
+            /**
+             * @brief Reads an array written by save()
+             *
+             * @param path File written by save() for the same element type
+             * @return Array<T> The loaded array
+             * @throws std::runtime_error if the file cannot be read, was saved for
+             *         another element type or fails its checksum
+             *
+             * @complexity O(n), a single read and copy for trivially copyable types
+             */
+            static Array load(const std::string& path) {
+                static_assert(std::is_trivially_copyable_v<T> || std::is_same_v<T, String>,
+                              "only arrays of trivially copyable types or String can be loaded");
+
+                Array result;
+                detail::BinaryHeader header;
+
+                if constexpr (std::is_same_v<T, String>) {
+                    std::vector<char> payload = detail::readBinary(path, detail::BinaryKind::StringTable, header);
+                    const char* blob = payload.data() + (header.count + 1) * sizeof(uint64_t);
+
+                    result.data = std::make_unique<T[]>(header.count);
+                    result.size = header.count;
+
+                    for (size_t i = 0; i < header.count; i++) {
+                        uint64_t offsets[2];
+                        std::memcpy(offsets, payload.data() + i * sizeof(uint64_t), sizeof(offsets));
+
+                        result.data[i] = std::string(blob + offsets[0], offsets[1] - offsets[0]);
+                    }
+                } else {
+                    std::vector<char> payload = detail::readBinary(path, detail::BinaryKind::Array, header);
+
+                    if (header.elementSize != sizeof(T)) {
+                        throw std::runtime_error("Invalid binary file: " + path);
+                    }
+
+                    if (header.count > 0) {
+                        result.data = std::make_unique_for_overwrite<T[]>(header.count);
+                        result.size = header.count;
+                        std::memcpy(result.data.get(), payload.data(), payload.size());
+                    }
+                }
+
+                return result;
+            }
     };
-}
\ No newline at end of file
+}
@@ -0,0 +1,322 @@
+#include "BitArray.h"
+
+#include <algorithm>
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+namespace zen::corex {
+    namespace {
+        enum class Operation {
+            And,
+            Or,
+            Xor,
+            AndNot
+        };
+
+        template <Operation operation>
+        uint64_t combine(uint64_t left, uint64_t right) {
+            switch (operation) {
+                case Operation::And:
+                    return left & right;
+                case Operation::Or:
+                    return left | right;
+                case Operation::Xor:
+                    return left ^ right;
+                default:
+                    return left & ~right;
+            }
+        }
+
+        template <Operation operation>
+        void combineWords(uint64_t* target, const uint64_t* source, size_t count) {
+            size_t i = 0;
+
+#if defined(__AVX2__)
+            for (; i + 4 <= count; i += 4) {
+                __m256i left = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(target + i));
+                __m256i right = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(source + i));
+                __m256i result;
+
+                switch (operation) {
+                    case Operation::And:
+                        result = _mm256_and_si256(left, right);
+                        break;
+                    case Operation::Or:
+                        result = _mm256_or_si256(left, right);
+                        break;
+                    case Operation::Xor:
+                        result = _mm256_xor_si256(left, right);
+                        break;
+                    default:
+                        /* andnot computes ~first & second */
+                        result = _mm256_andnot_si256(right, left);
+                        break;
+                }
+
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(target + i), result);
+            }
+#elif defined(__SSE2__)
+            for (; i + 2 <= count; i += 2) {
+                __m128i left = _mm_loadu_si128(reinterpret_cast<const __m128i*>(target + i));
+                __m128i right = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i));
+                __m128i result;
+
+                switch (operation) {
+                    case Operation::And:
+                        result = _mm_and_si128(left, right);
+                        break;
+                    case Operation::Or:
+                        result = _mm_or_si128(left, right);
+                        break;
+                    case Operation::Xor:
+                        result = _mm_xor_si128(left, right);
+                        break;
+                    default:
+                        result = _mm_andnot_si128(right, left);
+                        break;
+                }
+
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(target + i), result);
+            }
+#endif
+
+            for (; i < count; i++) {
+                target[i] = combine<operation>(target[i], source[i]);
+            }
+        }
+
+        /* Index of the k-th set bit of a word that has more than k set bits */
+        unsigned selectInWord(uint64_t word, unsigned k) {
+#if defined(__BMI2__)
+            return std::countr_zero(_pdep_u64(uint64_t(1) << k, word));
+#else
+            for (unsigned i = 0; i < k; i++) {
+                word &= word - 1;
+            }
+
+            return std::countr_zero(word);
+#endif
+        }
+    }
+
+    BitArray::BitArray(size_t size, bool value) : words(wordCount(size), value ? ~uint64_t(0) : 0), size(size) {
+        clearTail();
+    }
+
+    void BitArray::clearTail() {
+        if (size % WORD_BITS != 0) {
+            words.back() &= (uint64_t(1) << (size % WORD_BITS)) - 1;
+        }
+    }
+
+    void BitArray::add(bool value) {
+        if (size % WORD_BITS == 0) {
+            words.push_back(0);
+        }
+
+        words.back() |= uint64_t(value) << (size % WORD_BITS);
+        size++;
+        directoryValid = false;
+    }
+
+    void BitArray::resize(size_t size, bool value) {
+        size_t oldSize = this->size;
+
+        if (value && size > oldSize && oldSize % WORD_BITS != 0) {
+            words.back() |= ~uint64_t(0) << (oldSize % WORD_BITS);
+        }
+
+        words.resize(wordCount(size), value ? ~uint64_t(0) : 0);
+        this->size = size;
+
+        clearTail();
+        directoryValid = false;
+    }
+
+    void BitArray::fill(bool value) {
+        std::fill(words.begin(), words.end(), value ? ~uint64_t(0) : 0);
+
+        clearTail();
+        directoryValid = false;
+    }
+
+    void BitArray::flipAll() {
+        for (uint64_t& word : words) {
+            word = ~word;
+        }
+
+        clearTail();
+        directoryValid = false;
+    }
+
+    void BitArray::clear() {
+        words.clear();
+        size = 0;
+        directoryValid = false;
+    }
+
+    size_t BitArray::count() const {
+        if (directoryValid) {
+            return directory.back();
+        }
+
+        size_t total = 0;
+        for (uint64_t word : words) {
+            total += std::popcount(word);
+        }
+
+        return total;
+    }
+
+    bool BitArray::any() const {
+        return std::any_of(words.begin(), words.end(), [](uint64_t word) {
+            return word != 0;
+        });
+    }
+
+    size_t BitArray::findNextSet(size_t from) const {
+        if (from >= size) {
+            return NOT_FOUND;
+        }
+
+        size_t index = from / WORD_BITS;
+        uint64_t word = words[index] & (~uint64_t(0) << (from % WORD_BITS));
+
+        while (word == 0) {
+            if (++index == words.size()) {
+                return NOT_FOUND;
+            }
+
+            word = words[index];
+        }
+
+        return index * WORD_BITS + std::countr_zero(word);
+    }
+
+    size_t BitArray::findNextUnset(size_t from) const {
+        if (from >= size) {
+            return NOT_FOUND;
+        }
+
+        size_t index = from / WORD_BITS;
+        uint64_t word = ~words[index] & (~uint64_t(0) << (from % WORD_BITS));
+
+        while (word == 0) {
+            if (++index == words.size()) {
+                return NOT_FOUND;
+            }
+
+            word = ~words[index];
+        }
+
+        /* The tail bits of the last word are zero, so the inverted word may point past the end */
+        size_t result = index * WORD_BITS + std::countr_zero(word);
+        return result < size ? result : NOT_FOUND;
+    }
+
+    void BitArray::buildIndex() {
+        if (directoryValid) {
+            return;
+        }
+
+        size_t blocks = (words.size() + BLOCK_WORDS - 1) / BLOCK_WORDS;
+        directory.assign(blocks + 1, 0);
+
+        uint64_t total = 0;
+        for (size_t block = 0; block < blocks; block++) {
+            directory[block] = total;
+
+            size_t end = std::min(words.size(), (block + 1) * BLOCK_WORDS);
+            for (size_t i = block * BLOCK_WORDS; i < end; i++) {
+                total += std::popcount(words[i]);
+            }
+        }
+
+        directory[blocks] = total;
+        directoryValid = true;
+    }
+
+    size_t BitArray::rank(size_t index) const {
+        if (index > size) {
+            throw std::out_of_range("Index out of range");
+        }
+
+        checkIndexBuilt();
+
+        size_t wordIndex = index / WORD_BITS;
+        size_t block = wordIndex / BLOCK_WORDS;
+
+        if (index == size) {
+            return directory.back();
+        }
+
+        size_t result = directory[block];
+        for (size_t i = block * BLOCK_WORDS; i < wordIndex; i++) {
+            result += std::popcount(words[i]);
+        }
+
+        uint64_t partial = words[wordIndex] & ((uint64_t(1) << (index % WORD_BITS)) - 1);
+        return result + std::popcount(partial);
+    }
+
+    size_t BitArray::select(size_t k) const {
+        checkIndexBuilt();
+
+        if (k >= directory.back()) {
+            return NOT_FOUND;
+        }
+
+        /* Last block whose count of preceding set bits is at most k */
+        size_t blocks = directory.size() - 1;
+        size_t block = std::upper_bound(directory.begin(), directory.begin() + blocks, k) - directory.begin() - 1;
+
+        size_t remaining = k - directory[block];
+        for (size_t i = block * BLOCK_WORDS;; i++) {
+            size_t bits = std::popcount(words[i]);
+
+            if (remaining < bits) {
+                return i * WORD_BITS + selectInWord(words[i], remaining);
+            }
+
+            remaining -= bits;
+        }
+    }
+
+    BitArray& BitArray::operator&=(const BitArray& other) {
+        checkSameSize(other);
+        combineWords<Operation::And>(words.data(), other.words.data(), words.size());
+        directoryValid = false;
+
+        return *this;
+    }
+
+    BitArray& BitArray::operator|=(const BitArray& other) {
+        checkSameSize(other);
+        combineWords<Operation::Or>(words.data(), other.words.data(), words.size());
+        directoryValid = false;
+
+        return *this;
+    }
+
+    BitArray& BitArray::operator^=(const BitArray& other) {
+        checkSameSize(other);
+        combineWords<Operation::Xor>(words.data(), other.words.data(), words.size());
+        directoryValid = false;
+
+        return *this;
+    }
+
+    BitArray& BitArray::andNot(const BitArray& other) {
+        checkSameSize(other);
+        combineWords<Operation::AndNot>(words.data(), other.words.data(), words.size());
+        directoryValid = false;
+
+        return *this;
+    }
+
+    bool BitArray::operator==(const BitArray& other) const {
+        return size == other.size && words == other.words;
+    }
+}
@@ -0,0 +1,317 @@
+#pragma once
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+namespace zen::corex {
+    /**
+     * @brief A packed array of bits with word-level bulk operations
+     *
+     * BitArray stores one bit per flag in 64-bit words, so a million flags
+     * take 125 KiB instead of the megabyte of an Array<bool>. Whole-array
+     * operations work on words (and on 128/256-bit vectors where the CPU
+     * supports them):
+     * - count() with popcount
+     * - findFirstSet() / findNextSet() skip 64 clear bits per step
+     * - &=, |=, ^= and andNot() combine two arrays
+     * - rank() and select() for succinct indexing, backed by a small
+     *   directory of cumulative counts (about 1.6% of the bits) that
+     *   buildIndex() computes
+     *
+     * Example usage:
+     * @code
+     * zen::corex::BitArray seen(1000000);
+     * seen.set(42);
+     * seen.set(4242);
+     *
+     * for (size_t i = seen.findFirstSet(); i != seen.NOT_FOUND; i = seen.findNextSet(i + 1)) {
+     *     cout << i << endl;   // 42, 4242
+     * }
+     *
+     * seen.buildIndex();
+     * size_t before = seen.rank(1000);   // 1 set bit before index 1000
+     * @endcode
+     *
+     * @note Every modification invalidates the directory, and rank() and
+     *       select() throw until buildIndex() is called again. They never
+     *       write, so any number of threads may query an indexed array
+     *       while nobody modifies it.
+     */
+    class BitArray {
+        private:
+            static constexpr size_t WORD_BITS = 64;
+            static constexpr size_t BLOCK_WORDS = 8;    ///< Words per rank directory entry (512 bits)
+
+            std::vector<uint64_t> words;    ///< Bits, least significant first; bits past size are zero
+            size_t size = 0;                ///< Number of bits
+
+            std::vector<uint64_t> directory;    ///< Set bits before each block, plus the total
+            bool directoryValid = false;
+
+            static size_t wordCount(size_t bits) {
+                return (bits + WORD_BITS - 1) / WORD_BITS;
+            }
+
+            void checkIndex(size_t index) const {
+                if (index >= size) {
+                    throw std::out_of_range("Index out of range");
+                }
+            }
+
+            void checkSameSize(const BitArray& other) const {
+                if (other.size != size) {
+                    throw std::invalid_argument("bit arrays have different sizes");
+                }
+            }
+
+            void clearTail();
+
+            void checkIndexBuilt() const {
+                if (!directoryValid) {
+                    throw std::logic_error("rank index is not built");
+                }
+            }
+
+        public:
+            /** @brief Returned by the search functions when no bit matches */
+            static constexpr size_t NOT_FOUND = static_cast<size_t>(-1);
+
+            /**
+             * @brief Constructs an empty bit array
+             */
+            BitArray() = default;
+
+            /**
+             * @brief Constructs a bit array of a given size
+             *
+             * @param size Number of bits
+             * @param value Initial value of every bit
+             *
+             * @complexity O(n / 64)
+             */
+            explicit BitArray(size_t size, bool value = false);
+
+            /**
+             * @brief Returns the value of a bit
+             *
+             * @throws std::out_of_range if index is greater than or equal to size
+             *
+             * @complexity O(1)
+             */
+            bool get(size_t index) const {
+                checkIndex(index);
+                return (words[index / WORD_BITS] >> (index % WORD_BITS)) & 1;
+            }
+
+            /**
+             * @brief Same as get()
+             */
+            bool operator[](size_t index) const {
+                return get(index);
+            }
+
+            /**
+             * @brief Sets a bit to a value
+             *
+             * @throws std::out_of_range if index is greater than or equal to size
+             *
+             * @complexity O(1)
+             */
+            void set(size_t index, bool value = true) {
+                checkIndex(index);
+
+                uint64_t mask = uint64_t(1) << (index % WORD_BITS);
+                uint64_t& word = words[index / WORD_BITS];
+
+                word = value ? word | mask : word & ~mask;
+                directoryValid = false;
+            }
+
+            /**
+             * @brief Clears a bit
+             *
+             * @throws std::out_of_range if index is greater than or equal to size
+             */
+            void reset(size_t index) {
+                set(index, false);
+            }
+
+            /**
+             * @brief Inverts a bit
+             *
+             * @throws std::out_of_range if index is greater than or equal to size
+             */
+            void flip(size_t index) {
+                checkIndex(index);
+
+                words[index / WORD_BITS] ^= uint64_t(1) << (index % WORD_BITS);
+                directoryValid = false;
+            }
+
+            /**
+             * @brief Appends a bit at the end
+             *
+             * @complexity O(1) amortized
+             */
+            void add(bool value);
+
+            /**
+             * @brief Changes the number of bits
+             *
+             * @param size New number of bits
+             * @param value Value of the added bits when growing
+             */
+            void resize(size_t size, bool value = false);
+
+            /**
+             * @brief Sets every bit to a value
+             *
+             * @complexity O(n / 64)
+             */
+            void fill(bool value);
+
+            /**
+             * @brief Inverts every bit
+             *
+             * @complexity O(n / 64)
+             */
+            void flipAll();
+
+            /**
+             * @brief Removes all bits
+             */
+            void clear();
+
+            /**
+             * @brief Counts the set bits
+             *
+             * @complexity O(n / 64), one popcount per word
+             */
+            size_t count() const;
+
+            /**
+             * @brief Checks if any bit is set
+             */
+            bool any() const;
+
+            /**
+             * @brief Returns the index of the first set bit, or NOT_FOUND
+             *
+             * @complexity O(n / 64) in the worst case
+             */
+            size_t findFirstSet() const {
+                return findNextSet(0);
+            }
+
+            /**
+             * @brief Returns the index of the first set bit at or after a position, or NOT_FOUND
+             *
+             * @param from First index to inspect; may be equal to or past the size
+             */
+            size_t findNextSet(size_t from) const;
+
+            /**
+             * @brief Returns the index of the first clear bit at or after a position, or NOT_FOUND
+             *
+             * @param from First index to inspect; may be equal to or past the size
+             */
+            size_t findNextUnset(size_t from) const;
+
+            /**
+             * @brief Builds the directory used by rank() and select()
+             *
+             * Must be called after the last modification and before the
+             * first query. Calling it again on an unchanged array is cheap.
+             *
+             * @complexity O(n / 64)
+             */
+            void buildIndex();
+
+            /**
+             * @brief Checks if rank() and select() can be used
+             */
+            bool isIndexBuilt() const {
+                return directoryValid;
+            }
+
+            /**
+             * @brief Counts the set bits before a position
+             *
+             * @param index Position, at most the size
+             * @return size_t Number of set bits in [0, index)
+             * @throws std::out_of_range if index is greater than size
+             * @throws std::logic_error if the array changed since the last buildIndex()
+             *
+             * @complexity O(1)
+             */
+            size_t rank(size_t index) const;
+
+            /**
+             * @brief Finds the position of the k-th set bit
+             *
+             * @param k Zero-based rank of the bit
+             * @return size_t Its index, or NOT_FOUND if fewer than k + 1 bits are set
+             * @throws std::logic_error if the array changed since the last buildIndex()
+             *
+             * @complexity O(log n)
+             */
+            size_t select(size_t k) const;
+
+            /**
+             * @brief Keeps only the bits that are also set in another array
+             *
+             * @throws std::invalid_argument if the sizes differ
+             */
+            BitArray& operator&=(const BitArray& other);
+
+            /**
+             * @brief Sets the bits that are set in another array
+             *
+             * @throws std::invalid_argument if the sizes differ
+             */
+            BitArray& operator|=(const BitArray& other);
+
+            /**
+             * @brief Inverts the bits that are set in another array
+             *
+             * @throws std::invalid_argument if the sizes differ
+             */
+            BitArray& operator^=(const BitArray& other);
+
+            /**
+             * @brief Clears the bits that are set in another array
+             *
+             * @throws std::invalid_argument if the sizes differ
+             */
+            BitArray& andNot(const BitArray& other);
+
+            /**
+             * @brief Checks if two arrays have the same size and bits
+             */
+            bool operator==(const BitArray& other) const;
+
+            /**
+             * @brief Checks if the array is empty
+             */
+            bool isEmpty() const {
+                return size == 0;
+            }
+
+            /**
+             * @brief Returns the number of bits
+             */
+            size_t getSize() const {
+                return size;
+            }
+
+            /**
+             * @brief Returns the underlying words, least significant bit first
+             */
+            const uint64_t* getWords() const {
+                return words.data();
+            }
+    };
+}
@@ -0,0 +1,359 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
+#include <utility>
+
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include "MpmcQueue.h"
+#include "SpscQueue.h"
+
+namespace zen::corex {
+    namespace detail {
+        /**
+         * @brief Futex-backed event count for sleeping on a lock-free condition
+         *
+         * A waiter registers with prepareWait(), re-checks its condition and
+         * then either calls cancelWait() or commitWait(). A notifier changes
+         * the condition and calls notifyAll(), which costs a fence and a load
+         * when nobody is waiting, so the lock-free fast paths stay cheap.
+         */
+        class EventCount {
+            private:
+                alignas(CACHE_LINE_SIZE) std::atomic<uint32_t> epoch{0};
+                std::atomic<uint32_t> waiters{0};
+
+            public:
+                /** @brief Registers the caller as a waiter and returns the key for commitWait() */
+                uint32_t prepareWait() {
+                    waiters.fetch_add(1, std::memory_order_seq_cst);
+                    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+                    return epoch.load(std::memory_order_acquire);
+                }
+
+                /** @brief Unregisters a waiter whose condition turned true */
+                void cancelWait() {
+                    waiters.fetch_sub(1, std::memory_order_relaxed);
+                }
+
+                /**
+                 * @brief Sleeps until notifyAll() is called after prepareWait()
+                 *
+                 * @param key Value returned by prepareWait()
+                 * @param timeout Relative timeout, nullptr to wait forever
+                 * @note May return spuriously; callers re-check their condition
+                 */
+                void commitWait(uint32_t key, const timespec* timeout = nullptr) {
+                    if (epoch.load(std::memory_order_acquire) == key) {
+                        syscall(SYS_futex, reinterpret_cast<uint32_t*>(&epoch), FUTEX_WAIT_PRIVATE, key, timeout, nullptr, 0);
+                    }
+
+                    waiters.fetch_sub(1, std::memory_order_relaxed);
+                }
+
+                /** @brief Wakes every registered waiter */
+                void notifyAll() {
+                    /* Pairs with the fence in prepareWait(): either we see the waiter or it sees our change */
+                    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+                    if (waiters.load(std::memory_order_relaxed) > 0) {
+                        epoch.fetch_add(1, std::memory_order_release);
+                        syscall(SYS_futex, reinterpret_cast<uint32_t*>(&epoch), FUTEX_WAKE_PRIVATE, INT_MAX, nullptr, nullptr, 0);
+                    }
+                }
+        };
+    }
+
+    /**
+     * @brief Blocking adapter over SpscQueue or MpmcQueue
+     *
+     * @tparam T The type of elements stored in the queue
+     * @tparam Queue The lock-free queue template to wrap
+     *
+     * push() and pop() use the lock-free queue directly and only fall back
+     * to sleeping on a futex when the queue is full or empty; a short spin
+     * comes first, since the other side is usually just about to act.
+     * close() wakes everybody: pushes then fail and pops drain what is left.
+     *
+     * Example usage:
+     * @code
+     * zen::corex::BlockingQueue<Line> lines(4096);
+     *
+     * std::thread parser([&] {
+     *     Line line;
+     *     while (lines.pop(line)) {
+     *         parse(line);
+     *     }
+     * });
+     *
+     * lines.push(readLine());
+     * lines.close();
+     * parser.join();
+     * @endcode
+     *
+     * @note With Queue = SpscQueue the single-producer single-consumer rule
+     *       of SpscQueue still applies.
+     */
+    template <typename T, template <typename> class Queue = MpmcQueue>
+    class BlockingQueue {
+        private:
+            static constexpr int SPIN_LIMIT = 128;
+
+            Queue<T> queue;
+            detail::EventCount notEmpty;
+            detail::EventCount notFull;
+            std::atomic<bool> closed{false};
+
+            static timespec toTimespec(std::chrono::nanoseconds duration) {
+                if (duration.count() < 0) {
+                    duration = std::chrono::nanoseconds(0);
+                }
+
+                timespec result;
+                result.tv_sec = static_cast<time_t>(duration.count() / 1000000000);
+                result.tv_nsec = static_cast<long>(duration.count() % 1000000000);
+
+                return result;
+            }
+
+            /* Spins, then sleeps on event until attempt() succeeds, the queue closes or the deadline passes */
+            template <typename A>
+            bool waitUntil(detail::EventCount& event, A&& attempt, const std::chrono::steady_clock::time_point* deadline) {
+                for (int spins = 0; spins < SPIN_LIMIT; spins++) {
+                    if (attempt()) {
+                        return true;
+                    }
+
+                    if (closed.load(std::memory_order_acquire)) {
+                        return attempt();
+                    }
+                }
+
+                while (true) {
+                    uint32_t key = event.prepareWait();
+
+                    if (attempt()) {
+                        event.cancelWait();
+                        return true;
+                    }
+
+                    if (closed.load(std::memory_order_acquire)) {
+                        event.cancelWait();
+                        return attempt();
+                    }
+
+                    if (deadline) {
+                        auto remaining = *deadline - std::chrono::steady_clock::now();
+                        if (remaining <= std::chrono::steady_clock::duration::zero()) {
+                            event.cancelWait();
+                            return false;
+                        }
+
+                        timespec timeout = toTimespec(remaining);
+                        event.commitWait(key, &timeout);
+                    } else {
+                        event.commitWait(key);
+                    }
+                }
+            }
+
+        public:
+            /**
+             * @brief Constructs an open, empty queue
+             *
+             * @param capacity Maximum number of queued elements, rounded up to a power of two
+             * @throws std::invalid_argument if capacity is 0
+             */
+            explicit BlockingQueue(size_t capacity) : queue(capacity) {}
+
+            BlockingQueue(const BlockingQueue&) = delete;
+
+            BlockingQueue& operator=(const BlockingQueue&) = delete;
+
+            /**
+             * @brief Queues an element, waiting while the queue is full
+             *
+             * @param input Element to queue
+             * @return false If the queue was closed; input is left untouched
+             */
+            bool push(T input) {
+                if (closed.load(std::memory_order_acquire)) {
+                    return false;
+                }
+
+                bool pushed = waitUntil(notFull, [&] {
+                    return !closed.load(std::memory_order_relaxed) && queue.tryPush(std::move(input));
+                }, nullptr);
+
+                if (pushed) {
+                    notEmpty.notifyAll();
+                }
+
+                return pushed;
+            }
+
+            /**
+             * @brief Queues an element without waiting
+             *
+             * @return false If the queue is full or closed
+             */
+            bool tryPush(T input) {
+                if (closed.load(std::memory_order_acquire) || !queue.tryPush(std::move(input))) {
+                    return false;
+                }
+
+                notEmpty.notifyAll();
+                return true;
+            }
+
+            /**
+             * @brief Queues count elements, waiting for room as needed
+             *
+             * @param items Elements to queue
+             * @param count Number of elements in items
+             * @return Number of elements queued; less than count only if the queue was closed
+             */
+            size_t pushBatch(const T* items, size_t count) {
+                size_t pushed = 0;
+
+                while (pushed < count) {
+                    bool progressed = waitUntil(notFull, [&] {
+                        if (closed.load(std::memory_order_relaxed)) {
+                            return false;
+                        }
+
+                        size_t added = queue.tryPushBatch(items + pushed, count - pushed);
+                        pushed += added;
+
+                        return added > 0;
+                    }, nullptr);
+
+                    if (!progressed) {
+                        break;
+                    }
+
+                    notEmpty.notifyAll();
+                }
+
+                return pushed;
+            }
+
+            /**
+             * @brief Takes the element at the front, waiting while the queue is empty
+             *
+             * @param output Receives the element
+             * @return false If the queue is closed and drained
+             */
+            bool pop(T& output) {
+                bool popped = waitUntil(notEmpty, [&] {
+                    return queue.tryPop(output);
+                }, nullptr);
+
+                if (popped) {
+                    notFull.notifyAll();
+                }
+
+                return popped;
+            }
+
+            /**
+             * @brief Takes the element at the front, waiting at most a given time
+             *
+             * @param output Receives the element
+             * @param timeout Maximum time to wait
+             * @return false If the wait timed out, or the queue is closed and drained
+             */
+            template <typename Rep, typename Period>
+            bool popFor(T& output, std::chrono::duration<Rep, Period> timeout) {
+                auto deadline = std::chrono::steady_clock::now() + timeout;
+
+                bool popped = waitUntil(notEmpty, [&] {
+                    return queue.tryPop(output);
+                }, &deadline);
+
+                if (popped) {
+                    notFull.notifyAll();
+                }
+
+                return popped;
+            }
+
+            /**
+             * @brief Takes the element at the front without waiting
+             *
+             * @return false If the queue is empty
+             */
+            bool tryPop(T& output) {
+                if (!queue.tryPop(output)) {
+                    return false;
+                }
+
+                notFull.notifyAll();
+                return true;
+            }
+
+            /**
+             * @brief Takes up to count elements, waiting until at least one is available
+             *
+             * @param output Destination for the elements
+             * @param count Maximum number of elements to take
+             * @return Number of elements taken; 0 only if the queue is closed and drained
+             */
+            size_t popBatch(T* output, size_t count) {
+                size_t popped = 0;
+
+                waitUntil(notEmpty, [&] {
+                    popped = queue.tryPopBatch(output, count);
+                    return popped > 0;
+                }, nullptr);
+
+                if (popped > 0) {
+                    notFull.notifyAll();
+                }
+
+                return popped;
+            }
+
+            /**
+             * @brief Closes the queue and wakes every waiting thread
+             *
+             * Later pushes fail; pops keep returning the queued elements and
+             * fail once the queue is drained.
+             */
+            void close() {
+                closed.store(true, std::memory_order_release);
+
+                notEmpty.notifyAll();
+                notFull.notifyAll();
+            }
+
+            /**
+             * @brief Checks if close() was called
+             */
+            bool isClosed() const {
+                return closed.load(std::memory_order_acquire);
+            }
+
+            /**
+             * @brief Returns the number of queued elements (snapshot)
+             */
+            size_t getSize() const {
+                return queue.getSize();
+            }
+
+            /**
+             * @brief Returns the maximum number of queued elements
+             */
+            size_t getCapacity() const {
+                return queue.getCapacity();
+            }
+    };
+}
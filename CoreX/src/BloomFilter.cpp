@@ -0,0 +1,50 @@
+#include "BloomFilter.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace zen::corex::detail {
+    double bloomFalsePositiveRate(double keysPerBlock) {
+        if (keysPerBlock <= 0) {
+            return 0;
+        }
+
+        /*
+         * The number of keys in a block follows a Poisson distribution. A
+         * block holding j keys answers yes for an absent key when all eight
+         * probed bits are set, each with probability 1 - (31/32)^j. The
+         * terms are computed in log space: exp(-keysPerBlock) alone underflows
+         * to zero past about 745 keys per block.
+         */
+        double rate = 0;
+        double logKeys = std::log(keysPerBlock);
+        double spread = 10 * std::sqrt(keysPerBlock) + 20;
+        size_t first = static_cast<size_t>(std::max(0.0, keysPerBlock - spread));
+        size_t last = static_cast<size_t>(keysPerBlock + spread);
+
+        for (size_t j = first; j <= last; j++) {
+            double count = static_cast<double>(j);
+            double probability = std::exp(count * logKeys - keysPerBlock - std::lgamma(count + 1));
+
+            rate += probability * std::pow(1 - std::pow(31.0 / 32.0, count), 8);
+        }
+
+        return std::min(rate, 1.0);
+    }
+
+    size_t bloomBlockCount(size_t expectedCount, double falsePositiveRate) {
+        if (!(falsePositiveRate > 0 && falsePositiveRate < 1)) {
+            throw std::invalid_argument("false positive rate must be between 0 and 1");
+        }
+
+        /* Start from the size of a classic Bloom filter and grow until the blocked layout meets the rate */
+        double bits = -static_cast<double>(expectedCount) * std::log(falsePositiveRate) / (std::log(2.0) * std::log(2.0));
+        size_t blocks = std::max<size_t>(1, static_cast<size_t>(bits / 256));
+
+        while (expectedCount > 0 && bloomFalsePositiveRate(static_cast<double>(expectedCount) / blocks) > falsePositiveRate) {
+            blocks += blocks / 16 + 1;
+        }
+
+        return blocks;
+    }
+}
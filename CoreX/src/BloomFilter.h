@@ -0,0 +1,310 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+#include "FilterFile.h"
+#include "HashTable.h"
+
+namespace zen::corex {
+    namespace detail {
+        /**
+         * @brief Number of 256-bit blocks that keep a blocked Bloom filter under a false positive rate
+         *
+         * @throws std::invalid_argument if the rate is not in (0, 1)
+         */
+        size_t bloomBlockCount(size_t expectedCount, double falsePositiveRate);
+
+        /**
+         * @brief Expected false positive rate of a blocked Bloom filter
+         *
+         * @param keysPerBlock Average number of keys per 256-bit block
+         */
+        double bloomFalsePositiveRate(double keysPerBlock);
+    }
+
+    /**
+     * @brief A blocked Bloom filter for fast "definitely absent" checks
+     *
+     * @tparam T The key type
+     * @tparam H Hash function (defaults to zen::corex::Hash<T>)
+     *
+     * The filter is split into 256-bit blocks. A key picks one block with
+     * the high half of its hash and sets one bit in each of the block's
+     * eight 32-bit words, so every lookup touches a single cache line
+     * instead of k random ones. The eight bit positions are derived from
+     * the low half of the hash with eight odd multipliers; with AVX2 the
+     * whole block is probed with one multiply, one shift and one test.
+     * It offers:
+     * - contains() that never returns false for an added key
+     * - Batched addAll() / containsAll() that hash first and prefetch the
+     *   blocks, hiding memory latency on large filters
+     * - merge() of two filters of the same size
+     * - save() / load() to a compact binary file
+     *
+     * Example usage:
+     * @code
+     * zen::corex::BloomFilter<std::string> words(100000, 0.01);
+     * words.add("hello");
+     *
+     * if (!words.contains(word)) {
+     *     return;   // skip the expensive search
+     * }
+     * @endcode
+     *
+     * @note Keys cannot be removed; use CuckooFilter for that.
+     */
+    template <typename T, typename H = Hash<T>>
+    class BloomFilter {
+        private:
+            static constexpr size_t BATCH = 16;     ///< Keys hashed and prefetched together
+
+            struct alignas(32) Block {
+                uint32_t words[8];
+            };
+
+            std::vector<Block> blocks;
+            size_t count = 0;       ///< Number of add() calls
+            H hasher;
+
+            static constexpr uint32_t SALTS[8] = {
+                0x47b6137bu, 0x44974d91u, 0x8824ad5bu, 0xa2b7289du,
+                0x705495c7u, 0x2df1424bu, 0x9efc4947u, 0x5c6bfb31u
+            };
+
+            template <typename Q>
+            uint64_t hashOf(const Q& key) const {
+                return detail::mixHash(hasher(key));
+            }
+
+            Block& blockOf(uint64_t hash) {
+                /* Multiply-shift maps the high half onto [0, blocks) without a division */
+                return blocks[((hash >> 32) * blocks.size()) >> 32];
+            }
+
+            const Block& blockOf(uint64_t hash) const {
+                return blocks[((hash >> 32) * blocks.size()) >> 32];
+            }
+
+            static void insert(Block& block, uint32_t hash) {
+#ifdef __AVX2__
+                __m256i* words = reinterpret_cast<__m256i*>(block.words);
+                _mm256_store_si256(words, _mm256_or_si256(_mm256_load_si256(words), mask(hash)));
+#else
+                for (size_t i = 0; i < 8; i++) {
+                    block.words[i] |= uint32_t(1) << ((hash * SALTS[i]) >> 27);
+                }
+#endif
+            }
+
+            static bool test(const Block& block, uint32_t hash) {
+#ifdef __AVX2__
+                /* testc is 1 when every bit of the mask is set in the block */
+                return _mm256_testc_si256(_mm256_load_si256(reinterpret_cast<const __m256i*>(block.words)), mask(hash));
+#else
+                for (size_t i = 0; i < 8; i++) {
+                    if (!(block.words[i] & (uint32_t(1) << ((hash * SALTS[i]) >> 27)))) {
+                        return false;
+                    }
+                }
+
+                return true;
+#endif
+            }
+
+#ifdef __AVX2__
+            static __m256i mask(uint32_t hash) {
+                __m256i salts = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(SALTS));
+                __m256i positions = _mm256_srli_epi32(_mm256_mullo_epi32(_mm256_set1_epi32(hash), salts), 27);
+
+                return _mm256_sllv_epi32(_mm256_set1_epi32(1), positions);
+            }
+#endif
+
+        public:
+            /**
+             * @brief Constructs a filter sized for a number of keys and an error rate
+             *
+             * @param expectedCount Number of keys the filter is meant to hold
+             * @param falsePositiveRate Wanted probability that contains() is true for an absent key
+             * @throws std::invalid_argument if the rate is not in (0, 1)
+             */
+            explicit BloomFilter(size_t expectedCount = 1024, double falsePositiveRate = 0.01)
+                : blocks(detail::bloomBlockCount(expectedCount, falsePositiveRate)) {}
+
+            /**
+             * @brief Adds a key
+             *
+             * @complexity O(1), one cache line written
+             */
+            template <typename Q = T>
+            void add(const Q& key) {
+                uint64_t hash = hashOf(key);
+
+                insert(blockOf(hash), static_cast<uint32_t>(hash));
+                count++;
+            }
+
+            /**
+             * @brief Checks if a key may have been added
+             *
+             * @return false If the key was certainly never added
+             * @return true If the key was probably added
+             *
+             * @complexity O(1), one cache line read
+             */
+            template <typename Q = T>
+            bool contains(const Q& key) const {
+                uint64_t hash = hashOf(key);
+                return test(blockOf(hash), static_cast<uint32_t>(hash));
+            }
+
+            /**
+             * @brief Adds many keys, hashing and prefetching them in batches
+             *
+             * @param keys Keys to add
+             * @param size Number of keys
+             */
+            void addAll(const T* keys, size_t size) {
+                uint64_t hashes[BATCH];
+
+                for (size_t start = 0; start < size; start += BATCH) {
+                    size_t batch = std::min(BATCH, size - start);
+
+                    for (size_t i = 0; i < batch; i++) {
+                        hashes[i] = hashOf(keys[start + i]);
+                        __builtin_prefetch(&blockOf(hashes[i]), 1);
+                    }
+
+                    for (size_t i = 0; i < batch; i++) {
+                        insert(blockOf(hashes[i]), static_cast<uint32_t>(hashes[i]));
+                    }
+                }
+
+                count += size;
+            }
+
+            /**
+             * @brief Checks many keys, hashing and prefetching them in batches
+             *
+             * @param keys Keys to check
+             * @param size Number of keys
+             * @param results Receives contains(keys[i]) at index i
+             * @return size_t Number of keys that may be present
+             */
+            size_t containsAll(const T* keys, size_t size, bool* results) const {
+                uint64_t hashes[BATCH];
+                size_t found = 0;
+
+                for (size_t start = 0; start < size; start += BATCH) {
+                    size_t batch = std::min(BATCH, size - start);
+
+                    for (size_t i = 0; i < batch; i++) {
+                        hashes[i] = hashOf(keys[start + i]);
+                        __builtin_prefetch(&blockOf(hashes[i]));
+                    }
+
+                    for (size_t i = 0; i < batch; i++) {
+                        results[start + i] = test(blockOf(hashes[i]), static_cast<uint32_t>(hashes[i]));
+                        found += results[start + i];
+                    }
+                }
+
+                return found;
+            }
+
+            /**
+             * @brief Adds every key of another filter
+             *
+             * @throws std::invalid_argument if the filters have different sizes
+             *
+             * @complexity O(m / 256) for m bits
+             */
+            void merge(const BloomFilter& other) {
+                if (other.blocks.size() != blocks.size()) {
+                    throw std::invalid_argument("filters have different sizes");
+                }
+
+                for (size_t i = 0; i < blocks.size(); i++) {
+                    for (size_t j = 0; j < 8; j++) {
+                        blocks[i].words[j] |= other.blocks[i].words[j];
+                    }
+                }
+
+                count += other.count;
+            }
+
+            /**
+             * @brief Removes all keys
+             */
+            void clear() {
+                std::fill(blocks.begin(), blocks.end(), Block{});
+                count = 0;
+            }
+
+            /**
+             * @brief Returns the number of add() calls since the last clear()
+             */
+            size_t getCount() const {
+                return count;
+            }
+
+            /**
+             * @brief Returns the size of the bit array in bytes
+             */
+            size_t getMemoryUsage() const {
+                return blocks.size() * sizeof(Block);
+            }
+
+            /**
+             * @brief Estimates the false positive rate for the keys added so far
+             *
+             * Assumes the added keys are distinct.
+             */
+            double getFalsePositiveRate() const {
+                return detail::bloomFalsePositiveRate(static_cast<double>(count) / blocks.size());
+            }
+
+            /**
+             * @brief Writes the filter to a binary file
+             *
+             * @throws std::runtime_error if the file cannot be written
+             */
+            void save(const std::string& path) const {
+                uint64_t header[2] = {blocks.size(), count};
+                detail::saveFilter(path, detail::BLOOM_MAGIC, header, 2, blocks.data(), getMemoryUsage());
+            }
+
+            /**
+             * @brief Reads a filter written by save()
+             *
+             * The hash function must be the same as when the file was saved.
+             *
+             * @throws std::runtime_error if the file cannot be read or is not a Bloom filter
+             */
+            static BloomFilter load(const std::string& path) {
+                uint64_t header[2];
+                std::vector<char> data = detail::loadFilter(path, detail::BLOOM_MAGIC, header, 2);
+
+                if (header[0] == 0 || data.size() != header[0] * sizeof(Block)) {
+                    throw std::runtime_error("Invalid filter file: " + path);
+                }
+
+                BloomFilter filter(0);
+                filter.blocks.resize(header[0]);
+                filter.count = header[1];
+                std::memcpy(filter.blocks.data(), data.data(), data.size());
+
+                return filter;
+            }
+    };
+}
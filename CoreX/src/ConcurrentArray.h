@@ -0,0 +1,316 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace zen::corex {
+    /**
+     * @brief An append-only array that many threads can add to without locks
+     *
+     * @tparam T The type of elements stored in the array
+     *
+     * add() reserves a slot with a single atomic increment, constructs the
+     * element in place and marks it ready. No lock is taken, but the add is
+     * lock-free rather than wait-free: publishing the prefix is a CAS loop
+     * in which writers help each other along. Storage is a fixed directory
+     * of chunks that double in size (64, 128, 256, ... elements), allocated
+     * on first use, so elements never move and the directory itself never
+     * needs to grow.
+     *
+     * Readers see the published prefix: getSize() returns n such that the
+     * first n elements are fully constructed and visible, even while other
+     * threads are still adding. A slot that is reserved but not yet
+     * constructed holds back the prefix until its writer finishes; whichever
+     * writer completes the gap advances it past every ready slot behind it.
+     * It offers:
+     * - Lock-free add() and emplace() from any number of threads
+     * - Safe concurrent reads of the published elements
+     * - Stable references: an element never moves once added
+     *
+     * Example usage:
+     * @code
+     * zen::corex::ConcurrentArray<Result> results;
+     *
+     * pool.parallelFor(0, jobs.size(), [&](size_t i) {
+     *     results.add(run(jobs[i]));
+     * });
+     *
+     * for (size_t i = 0; i < results.getSize(); i++) {
+     *     report(results[i]);
+     * }
+     * @endcode
+     *
+     * @note The order of the elements is the order in which their slots were
+     *       reserved. clear() and destruction must not run concurrently with
+     *       any other call.
+     *
+     * @note A reserved slot must always be filled, otherwise the prefix stops
+     *       growing for good. When constructing T from the given arguments
+     *       may throw, emplace() builds the element before reserving a slot
+     *       and moves it in, so T must be nothrow move constructible.
+     */
+    template <typename T>
+    class ConcurrentArray {
+        private:
+            static constexpr size_t FIRST_SHIFT = 6;                    ///< The first chunk holds 64 elements
+            static constexpr size_t CHUNK_COUNT = 64 - FIRST_SHIFT;     ///< Enough chunks for any size_t index
+
+            struct Chunk {
+                T* data;
+                std::unique_ptr<std::atomic<bool>[]> ready;     ///< Set once the element is constructed
+            };
+
+            std::atomic<Chunk*> chunks[CHUNK_COUNT] = {};
+            alignas(64) std::atomic<size_t> reserved{0};      ///< Slots handed out to writers
+            alignas(64) std::atomic<size_t> published{0};     ///< Length of the fully constructed prefix
+
+            static size_t chunkOf(size_t index) {
+                return std::bit_width(index + (size_t(1) << FIRST_SHIFT)) - 1 - FIRST_SHIFT;
+            }
+
+            static size_t chunkCapacity(size_t chunk) {
+                return size_t(1) << (chunk + FIRST_SHIFT);
+            }
+
+            static size_t offsetOf(size_t index, size_t chunk) {
+                return index + (size_t(1) << FIRST_SHIFT) - chunkCapacity(chunk);
+            }
+
+            Chunk* acquireChunk(size_t chunk) {
+                Chunk* current = chunks[chunk].load(std::memory_order_acquire);
+                if (current) {
+                    return current;
+                }
+
+                size_t capacity = chunkCapacity(chunk);
+                auto* fresh = new Chunk{std::allocator<T>().allocate(capacity), std::make_unique<std::atomic<bool>[]>(capacity)};
+
+                /* Several writers may race to create the same chunk; the loser frees its copy */
+                if (chunks[chunk].compare_exchange_strong(current, fresh, std::memory_order_acq_rel, std::memory_order_acquire)) {
+                    return fresh;
+                }
+
+                std::allocator<T>().deallocate(fresh->data, capacity);
+                delete fresh;
+
+                return current;
+            }
+
+            bool isReady(size_t index) const {
+                size_t chunk = chunkOf(index);
+                Chunk* current = chunks[chunk].load(std::memory_order_acquire);
+
+                return current && current->ready[offsetOf(index, chunk)].load(std::memory_order_seq_cst);
+            }
+
+            void publish() {
+                size_t prefix = published.load(std::memory_order_seq_cst);
+
+                while (isReady(prefix)) {
+                    /* On failure prefix is reloaded: another writer moved it, keep going from there */
+                    if (published.compare_exchange_weak(prefix, prefix + 1, std::memory_order_seq_cst)) {
+                        prefix++;
+                    }
+                }
+            }
+
+            template <typename... Args>
+            size_t place(Args&&... args) {
+                static_assert(std::is_nothrow_constructible_v<T, Args...>, "a reserved slot must be filled without throwing");
+
+                size_t index = reserved.fetch_add(1, std::memory_order_relaxed);
+                size_t chunk = chunkOf(index);
+                Chunk* current = acquireChunk(chunk);
+                size_t offset = offsetOf(index, chunk);
+
+                new (&current->data[offset]) T(std::forward<Args>(args)...);
+                current->ready[offset].store(true, std::memory_order_seq_cst);
+
+                publish();
+                return index;
+            }
+
+            T& at(size_t index) const {
+                size_t chunk = chunkOf(index);
+                return chunks[chunk].load(std::memory_order_acquire)->data[offsetOf(index, chunk)];
+            }
+
+        public:
+            /**
+             * @brief Constructs an empty array; chunks are allocated on first use
+             */
+            ConcurrentArray() = default;
+
+            ConcurrentArray(const ConcurrentArray&) = delete;
+
+            ConcurrentArray& operator=(const ConcurrentArray&) = delete;
+
+            ~ConcurrentArray() {
+                clear();
+
+                for (size_t chunk = 0; chunk < CHUNK_COUNT; chunk++) {
+                    Chunk* current = chunks[chunk].load(std::memory_order_relaxed);
+
+                    if (current) {
+                        std::allocator<T>().deallocate(current->data, chunkCapacity(chunk));
+                        delete current;
+                    }
+                }
+            }
+
+            /**
+             * @brief Adds an element; safe to call from many threads at once
+             *
+             * @return size_t Index of the new element
+             *
+             * @complexity O(1), one atomic increment (plus one allocation per new chunk)
+             */
+            size_t add(const T& input) {
+                return emplace(input);
+            }
+
+            /**
+             * @brief Moves an element to the end; safe to call from many threads at once
+             *
+             * @return size_t Index of the new element
+             */
+            size_t add(T&& input) {
+                return emplace(std::move(input));
+            }
+
+            /**
+             * @brief Constructs an element in place; safe to call from many threads at once
+             *
+             * @return size_t Index of the new element. It is visible to readers
+             *         once every element before it is constructed too.
+             *
+             * If the constructor may throw, the element is built first and
+             * moved into its slot, so an exception leaves the array unchanged.
+             */
+            template <typename... Args>
+            size_t emplace(Args&&... args) {
+                if constexpr (std::is_nothrow_constructible_v<T, Args...>) {
+                    return place(std::forward<Args>(args)...);
+                } else {
+                    T element(std::forward<Args>(args)...);
+                    return place(std::move(element));
+                }
+            }
+
+            /**
+             * @brief Accesses a published element
+             *
+             * @throws std::out_of_range if index is not below getSize()
+             *
+             * @complexity O(1)
+             */
+            T& operator[](size_t index) {
+                if (index >= getSize()) {
+                    throw std::out_of_range("Index out of range");
+                }
+
+                return at(index);
+            }
+
+            /**
+             * @brief Const version of element access operator
+             *
+             * @throws std::out_of_range if index is not below getSize()
+             */
+            const T& operator[](size_t index) const {
+                if (index >= getSize()) {
+                    throw std::out_of_range("Index out of range");
+                }
+
+                return at(index);
+            }
+
+            /**
+             * @brief Calls function(element) for every element published when the call starts
+             *
+             * @complexity O(n)
+             */
+            template <typename F>
+            void forEach(F&& function) const {
+                size_t size = getSize();
+
+                for (size_t chunk = 0, first = 0; first < size; first += chunkCapacity(chunk), chunk++) {
+                    const T* data = chunks[chunk].load(std::memory_order_acquire)->data;
+                    size_t count = std::min(chunkCapacity(chunk), size - first);
+
+                    for (size_t i = 0; i < count; i++) {
+                        function(data[i]);
+                    }
+                }
+            }
+
+            /**
+             * @brief Removes all elements; the chunks are kept
+             *
+             * @note Must not run concurrently with any other call
+             */
+            void clear() {
+                size_t size = published.load(std::memory_order_acquire);
+
+                if constexpr (!std::is_trivially_destructible_v<T>) {
+                    for (size_t i = 0; i < size; i++) {
+                        std::destroy_at(&at(i));
+                    }
+                }
+
+                for (size_t chunk = 0; chunk < CHUNK_COUNT; chunk++) {
+                    Chunk* current = chunks[chunk].load(std::memory_order_relaxed);
+
+                    if (current) {
+                        for (size_t i = 0; i < chunkCapacity(chunk); i++) {
+                            current->ready[i].store(false, std::memory_order_relaxed);
+                        }
+                    }
+                }
+
+                reserved.store(0, std::memory_order_relaxed);
+                published.store(0, std::memory_order_release);
+            }
+
+            /**
+             * @brief Returns the number of published elements (snapshot)
+             *
+             * Elements [0, getSize()) are fully constructed and may be read
+             * while other threads keep adding.
+             */
+            size_t getSize() const {
+                return published.load(std::memory_order_acquire);
+            }
+
+            /**
+             * @brief Checks if no element is published
+             */
+            bool isEmpty() const {
+                return getSize() == 0;
+            }
+
+            /**
+             * @brief Copies the published elements into a std::vector
+             *
+             * @complexity O(n)
+             */
+            std::vector<T> toVector() const {
+                std::vector<T> result;
+                result.reserve(getSize());
+
+                forEach([&result](const T& element) {
+                    result.push_back(element);
+                });
+
+                return result;
+            }
+    };
+}
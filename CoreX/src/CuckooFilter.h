@@ -0,0 +1,361 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "FilterFile.h"
+#include "HashTable.h"
+
+namespace zen::corex {
+    /**
+     * @brief A cuckoo filter: an approximate set that supports removal
+     *
+     * @tparam T The key type
+     * @tparam H Hash function (defaults to zen::corex::Hash<T>)
+     *
+     * Each key is reduced to a 16-bit fingerprint stored in one of two
+     * candidate buckets of four slots. A bucket is a single 64-bit word, so
+     * a lookup reads at most two words and compares the four slots at once
+     * with bit tricks. When both buckets are full, resident fingerprints are
+     * moved to their alternate bucket (cuckoo hashing) to make room. It
+     * offers:
+     * - contains() that never returns false for an added key, with a false
+     *   positive rate below 0.02% at full load
+     * - remove() of previously added keys
+     * - Batched containsAll() that hashes first and prefetches the buckets
+     * - save() / load() to a compact binary file
+     *
+     * Example usage:
+     * @code
+     * zen::corex::CuckooFilter<uint64_t> sessions(1000000);
+     * sessions.add(id);
+     *
+     * if (sessions.contains(id)) {
+     *     sessions.remove(id);
+     * }
+     * @endcode
+     *
+     * @note Only remove keys that were added: removing an absent key that
+     *       collides with a stored fingerprint drops that fingerprint. A key
+     *       added twice is stored twice and must be removed twice.
+     */
+    template <typename T, typename H = Hash<T>>
+    class CuckooFilter {
+        private:
+            static constexpr size_t SLOTS = 4;              ///< Fingerprints per bucket
+            static constexpr size_t MAX_KICKS = 500;        ///< Relocations tried before add() gives up
+            static constexpr size_t BATCH = 16;             ///< Keys hashed and prefetched together
+            static constexpr uint64_t LOW_BITS = 0x0001000100010001ull;
+            static constexpr uint64_t HIGH_BITS = 0x8000800080008000ull;
+
+            struct Victim {
+                bool used = false;
+                size_t index = 0;
+                uint16_t fingerprint = 0;
+            };
+
+            std::vector<uint64_t> buckets;  ///< Four 16-bit slots per word, 0 marks an empty slot
+            size_t mask = 0;                ///< buckets.size() - 1, a power of two minus one
+            size_t count = 0;
+            Victim victim;                  ///< Fingerprint left over by a failed relocation
+            uint64_t random = 0x9E3779B97F4A7C15ull;
+            H hasher;
+
+            template <typename Q>
+            uint64_t hashOf(const Q& key) const {
+                return detail::mixHash(hasher(key));
+            }
+
+            static uint16_t fingerprintOf(uint64_t hash) {
+                uint16_t fingerprint = static_cast<uint16_t>(hash >> 48);
+                return fingerprint ? fingerprint : 1;
+            }
+
+            /* The alternate of the alternate is the original, so either bucket finds the other */
+            size_t alternate(size_t index, uint16_t fingerprint) const {
+                return (index ^ (fingerprint * 0x5bd1e995ull)) & mask;
+            }
+
+            /* Bit 15 of every slot equal to fingerprint is set; the lowest one is always exact */
+            static uint64_t match(uint64_t bucket, uint16_t fingerprint) {
+                uint64_t difference = bucket ^ (LOW_BITS * fingerprint);
+                return (difference - LOW_BITS) & ~difference & HIGH_BITS;
+            }
+
+            static size_t slotShift(uint64_t matches) {
+                return std::countr_zero(matches) - 15;
+            }
+
+            bool insertInto(size_t index, uint16_t fingerprint) {
+                uint64_t empty = match(buckets[index], 0);
+                if (!empty) {
+                    return false;
+                }
+
+                buckets[index] |= static_cast<uint64_t>(fingerprint) << slotShift(empty);
+                return true;
+            }
+
+            bool removeFrom(size_t index, uint16_t fingerprint) {
+                uint64_t found = match(buckets[index], fingerprint);
+                if (!found) {
+                    return false;
+                }
+
+                buckets[index] &= ~(uint64_t(0xFFFF) << slotShift(found));
+                return true;
+            }
+
+            uint64_t nextRandom() {
+                random ^= random << 13;
+                random ^= random >> 7;
+                random ^= random << 17;
+
+                return random;
+            }
+
+            void place(size_t index, uint16_t fingerprint) {
+                if (insertInto(index, fingerprint) || insertInto(alternate(index, fingerprint), fingerprint)) {
+                    return;
+                }
+
+                if (nextRandom() & 1) {
+                    index = alternate(index, fingerprint);
+                }
+
+                for (size_t kick = 0; kick < MAX_KICKS; kick++) {
+                    size_t shift = (nextRandom() % SLOTS) * 16;
+                    uint16_t evicted = static_cast<uint16_t>(buckets[index] >> shift);
+
+                    buckets[index] = (buckets[index] & ~(uint64_t(0xFFFF) << shift)) | (static_cast<uint64_t>(fingerprint) << shift);
+                    fingerprint = evicted;
+                    index = alternate(index, fingerprint);
+
+                    if (insertInto(index, fingerprint)) {
+                        return;
+                    }
+                }
+
+                /* Keep the homeless fingerprint so no added key is ever lost */
+                victim = {true, index, fingerprint};
+            }
+
+            bool test(uint64_t hash) const {
+                uint16_t fingerprint = fingerprintOf(hash);
+                size_t first = hash & mask;
+                size_t second = alternate(first, fingerprint);
+
+                if (match(buckets[first], fingerprint) | match(buckets[second], fingerprint)) {
+                    return true;
+                }
+
+                return victim.used && victim.fingerprint == fingerprint && (victim.index == first || victim.index == second);
+            }
+
+        public:
+            /**
+             * @brief Constructs a filter able to hold a number of keys
+             *
+             * @param capacity Number of keys; the table is sized for a 95% load
+             */
+            explicit CuckooFilter(size_t capacity = 1024) {
+                size_t wanted = static_cast<size_t>(static_cast<double>(capacity) / (SLOTS * 0.95)) + 1;
+
+                buckets.assign(std::bit_ceil(wanted), 0);
+                mask = buckets.size() - 1;
+            }
+
+            /**
+             * @brief Adds a key
+             *
+             * @return false If the filter is full; the key was not added
+             *
+             * @complexity O(1) amortized
+             */
+            template <typename Q = T>
+            bool add(const Q& key) {
+                if (victim.used) {
+                    return false;
+                }
+
+                uint64_t hash = hashOf(key);
+
+                place(hash & mask, fingerprintOf(hash));
+                count++;
+
+                return true;
+            }
+
+            /**
+             * @brief Checks if a key may have been added
+             *
+             * @return false If the key is certainly not in the filter
+             * @return true If the key is probably in the filter
+             *
+             * @complexity O(1), two words read
+             */
+            template <typename Q = T>
+            bool contains(const Q& key) const {
+                return test(hashOf(key));
+            }
+
+            /**
+             * @brief Checks many keys, hashing and prefetching them in batches
+             *
+             * @param keys Keys to check
+             * @param size Number of keys
+             * @param results Receives contains(keys[i]) at index i
+             * @return size_t Number of keys that may be present
+             */
+            size_t containsAll(const T* keys, size_t size, bool* results) const {
+                uint64_t hashes[BATCH];
+                size_t found = 0;
+
+                for (size_t start = 0; start < size; start += BATCH) {
+                    size_t batch = std::min(BATCH, size - start);
+
+                    for (size_t i = 0; i < batch; i++) {
+                        hashes[i] = hashOf(keys[start + i]);
+
+                        size_t first = hashes[i] & mask;
+                        __builtin_prefetch(&buckets[first]);
+                        __builtin_prefetch(&buckets[alternate(first, fingerprintOf(hashes[i]))]);
+                    }
+
+                    for (size_t i = 0; i < batch; i++) {
+                        results[start + i] = test(hashes[i]);
+                        found += results[start + i];
+                    }
+                }
+
+                return found;
+            }
+
+            /**
+             * @brief Removes a previously added key
+             *
+             * @return true If a matching fingerprint was removed
+             *
+             * @complexity O(1)
+             */
+            template <typename Q = T>
+            bool remove(const Q& key) {
+                uint64_t hash = hashOf(key);
+                uint16_t fingerprint = fingerprintOf(hash);
+                size_t first = hash & mask;
+                size_t second = alternate(first, fingerprint);
+
+                if (removeFrom(first, fingerprint) || removeFrom(second, fingerprint)) {
+                    count--;
+
+                    /* A slot was freed, so the leftover fingerprint may fit now */
+                    if (victim.used) {
+                        Victim homeless = victim;
+                        victim.used = false;
+                        place(homeless.index, homeless.fingerprint);
+                    }
+
+                    return true;
+                }
+
+                if (victim.used && victim.fingerprint == fingerprint && (victim.index == first || victim.index == second)) {
+                    victim.used = false;
+                    count--;
+
+                    return true;
+                }
+
+                return false;
+            }
+
+            /**
+             * @brief Removes all keys
+             */
+            void clear() {
+                std::fill(buckets.begin(), buckets.end(), 0);
+                victim.used = false;
+                count = 0;
+            }
+
+            /**
+             * @brief Returns the number of keys in the filter
+             */
+            size_t getCount() const {
+                return count;
+            }
+
+            /**
+             * @brief Returns the number of fingerprint slots
+             */
+            size_t getCapacity() const {
+                return buckets.size() * SLOTS;
+            }
+
+            /**
+             * @brief Returns the fraction of occupied slots
+             */
+            double getLoadFactor() const {
+                return static_cast<double>(count) / getCapacity();
+            }
+
+            /**
+             * @brief Returns the size of the table in bytes
+             */
+            size_t getMemoryUsage() const {
+                return buckets.size() * sizeof(uint64_t);
+            }
+
+            /**
+             * @brief Estimates the false positive rate at the current load
+             *
+             * An absent key is compared with the 8 slots of its two buckets,
+             * each holding a colliding fingerprint with probability 1/65535.
+             */
+            double getFalsePositiveRate() const {
+                return 1 - std::pow(1 - 1.0 / 65535, 2 * SLOTS * getLoadFactor());
+            }
+
+            /**
+             * @brief Writes the filter to a binary file
+             *
+             * @throws std::runtime_error if the file cannot be written
+             */
+            void save(const std::string& path) const {
+                uint64_t header[5] = {buckets.size(), count, victim.used, victim.index, victim.fingerprint};
+                detail::saveFilter(path, detail::CUCKOO_MAGIC, header, 5, buckets.data(), getMemoryUsage());
+            }
+
+            /**
+             * @brief Reads a filter written by save()
+             *
+             * The hash function must be the same as when the file was saved.
+             *
+             * @throws std::runtime_error if the file cannot be read or is not a cuckoo filter
+             */
+            static CuckooFilter load(const std::string& path) {
+                uint64_t header[5];
+                std::vector<char> data = detail::loadFilter(path, detail::CUCKOO_MAGIC, header, 5);
+
+                if (!std::has_single_bit(header[0]) || data.size() != header[0] * sizeof(uint64_t) ||
+                    header[3] >= header[0] || header[4] > 0xFFFF) {
+                    throw std::runtime_error("Invalid filter file: " + path);
+                }
+
+                CuckooFilter filter(0);
+                filter.buckets.resize(header[0]);
+                filter.mask = header[0] - 1;
+                filter.count = header[1];
+                filter.victim = {header[2] != 0, header[3], static_cast<uint16_t>(header[4])};
+                std::memcpy(filter.buckets.data(), data.data(), data.size());
+
+                return filter;
+            }
+    };
+}
@@ -0,0 +1,200 @@
+#include "DDSketch.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace zen::corex {
+    void DDSketch::Store::add(int index, uint64_t count, size_t maxBuckets) {
+        if (counts.empty()) {
+            counts.push_back(count);
+            offset = index;
+
+            return;
+        }
+
+        if (index < offset) {
+            if (collapsed) {
+                counts[0] += count;
+                return;
+            }
+
+            counts.insert(counts.begin(), offset - index, 0);
+            offset = index;
+        } else if (index >= offset + static_cast<int>(counts.size())) {
+            counts.resize(index - offset + 1, 0);
+        }
+
+        counts[index - offset] += count;
+
+        /* Fold the buckets closest to zero into one so the highest ones keep their accuracy */
+        if (counts.size() > maxBuckets) {
+            size_t excess = counts.size() - maxBuckets;
+
+            for (size_t i = 0; i < excess; i++) {
+                counts[excess] += counts[i];
+            }
+
+            counts.erase(counts.begin(), counts.begin() + excess);
+            offset += static_cast<int>(excess);
+            collapsed = true;
+        }
+    }
+
+    DDSketch::DDSketch(double relativeAccuracy, size_t maxBuckets)
+        : relativeAccuracy(relativeAccuracy), maxBuckets(maxBuckets) {
+        if (!(relativeAccuracy > 0 && relativeAccuracy < 1)) {
+            throw std::invalid_argument("relative accuracy must be between 0 and 1");
+        }
+
+        if (maxBuckets == 0) {
+            throw std::invalid_argument("maxBuckets must be positive");
+        }
+
+        logGamma = std::log((1 + relativeAccuracy) / (1 - relativeAccuracy));
+
+        /* indexOf() of the largest double must fit in an int */
+        if (std::log(std::numeric_limits<double>::max()) / logGamma >= std::numeric_limits<int>::max()) {
+            throw std::invalid_argument("relative accuracy is too small");
+        }
+    }
+
+    int DDSketch::indexOf(double value) const {
+        return static_cast<int>(std::ceil(std::log(value) / logGamma));
+    }
+
+    double DDSketch::valueOf(int index) const {
+        /* The point of (gamma^(i-1), gamma^i] with the same relative distance to both ends */
+        return 2 * std::exp(index * logGamma) / (1 + std::exp(logGamma));
+    }
+
+    void DDSketch::add(double value, uint64_t times) {
+        /* NaN and infinities have no bucket, and an infinity would also poison sum */
+        if (times == 0 || !std::isfinite(value)) {
+            return;
+        }
+
+        double magnitude = std::fabs(value);
+
+        if (magnitude < std::numeric_limits<double>::min()) {
+            zeroCount += times;
+        } else if (value > 0) {
+            positive.add(indexOf(magnitude), times, maxBuckets);
+        } else {
+            negative.add(indexOf(magnitude), times, maxBuckets);
+        }
+
+        min = count == 0 ? value : std::min(min, value);
+        max = count == 0 ? value : std::max(max, value);
+        sum += value * static_cast<double>(times);
+        count += times;
+    }
+
+    double DDSketch::quantile(double q) const {
+        if (!(q >= 0 && q <= 1)) {
+            throw std::invalid_argument("quantile must be between 0 and 1");
+        }
+
+        if (count == 0) {
+            throw std::out_of_range("the sketch is empty");
+        }
+
+        /* Rank of the wanted value among the sorted values, counted from 0 */
+        double rank = q * static_cast<double>(count - 1);
+        uint64_t seen = 0;
+        double result = max;
+        bool found = false;
+
+        /* Negative values in ascending order: largest magnitude first */
+        for (size_t i = negative.counts.size(); i-- > 0 && !found;) {
+            seen += negative.counts[i];
+
+            if (static_cast<double>(seen) > rank) {
+                result = -valueOf(negative.offset + static_cast<int>(i));
+                found = true;
+            }
+        }
+
+        if (!found) {
+            seen += zeroCount;
+
+            if (static_cast<double>(seen) > rank) {
+                result = 0;
+                found = true;
+            }
+        }
+
+        for (size_t i = 0; i < positive.counts.size() && !found; i++) {
+            seen += positive.counts[i];
+
+            if (static_cast<double>(seen) > rank) {
+                result = valueOf(positive.offset + static_cast<int>(i));
+                found = true;
+            }
+        }
+
+        return std::clamp(result, min, max);
+    }
+
+    void DDSketch::merge(const DDSketch& other) {
+        if (other.logGamma != logGamma) {
+            throw std::invalid_argument("sketches have different relative accuracies");
+        }
+
+        if (other.count == 0) {
+            return;
+        }
+
+        for (size_t i = 0; i < other.positive.counts.size(); i++) {
+            if (other.positive.counts[i]) {
+                positive.add(other.positive.offset + static_cast<int>(i), other.positive.counts[i], maxBuckets);
+            }
+        }
+
+        for (size_t i = 0; i < other.negative.counts.size(); i++) {
+            if (other.negative.counts[i]) {
+                negative.add(other.negative.offset + static_cast<int>(i), other.negative.counts[i], maxBuckets);
+            }
+        }
+
+        min = count == 0 ? other.min : std::min(min, other.min);
+        max = count == 0 ? other.max : std::max(max, other.max);
+        zeroCount += other.zeroCount;
+        sum += other.sum;
+        count += other.count;
+    }
+
+    void DDSketch::clear() {
+        positive.clear();
+        negative.clear();
+        zeroCount = 0;
+        count = 0;
+        sum = 0;
+        min = 0;
+        max = 0;
+    }
+
+    double DDSketch::getMean() const {
+        if (count == 0) {
+            throw std::out_of_range("the sketch is empty");
+        }
+
+        return sum / static_cast<double>(count);
+    }
+
+    double DDSketch::getMin() const {
+        if (count == 0) {
+            throw std::out_of_range("the sketch is empty");
+        }
+
+        return min;
+    }
+
+    double DDSketch::getMax() const {
+        if (count == 0) {
+            throw std::out_of_range("the sketch is empty");
+        }
+
+        return max;
+    }
+}
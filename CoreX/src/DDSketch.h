@@ -0,0 +1,176 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+namespace zen::corex {
+    /**
+     * @brief Quantile sketch with a guaranteed relative error (DDSketch)
+     *
+     * Values are counted in logarithmic buckets: bucket i holds the values
+     * in (gamma^(i-1), gamma^i] with gamma = (1 + a) / (1 - a), so any
+     * quantile is returned within a relative error a of the true value (1%
+     * by default), whatever the distribution. Positive and negative values
+     * have their own buckets, zeros a plain counter. Memory grows with the
+     * logarithm of the value range, not with the number of values: a
+     * latency range from 1 ns to 1 hour needs about 1,450 buckets at 1%.
+     * It offers:
+     * - add() in O(1) amortized
+     * - quantile() in O(buckets)
+     * - merge() of sketches filled by different threads or processes
+     * - Exact count, sum, minimum and maximum
+     *
+     * Example usage:
+     * @code
+     * zen::corex::DDSketch latencies;
+     *
+     * for (double microseconds : samples) {
+     *     latencies.add(microseconds);
+     * }
+     *
+     * cout << latencies.quantile(0.5) << " " << latencies.quantile(0.99) << endl;
+     * @endcode
+     *
+     * @note When a sign needs more than maxBuckets buckets, the ones closest
+     *       to zero are combined: the relative error bound then only holds
+     *       for the upper quantiles, which are usually the interesting ones.
+     */
+    class DDSketch {
+        private:
+            /**
+             * @brief Contiguous bucket counts for one sign
+             */
+            struct Store {
+                std::vector<uint64_t> counts;
+                int offset = 0;             ///< Bucket index of counts[0]
+                bool collapsed = false;     ///< counts[0] also holds every lower bucket
+
+                void add(int index, uint64_t count, size_t maxBuckets);
+
+                void clear() {
+                    counts.clear();
+                    offset = 0;
+                    collapsed = false;
+                }
+            };
+
+            double relativeAccuracy;
+            double logGamma;            ///< log((1 + a) / (1 - a))
+            size_t maxBuckets;
+
+            Store positive;
+            Store negative;             ///< Buckets of the absolute values
+            uint64_t zeroCount = 0;
+            uint64_t count = 0;
+            double sum = 0;
+            double min = 0;
+            double max = 0;
+
+            int indexOf(double value) const;
+
+            double valueOf(int index) const;
+
+        public:
+            /**
+             * @brief Constructs an empty sketch
+             *
+             * @param relativeAccuracy Bound on the relative error of quantile(), in (0, 1)
+             * @param maxBuckets Maximum number of buckets per sign
+             * @throws std::invalid_argument if relativeAccuracy is not in (0, 1), is so small
+             *         that bucket indices would overflow (below about 3e-7), or maxBuckets is 0
+             */
+            explicit DDSketch(double relativeAccuracy = 0.01, size_t maxBuckets = 2048);
+
+            /**
+             * @brief Adds a value a number of times
+             *
+             * NaN and infinite values are ignored, like a times of 0.
+             *
+             * @complexity O(1) amortized
+             */
+            void add(double value, uint64_t times = 1);
+
+            /**
+             * @brief Returns an approximation of a quantile
+             *
+             * @param q Quantile in [0, 1]; 0.5 is the median, 0.99 the 99th percentile
+             * @throws std::invalid_argument if q is not in [0, 1]
+             * @throws std::out_of_range if the sketch is empty
+             *
+             * @complexity O(buckets)
+             */
+            double quantile(double q) const;
+
+            /**
+             * @brief Adds the values of another sketch
+             *
+             * @throws std::invalid_argument if the relative accuracies differ
+             *
+             * @complexity O(buckets)
+             */
+            void merge(const DDSketch& other);
+
+            /**
+             * @brief Removes all values
+             */
+            void clear();
+
+            /**
+             * @brief Checks if no value was added
+             */
+            bool isEmpty() const {
+                return count == 0;
+            }
+
+            /**
+             * @brief Returns the number of values added
+             */
+            uint64_t getCount() const {
+                return count;
+            }
+
+            /**
+             * @brief Returns the sum of the values added
+             */
+            double getSum() const {
+                return sum;
+            }
+
+            /**
+             * @brief Returns the mean of the values added
+             *
+             * @throws std::out_of_range if the sketch is empty
+             */
+            double getMean() const;
+
+            /**
+             * @brief Returns the smallest value added
+             *
+             * @throws std::out_of_range if the sketch is empty
+             */
+            double getMin() const;
+
+            /**
+             * @brief Returns the largest value added
+             *
+             * @throws std::out_of_range if the sketch is empty
+             */
+            double getMax() const;
+
+            /**
+             * @brief Returns the relative accuracy given at construction
+             */
+            double getRelativeAccuracy() const {
+                return relativeAccuracy;
+            }
+
+            /**
+             * @brief Returns the number of buckets in use
+             */
+            size_t getBucketCount() const {
+                return positive.counts.size() + negative.counts.size();
+            }
+    };
+}
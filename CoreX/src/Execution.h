@@ -0,0 +1,115 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <type_traits>
+
+#include "ThreadPool.h"
+
+namespace zen::corex {
+    /**
+     * @brief Execution policy: run an algorithm on the calling thread
+     */
+    struct Sequential {};
+
+    /**
+     * @brief Execution policy: split an algorithm into blocks run by a ThreadPool
+     *
+     * Example usage:
+     * @code
+     * zen::corex::ThreadPool pool;
+     * auto squares = numbers.map(zen::corex::Parallel(pool), [](int x) { return x * x; });
+     * @endcode
+     */
+    struct Parallel {
+        ThreadPool& pool;
+        size_t grain;   ///< Elements per block; 0 picks about 8 blocks per worker, at least 4096 elements
+
+        explicit Parallel(ThreadPool& pool, size_t grain = 0) : pool(pool), grain(grain) {}
+
+        /**
+         * @brief Returns the number of elements per block for a range of count elements
+         */
+        size_t getBlockSize(size_t count) const {
+            if (grain > 0) {
+                return grain;
+            }
+
+            return std::max<size_t>(4096, count / (pool.getThreadCount() * 8));
+        }
+    };
+
+    /**
+     * @brief Satisfied by Sequential and Parallel
+     */
+    template <typename P>
+    concept ExecutionPolicy = std::is_same_v<P, Sequential> || std::is_same_v<P, Parallel>;
+
+    namespace detail {
+        /**
+         * @brief Number of elements per block under a policy
+         */
+        inline size_t blockSize(const Sequential&, size_t count) {
+            return std::max<size_t>(count, 1);
+        }
+
+        inline size_t blockSize(const Parallel& policy, size_t count) {
+            return policy.getBlockSize(count);
+        }
+
+        /**
+         * @brief Calls function(block, from, to) for every block of [0, count)
+         *
+         * Blocks are numbered from 0 and cover [block * size, min((block + 1) * size, count)),
+         * so per-block results can be stored by block number and combined in order.
+         */
+        template <typename F>
+        void forEachBlock(const Sequential&, size_t count, size_t size, F&& function) {
+            for (size_t from = 0, block = 0; from < count; from += size, block++) {
+                function(block, from, std::min(from + size, count));
+            }
+        }
+
+        template <typename F>
+        void forEachBlock(const Parallel& policy, size_t count, size_t size, F&& function) {
+            size_t blocks = (count + size - 1) / size;
+
+            policy.pool.parallelFor(0, blocks, [&function, count, size](size_t block) {
+                function(block, block * size, std::min(block * size + size, count));
+            }, 1);
+        }
+
+        /**
+         * @brief Sorts [first, first + count) under a policy
+         *
+         * Blocks are sorted independently and then merged pairwise in rounds
+         * of doubling width; with Parallel the blocks of a round run
+         * concurrently. The sort is not stable.
+         */
+        template <typename T, typename C>
+        void sort(const Sequential&, T* first, size_t count, C&& less) {
+            std::sort(first, first + count, less);
+        }
+
+        template <typename T, typename C>
+        void sort(const Parallel& policy, T* first, size_t count, C&& less) {
+            size_t size = policy.getBlockSize(count);
+
+            forEachBlock(policy, count, size, [first, &less](size_t, size_t from, size_t to) {
+                std::sort(first + from, first + to, less);
+            });
+
+            for (size_t width = size; width < count; width *= 2) {
+                size_t pairs = (count + 2 * width - 1) / (2 * width);
+
+                policy.pool.parallelFor(0, pairs, [first, count, width, &less](size_t pair) {
+                    size_t from = pair * 2 * width;
+                    size_t middle = std::min(from + width, count);
+                    size_t to = std::min(from + 2 * width, count);
+
+                    std::inplace_merge(first + from, first + middle, first + to, less);
+                }, 1);
+            }
+        }
+    }
+}
@@ -0,0 +1,77 @@
+#include "FilterFile.h"
+
+#include "Serialization.h"
+
+#include <fstream>
+#include <stdexcept>
+
+namespace zen::corex::detail {
+    namespace {
+        constexpr uint32_t VERSION = 1;
+    }
+
+    void saveFilter(const std::string& path, uint32_t magic, const uint64_t* header, size_t headerSize,
+                    const void* data, size_t bytes) {
+        std::ofstream output(path, std::ios::binary | std::ios::trunc);
+        if (!output.is_open()) {
+            throw std::runtime_error("Failed to open file: " + path);
+        }
+
+        uint64_t size = bytes;
+        uint64_t sum = checksum(static_cast<const char*>(data), bytes);
+
+        output.write(reinterpret_cast<const char*>(&magic), sizeof(magic));
+        output.write(reinterpret_cast<const char*>(&VERSION), sizeof(VERSION));
+        output.write(reinterpret_cast<const char*>(header), headerSize * sizeof(uint64_t));
+        output.write(reinterpret_cast<const char*>(&size), sizeof(size));
+        output.write(static_cast<const char*>(data), bytes);
+        output.write(reinterpret_cast<const char*>(&sum), sizeof(sum));
+
+        if (!output) {
+            throw std::runtime_error("Failed to write file: " + path);
+        }
+    }
+
+    std::vector<char> loadFilter(const std::string& path, uint32_t magic, uint64_t* header, size_t headerSize) {
+        std::ifstream input(path, std::ios::binary);
+        if (!input.is_open()) {
+            throw std::runtime_error("Failed to open file: " + path);
+        }
+
+        uint32_t fileMagic = 0;
+        uint32_t version = 0;
+        uint64_t size = 0;
+
+        input.read(reinterpret_cast<char*>(&fileMagic), sizeof(fileMagic));
+        input.read(reinterpret_cast<char*>(&version), sizeof(version));
+        input.read(reinterpret_cast<char*>(header), headerSize * sizeof(uint64_t));
+        input.read(reinterpret_cast<char*>(&size), sizeof(size));
+
+        if (!input || fileMagic != magic || version != VERSION) {
+            throw std::runtime_error("Invalid filter file: " + path);
+        }
+
+        /* Check the announced size against the file before allocating it */
+        std::streamoff start = input.tellg();
+        input.seekg(0, std::ios::end);
+        std::streamoff end = input.tellg();
+
+        if (end - start != static_cast<std::streamoff>(size + sizeof(uint64_t))) {
+            throw std::runtime_error("Invalid filter file: " + path);
+        }
+
+        input.seekg(start);
+
+        std::vector<char> data(size);
+        uint64_t sum = 0;
+
+        input.read(data.data(), size);
+        input.read(reinterpret_cast<char*>(&sum), sizeof(sum));
+
+        if (!input || sum != checksum(data.data(), data.size())) {
+            throw std::runtime_error("Invalid filter file: " + path);
+        }
+
+        return data;
+    }
+}
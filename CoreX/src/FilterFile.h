@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace zen::corex::detail {
+    /** @brief File signature of BloomFilter::save() ("ZBLM") */
+    constexpr uint32_t BLOOM_MAGIC = 0x4d4c425a;
+
+    /** @brief File signature of CuckooFilter::save() ("ZCKF") */
+    constexpr uint32_t CUCKOO_MAGIC = 0x464b435a;
+
+    /**
+     * @brief Writes a filter file: signature, header words, payload and a checksum of the payload
+     *
+     * @throws std::runtime_error if the file cannot be written
+     */
+    void saveFilter(const std::string& path, uint32_t magic, const uint64_t* header, size_t headerSize,
+                    const void* data, size_t bytes);
+
+    /**
+     * @brief Reads a file written by saveFilter()
+     *
+     * @param header Receives headerSize header words
+     * @return std::vector<char> The payload
+     * @throws std::runtime_error if the file cannot be read, has another signature or a bad checksum
+     */
+    std::vector<char> loadFilter(const std::string& path, uint32_t magic, uint64_t* header, size_t headerSize);
+}
@@ -0,0 +1,390 @@
+#pragma once
+
+#include <algorithm>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "Array.h"
+#include "FlatTable.h"
+#include "HashTable.h"
+
+namespace zen::corex {
+    /**
+     * @brief An ordered key/value container stored in sorted contiguous arrays
+     *
+     * @tparam K The key type
+     * @tparam V The value type
+     * @tparam C Key ordering (defaults to zen::corex::Less<K>)
+     *
+     * FlatMap keeps the keys sorted in one array and the values in a
+     * parallel array, so a lookup's binary search only touches keys and
+     * iteration is a linear scan. Inserting or removing a single entry
+     * shifts the entries after it; the container is meant for read-mostly
+     * tables built in bulk (the constructors and putAll() sort once). It
+     * offers:
+     * - O(log n) lookup, O(n) single insert and removal
+     * - Heterogeneous lookup: a FlatMap<String, V> can be searched with
+     *   std::string_view, std::string or const char*
+     * - Iteration in key order as std::pair<const K&, V&>
+     * - An optional Eytzinger layout for faster lookups in large tables
+     * - Const lookups from any number of threads while nobody modifies it
+     *
+     * Example usage:
+     * @code
+     * zen::corex::FlatMap<zen::corex::String, int> ports = {{"http", 80}, {"ssh", 22}};
+     *
+     * if (int* port = ports.find("ssh")) {
+     *     cout << *port << endl;   // 22
+     * }
+     *
+     * for (auto [name, port] : ports) {
+     *     cout << name << " " << port << endl;   // http 80, ssh 22
+     * }
+     * @endcode
+     */
+    template <typename K, typename V, typename C = Less<K>>
+    class FlatMap {
+        private:
+            detail::FlatTable<K, C> table;  ///< Sorted keys
+            std::vector<V> values;          ///< values[i] belongs to table.keys[i]
+
+            void build(std::vector<std::pair<K, V>> items) {
+                const C& less = table.less;
+
+                /* Stable, so the last of several equal keys can win like in put() */
+                std::stable_sort(items.begin(), items.end(), [&less](const auto& first, const auto& second) {
+                    return less(first.first, second.first);
+                });
+
+                /* Filled on the side and swapped in, so an exception leaves the map as it was */
+                std::vector<K> keys;
+                std::vector<V> sortedValues;
+                keys.reserve(items.size());
+                sortedValues.reserve(items.size());
+
+                for (auto& item : items) {
+                    if (!keys.empty() && table.equivalent(keys.back(), item.first)) {
+                        sortedValues.back() = std::move(item.second);
+                    } else {
+                        keys.push_back(std::move(item.first));
+                        sortedValues.push_back(std::move(item.second));
+                    }
+                }
+
+                table.keys.swap(keys);
+                values.swap(sortedValues);
+                table.rebuild();
+            }
+
+            template <typename Q>
+            size_t insertIndex(const Q& key, bool& inserted) {
+                size_t index = table.lowerBound(key);
+                inserted = index == table.keys.size() || table.less(key, table.keys[index]);
+
+                if (inserted) {
+                    K newKey = detail::makeKey<K>(key);
+                    V newValue{};
+
+                    table.keys.reserve(table.keys.size() + 1);
+                    values.reserve(values.size() + 1);
+                    table.keys.insert(table.keys.begin() + index, std::move(newKey));
+
+                    /* Keep the two arrays the same length if shifting the values throws */
+                    try {
+                        values.insert(values.begin() + index, std::move(newValue));
+                    } catch (...) {
+                        table.keys.erase(table.keys.begin() + index);
+                        throw;
+                    }
+
+                    table.rebuild();
+                }
+
+                return index;
+            }
+
+        public:
+            /**
+             * @brief Forward iterator over the entries in key order
+             *
+             * @tparam Const true for const_iterator
+             */
+            template <bool Const>
+            class Iterator {
+                private:
+                    using Map = std::conditional_t<Const, const FlatMap, FlatMap>;
+                    using Value = std::conditional_t<Const, const V, V>;
+
+                    Map* map = nullptr;
+                    size_t index = 0;
+
+                public:
+                    using iterator_category = std::forward_iterator_tag;
+                    using value_type = std::pair<const K&, Value&>;
+                    using difference_type = std::ptrdiff_t;
+                    using reference = value_type;
+
+                    Iterator() = default;
+
+                    Iterator(Map* map, size_t index) : map(map), index(index) {}
+
+                    value_type operator*() const {
+                        return value_type(map->table.keys[index], map->values[index]);
+                    }
+
+                    Iterator& operator++() {
+                        index++;
+                        return *this;
+                    }
+
+                    Iterator operator++(int) {
+                        Iterator previous = *this;
+                        index++;
+
+                        return previous;
+                    }
+
+                    bool operator==(const Iterator& other) const {
+                        return index == other.index;
+                    }
+            };
+
+            using iterator = Iterator<false>;
+            using const_iterator = Iterator<true>;
+
+            /**
+             * @brief Constructs an empty map
+             *
+             * @param layout Search structure; Eytzinger pays off from tens of thousands of keys
+             */
+            explicit FlatMap(FlatLayout layout = FlatLayout::Sorted) : table(layout) {}
+
+            /**
+             * @brief Constructs a map from a list of key/value pairs
+             *
+             * @param items Pairs to insert; later duplicates overwrite earlier ones
+             *
+             * @complexity O(n log n)
+             */
+            FlatMap(std::initializer_list<std::pair<K, V>> items, FlatLayout layout = FlatLayout::Sorted) : table(layout) {
+                build(std::vector<std::pair<K, V>>(items));
+            }
+
+            /**
+             * @brief Constructs a map from a std::vector of key/value pairs
+             *
+             * @complexity O(n log n)
+             */
+            explicit FlatMap(std::vector<std::pair<K, V>> items, FlatLayout layout = FlatLayout::Sorted) : table(layout) {
+                build(std::move(items));
+            }
+
+            /**
+             * @brief Constructs a map from an Array of key/value pairs
+             *
+             * @complexity O(n log n)
+             */
+            explicit FlatMap(const Array<std::pair<K, V>>& items, FlatLayout layout = FlatLayout::Sorted)
+                : FlatMap(items.toVector(), layout) {}
+
+            /**
+             * @brief Inserts or updates an entry
+             *
+             * @return true If a new entry was inserted
+             * @return false If an existing entry was updated
+             *
+             * @complexity O(log n) to update, O(n) to insert
+             */
+            template <typename Q = K>
+            bool put(const Q& key, const V& value) {
+                bool inserted;
+                size_t index = insertIndex(key, inserted);
+
+                values[index] = value;
+                return inserted;
+            }
+
+            /**
+             * @brief Inserts or updates many entries with a single sort
+             *
+             * @param items Pairs to insert; they win over existing entries, later duplicates over earlier ones
+             *
+             * @complexity O((n + m) log(n + m))
+             */
+            void putAll(const std::vector<std::pair<K, V>>& items) {
+                std::vector<std::pair<K, V>> merged;
+                merged.reserve(table.keys.size() + items.size());
+
+                /* Copied, not moved: the current entries must survive if a copy or the sort throws */
+                for (size_t i = 0; i < table.keys.size(); i++) {
+                    merged.emplace_back(table.keys[i], values[i]);
+                }
+
+                merged.insert(merged.end(), items.begin(), items.end());
+                build(std::move(merged));
+            }
+
+            /**
+             * @brief Accesses the value of a key, inserting a default value if absent
+             *
+             * @complexity O(log n) if present, O(n) otherwise
+             */
+            template <typename Q = K>
+            V& operator[](const Q& key) {
+                bool inserted;
+                size_t index = insertIndex(key, inserted);
+
+                return values[index];
+            }
+
+            /**
+             * @brief Accesses the value of an existing key
+             *
+             * @throws std::out_of_range if the key is not in the map
+             *
+             * @complexity O(log n)
+             */
+            template <typename Q = K>
+            V& get(const Q& key) {
+                V* value = find(key);
+                if (!value) {
+                    throw std::out_of_range("the key is not in the map");
+                }
+
+                return *value;
+            }
+
+            /**
+             * @brief Const version of get()
+             *
+             * @throws std::out_of_range if the key is not in the map
+             */
+            template <typename Q = K>
+            const V& get(const Q& key) const {
+                const V* value = find(key);
+                if (!value) {
+                    throw std::out_of_range("the key is not in the map");
+                }
+
+                return *value;
+            }
+
+            /**
+             * @brief Looks up a key without throwing
+             *
+             * @return V* Pointer to the value, or nullptr if the key is absent
+             *
+             * @complexity O(log n)
+             */
+            template <typename Q = K>
+            V* find(const Q& key) {
+                size_t index = table.find(key);
+                return index == table.NOT_FOUND ? nullptr : &values[index];
+            }
+
+            /**
+             * @brief Const version of find()
+             */
+            template <typename Q = K>
+            const V* find(const Q& key) const {
+                size_t index = table.find(key);
+                return index == table.NOT_FOUND ? nullptr : &values[index];
+            }
+
+            /**
+             * @brief Checks if a key exists in the map
+             *
+             * @complexity O(log n)
+             */
+            template <typename Q = K>
+            bool contains(const Q& key) const {
+                return table.find(key) != table.NOT_FOUND;
+            }
+
+            /**
+             * @brief Removes the entry of a key
+             *
+             * @return true If an entry was removed
+             * @return false If the key was not in the map
+             *
+             * @complexity O(n)
+             */
+            template <typename Q = K>
+            bool remove(const Q& key) {
+                size_t index = table.find(key);
+                if (index == table.NOT_FOUND) {
+                    return false;
+                }
+
+                table.keys.erase(table.keys.begin() + index);
+                values.erase(values.begin() + index);
+                table.rebuild();
+
+                return true;
+            }
+
+            /**
+             * @brief Removes all entries
+             */
+            void clear() {
+                table.keys.clear();
+                values.clear();
+                table.rebuild();
+            }
+
+            /**
+             * @brief Allocates room for a number of entries
+             */
+            void reserve(size_t count) {
+                table.keys.reserve(count);
+                values.reserve(count);
+            }
+
+            /**
+             * @brief Checks if the map is empty
+             */
+            bool isEmpty() const {
+                return table.keys.empty();
+            }
+
+            /**
+             * @brief Returns the number of entries
+             */
+            size_t getSize() const {
+                return table.keys.size();
+            }
+
+            /**
+             * @brief Returns the keys in ascending order
+             */
+            const std::vector<K>& getKeys() const {
+                return table.keys;
+            }
+
+            /**
+             * @brief Returns the values in the order of their keys
+             */
+            const std::vector<V>& getValues() const {
+                return values;
+            }
+
+            iterator begin() {
+                return iterator(this, 0);
+            }
+
+            iterator end() {
+                return iterator(this, table.keys.size());
+            }
+
+            const_iterator begin() const {
+                return const_iterator(this, 0);
+            }
+
+            const_iterator end() const {
+                return const_iterator(this, table.keys.size());
+            }
+    };
+}
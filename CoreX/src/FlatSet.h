@@ -0,0 +1,257 @@
+#pragma once
+
+#include <algorithm>
+#include <initializer_list>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "Array.h"
+#include "FlatTable.h"
+
+namespace zen::corex {
+    /**
+     * @brief An ordered set stored as one sorted contiguous array
+     *
+     * @tparam T The key type
+     * @tparam C Ordering (defaults to zen::corex::Less<T>)
+     *
+     * FlatSet keeps its keys sorted in a single array: lookups are a
+     * branchless binary search over contiguous memory and iteration is a
+     * linear scan, both far friendlier to the cache than the nodes of a
+     * std::set. Inserting or removing a single key shifts the keys after it,
+     * so the container is meant for read-mostly tables that are filled in
+     * bulk (addAll() or the constructors sort and deduplicate once). It
+     * offers:
+     * - O(log n) lookup, O(n) single insert and removal
+     * - Bulk construction from Array, std::vector or an initializer list
+     * - Keys in ascending order by index and by iteration
+     * - An optional Eytzinger layout for faster lookups in large tables
+     * - Const lookups from any number of threads while nobody modifies it
+     *
+     * Example usage:
+     * @code
+     * zen::corex::FlatSet<int> primes = {7, 2, 5, 3, 2};
+     *
+     * primes.contains(5);   // true
+     * primes[0];            // 2
+     * @endcode
+     */
+    template <typename T, typename C = Less<T>>
+    class FlatSet {
+        private:
+            detail::FlatTable<T, C> table;  ///< Underlying sorted storage
+
+            void sortAndDeduplicate(size_t from) {
+                std::vector<T>& keys = table.keys;
+                const C& less = table.less;
+
+                std::sort(keys.begin() + from, keys.end(), less);
+                std::inplace_merge(keys.begin(), keys.begin() + from, keys.end(), less);
+
+                keys.erase(std::unique(keys.begin(), keys.end(), [this](const T& first, const T& second) {
+                    return table.equivalent(first, second);
+                }), keys.end());
+
+                table.rebuild();
+            }
+
+        public:
+            using const_iterator = typename std::vector<T>::const_iterator;
+            using iterator = const_iterator;
+
+            /**
+             * @brief Constructs an empty set
+             *
+             * @param layout Search structure; Eytzinger pays off from tens of thousands of keys
+             */
+            explicit FlatSet(FlatLayout layout = FlatLayout::Sorted) : table(layout) {}
+
+            /**
+             * @brief Constructs a set from a list of keys
+             *
+             * @param items Keys to insert; duplicates are ignored
+             *
+             * @complexity O(n log n)
+             */
+            FlatSet(std::initializer_list<T> items, FlatLayout layout = FlatLayout::Sorted) : table(layout) {
+                addAll(items.begin(), items.size());
+            }
+
+            /**
+             * @brief Constructs a set from the elements of a std::vector
+             *
+             * @complexity O(n log n)
+             */
+            explicit FlatSet(std::vector<T> items, FlatLayout layout = FlatLayout::Sorted) : table(layout) {
+                table.keys = std::move(items);
+                sortAndDeduplicate(0);
+            }
+
+            /**
+             * @brief Constructs a set from the elements of an Array
+             *
+             * @complexity O(n log n)
+             */
+            explicit FlatSet(const Array<T>& items, FlatLayout layout = FlatLayout::Sorted)
+                : FlatSet(items.toVector(), layout) {}
+
+            /**
+             * @brief Inserts a key
+             *
+             * @return true If the key was inserted
+             * @return false If it was already in the set
+             *
+             * @complexity O(n) because the following keys move
+             */
+            bool add(const T& key) {
+                size_t index = table.lowerBound(key);
+
+                if (index < table.keys.size() && !table.less(key, table.keys[index])) {
+                    return false;
+                }
+
+                table.keys.insert(table.keys.begin() + index, key);
+                table.rebuild();
+
+                return true;
+            }
+
+            /**
+             * @brief Inserts many keys with a single sort and merge
+             *
+             * @param items Keys to insert; duplicates are ignored
+             * @param count Number of keys in items
+             *
+             * @complexity O(n + m log m) for m new keys
+             */
+            void addAll(const T* items, size_t count) {
+                size_t from = table.keys.size();
+
+                table.keys.insert(table.keys.end(), items, items + count);
+                sortAndDeduplicate(from);
+            }
+
+            /**
+             * @brief Inserts the elements of an Array with a single sort and merge
+             */
+            void addAll(const Array<T>& items) {
+                std::vector<T> keys = items.toVector();
+                addAll(keys.data(), keys.size());
+            }
+
+            /**
+             * @brief Removes a key
+             *
+             * @return true If the key was removed
+             * @return false If it was not in the set
+             *
+             * @complexity O(n)
+             */
+            template <typename Q = T>
+            bool remove(const Q& key) {
+                size_t index = table.find(key);
+                if (index == table.NOT_FOUND) {
+                    return false;
+                }
+
+                table.keys.erase(table.keys.begin() + index);
+                table.rebuild();
+
+                return true;
+            }
+
+            /**
+             * @brief Checks if a key is in the set
+             *
+             * @complexity O(log n)
+             */
+            template <typename Q = T>
+            bool contains(const Q& key) const {
+                return table.find(key) != table.NOT_FOUND;
+            }
+
+            /**
+             * @brief Returns the position of a key in ascending order
+             *
+             * @return size_t Index of the key, or FlatSet::NOT_FOUND
+             *
+             * @complexity O(log n)
+             */
+            template <typename Q = T>
+            size_t indexOf(const Q& key) const {
+                return table.find(key);
+            }
+
+            /**
+             * @brief Returns the position of the first key not less than a value
+             *
+             * @return size_t Index in [0, size]
+             *
+             * @complexity O(log n)
+             */
+            template <typename Q = T>
+            size_t lowerBound(const Q& key) const {
+                return table.lowerBound(key);
+            }
+
+            /**
+             * @brief Accesses the key at a position in ascending order
+             *
+             * @throws std::out_of_range if index is greater than or equal to size
+             */
+            const T& operator[](size_t index) const {
+                if (index >= table.keys.size()) {
+                    throw std::out_of_range("Index out of range");
+                }
+
+                return table.keys[index];
+            }
+
+            /**
+             * @brief Removes all keys
+             */
+            void clear() {
+                table.keys.clear();
+                table.rebuild();
+            }
+
+            /**
+             * @brief Allocates room for a number of keys
+             */
+            void reserve(size_t count) {
+                table.keys.reserve(count);
+            }
+
+            /**
+             * @brief Checks if the set is empty
+             */
+            bool isEmpty() const {
+                return table.keys.empty();
+            }
+
+            /**
+             * @brief Returns the number of keys
+             */
+            size_t getSize() const {
+                return table.keys.size();
+            }
+
+            /**
+             * @brief Returns the keys in ascending order
+             */
+            const std::vector<T>& toVector() const {
+                return table.keys;
+            }
+
+            const_iterator begin() const {
+                return table.keys.begin();
+            }
+
+            const_iterator end() const {
+                return table.keys.end();
+            }
+
+            static constexpr size_t NOT_FOUND = detail::FlatTable<T, C>::NOT_FOUND;
+    };
+}
@@ -0,0 +1,197 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "String.h"
+
+namespace zen::corex {
+    /**
+     * @brief Default ordering used by FlatSet and FlatMap
+     *
+     * @tparam T The key type
+     *
+     * Uses operator<. Specialize it to make your own types usable as keys.
+     */
+    template <typename T>
+    struct Less {
+        bool operator()(const T& first, const T& second) const {
+            return first < second;
+        }
+    };
+
+    /**
+     * @brief Byte-wise ordering for corex::String with heterogeneous lookup
+     *
+     * Orders String, std::string, std::string_view and C-strings the same
+     * way, so a FlatMap<String, V> can be searched with any of them without
+     * building a temporary String.
+     */
+    template <>
+    struct Less<String> {
+        using is_transparent = void;
+
+        static std::string_view view(const String& key) {
+            return std::string_view(key.toCharArray(), key.getSize());
+        }
+
+        static std::string_view view(std::string_view key) {
+            return key;
+        }
+
+        static std::string_view view(const std::string& key) {
+            return key;
+        }
+
+        static std::string_view view(const char* key) {
+            return key;
+        }
+
+        template <typename A, typename B>
+        bool operator()(const A& first, const B& second) const {
+            return view(first) < view(second);
+        }
+    };
+
+    /**
+     * @brief Search structure used by FlatSet and FlatMap
+     */
+    enum class FlatLayout {
+        Sorted,     ///< Branchless binary search over the sorted keys
+        Eytzinger   ///< Extra copy of the keys in breadth-first (Eytzinger) order, for large tables
+    };
+
+    namespace detail {
+        /**
+         * @brief Branchless lower bound over a sorted range
+         *
+         * The loop has a fixed trip count of about log2(size) and the
+         * comparison result only selects the next base pointer, which the
+         * compiler turns into a conditional move: there is no branch to
+         * mispredict.
+         *
+         * @return Index of the first element not less than key, or size
+         */
+        template <typename T, typename Q, typename C>
+        size_t lowerBound(const T* data, size_t size, const Q& key, const C& less) {
+            if (size == 0) {
+                return 0;
+            }
+
+            const T* base = data;
+
+            while (size > 1) {
+                size_t half = size / 2;
+                base = less(base[half], key) ? base + half : base;
+                size -= half;
+            }
+
+            return (base - data) + less(*base, key);
+        }
+
+        /**
+         * @brief Sorted key storage shared by FlatSet and FlatMap
+         *
+         * @tparam K Key type
+         * @tparam C Ordering
+         *
+         * Keys are kept sorted and unique. With the Eytzinger layout a second
+         * copy of the keys is stored in breadth-first order of the implicit
+         * search tree (children of node k at 2k and 2k + 1), so the first
+         * levels of every search share the same few cache lines and the
+         * next levels can be prefetched. The copy is rebuilt eagerly by every
+         * modification (O(n), like the insertion itself), so lookups never
+         * write and concurrent const lookups are safe.
+         */
+        template <typename K, typename C>
+        class FlatTable {
+            public:
+                static constexpr size_t NOT_FOUND = static_cast<size_t>(-1);
+
+                std::vector<K> keys;    ///< Sorted, unique
+                C less;
+                FlatLayout layout;
+
+                explicit FlatTable(FlatLayout layout = FlatLayout::Sorted) : layout(layout) {}
+
+                template <typename Q>
+                size_t lowerBound(const Q& key) const {
+                    if (layout == FlatLayout::Eytzinger) {
+                        return eytzingerLowerBound(key);
+                    }
+
+                    return detail::lowerBound(keys.data(), keys.size(), key, less);
+                }
+
+                template <typename Q>
+                size_t find(const Q& key) const {
+                    size_t index = lowerBound(key);
+                    return index < keys.size() && !less(key, keys[index]) ? index : NOT_FOUND;
+                }
+
+                bool equivalent(const K& first, const K& second) const {
+                    return !less(first, second) && !less(second, first);
+                }
+
+                /**
+                 * @brief Brings the Eytzinger copy up to date after keys changed
+                 */
+                void rebuild() {
+                    if (layout == FlatLayout::Eytzinger) {
+                        buildTree();
+                    }
+                }
+
+            private:
+                std::vector<K> tree;            ///< Keys in Eytzinger order, node k at tree[k - 1]
+                std::vector<size_t> ranks;      ///< Sorted index of node k at ranks[k]
+
+                size_t assignRanks(size_t rank, size_t node) {
+                    if (node <= keys.size()) {
+                        rank = assignRanks(rank, 2 * node);
+                        ranks[node] = rank++;
+                        rank = assignRanks(rank, 2 * node + 1);
+                    }
+
+                    return rank;
+                }
+
+                void buildTree() {
+                    ranks.assign(keys.size() + 1, 0);
+                    assignRanks(0, 1);
+
+                    tree.clear();
+                    tree.reserve(keys.size());
+
+                    for (size_t node = 1; node <= keys.size(); node++) {
+                        tree.push_back(keys[ranks[node]]);
+                    }
+                }
+
+                template <typename Q>
+                size_t eytzingerLowerBound(const Q& key) const {
+                    size_t size = tree.size();
+                    size_t node = 1;
+
+                    while (node <= size) {
+                        /* The 16 great-great-grandchildren of node are adjacent */
+                        if (16 * node <= size) {
+                            __builtin_prefetch(&tree[16 * node - 1]);
+                        }
+
+                        node = 2 * node + less(tree[node - 1], key);
+                    }
+
+                    /* Undo the right turns taken after the last left turn */
+                    node >>= std::countr_one(node) + 1;
+
+                    return node == 0 ? size : ranks[node];
+                }
+        };
+    }
+}
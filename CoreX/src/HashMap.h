@@ -0,0 +1,343 @@
+#pragma once
+
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+
+#include "HashTable.h"
+
+namespace zen::corex {
+    /**
+     * @brief An unordered key/value container using open addressing
+     *
+     * @tparam K The key type
+     * @tparam V The value type
+     * @tparam H Hash function (defaults to zen::corex::Hash<K>)
+     * @tparam E Key equality (defaults to zen::corex::Equal<K>)
+     *
+     * HashMap stores its entries in one flat array and finds them with
+     * Swiss-table style probing: 16 one-byte hash fingerprints are compared
+     * per SSE2 instruction, so a lookup usually inspects a single group and
+     * compares the key of a single entry. It offers:
+     * - O(1) average insert, lookup and removal
+     * - Heterogeneous lookup: a HashMap<String, V> can be searched with
+     *   std::string_view, std::string or const char* without conversion
+     * - Iteration over entries as std::pair<K, V>
+     *
+     * Example usage:
+     * @code
+     * zen::corex::HashMap<zen::corex::String, int> ages;
+     * ages.put("alice", 31);
+     * ages["bob"] = 27;
+     *
+     * if (int* age = ages.find("alice")) {
+     *     cout << *age << endl;   // 31
+     * }
+     * @endcode
+     *
+     * @note Inserting may move entries, which invalidates pointers,
+     *       references and iterators to them. Removing does not.
+     */
+    template <typename K, typename V, typename H = Hash<K>, typename E = Equal<K>>
+    class HashMap {
+        private:
+            using Entry = std::pair<K, V>;
+
+            struct KeyOf {
+                static const K& key(const Entry& entry) {
+                    return entry.first;
+                }
+            };
+
+            detail::HashTable<Entry, KeyOf, H, E> table;  ///< Underlying open-addressing table
+
+            template <typename Q>
+            size_t insertIndex(const Q& key, bool& inserted) {
+                size_t index = table.find(key);
+                inserted = index == table.NOT_FOUND;
+
+                /* The entry is built before a slot is claimed, so a throwing K or V leaves the table unchanged */
+                if (inserted) {
+                    index = table.insertUnique(std::piecewise_construct,
+                                               std::forward_as_tuple(detail::makeKey<K>(key)),
+                                               std::forward_as_tuple());
+                }
+
+                return index;
+            }
+
+        public:
+            /**
+             * @brief Forward iterator over the entries of a HashMap
+             *
+             * @tparam Const true for const_iterator
+             */
+            template <bool Const>
+            class Iterator {
+                private:
+                    using Table = std::conditional_t<Const, const detail::HashTable<Entry, KeyOf, H, E>,
+                                                            detail::HashTable<Entry, KeyOf, H, E>>;
+
+                    Table* table;
+                    size_t index;
+
+                public:
+                    using iterator_category = std::forward_iterator_tag;
+                    using value_type = Entry;
+                    using difference_type = std::ptrdiff_t;
+                    using pointer = std::conditional_t<Const, const Entry*, Entry*>;
+                    using reference = std::conditional_t<Const, const Entry&, Entry&>;
+
+                    Iterator() : table(nullptr), index(0) {}
+
+                    Iterator(Table* table, size_t index) : table(table), index(table->next(index)) {}
+
+                    reference operator*() const {
+                        return table->slots[index];
+                    }
+
+                    pointer operator->() const {
+                        return &table->slots[index];
+                    }
+
+                    Iterator& operator++() {
+                        index = table->next(index + 1);
+                        return *this;
+                    }
+
+                    Iterator operator++(int) {
+                        Iterator previous = *this;
+                        ++*this;
+
+                        return previous;
+                    }
+
+                    bool operator==(const Iterator& other) const {
+                        return index == other.index;
+                    }
+            };
+
+            using iterator = Iterator<false>;
+            using const_iterator = Iterator<true>;
+
+            /**
+             * @brief Constructs an empty map
+             *
+             * No memory is allocated until the first insertion.
+             */
+            HashMap() = default;
+
+            /**
+             * @brief Constructs an empty map that allocates from a memory resource
+             *
+             * @param resource Resource for the table storage, such as an Arena or
+             *                 ObjectPool; it must outlive the map
+             */
+            explicit HashMap(std::pmr::memory_resource* resource) : table(resource) {}
+
+            /**
+             * @brief Constructs a map from a list of key/value pairs
+             *
+             * @param items Pairs to insert; later duplicates overwrite earlier ones
+             *
+             * @complexity O(n) on average
+             */
+            HashMap(std::initializer_list<std::pair<K, V>> items) {
+                reserve(items.size());
+
+                for (const auto& item : items) {
+                    put(item.first, item.second);
+                }
+            }
+
+            /**
+             * @brief Inserts or updates an entry
+             *
+             * @param key Key of the entry
+             * @param value Value to store
+             * @return true If a new entry was inserted
+             * @return false If an existing entry was updated
+             *
+             * @complexity O(1) on average
+             */
+            template <typename Q = K>
+            bool put(const Q& key, const V& value) {
+                bool inserted;
+                size_t index = insertIndex(key, inserted);
+
+                table.slots[index].second = value;
+                return inserted;
+            }
+
+            /**
+             * @brief Accesses the value of a key, inserting a default value if absent
+             *
+             * @param key Key to look up
+             * @return V& Reference to the value
+             *
+             * @complexity O(1) on average
+             */
+            template <typename Q = K>
+            V& operator[](const Q& key) {
+                bool inserted;
+                size_t index = insertIndex(key, inserted);
+
+                return table.slots[index].second;
+            }
+
+            /**
+             * @brief Accesses the value of an existing key
+             *
+             * @param key Key to look up
+             * @return V& Reference to the value
+             * @throws std::out_of_range if the key is not in the map
+             *
+             * @complexity O(1) on average
+             */
+            template <typename Q = K>
+            V& get(const Q& key) {
+                V* value = find(key);
+                if (!value) {
+                    throw std::out_of_range("the key is not in the map");
+                }
+
+                return *value;
+            }
+
+            /**
+             * @brief Const version of get()
+             *
+             * @throws std::out_of_range if the key is not in the map
+             */
+            template <typename Q = K>
+            const V& get(const Q& key) const {
+                const V* value = find(key);
+                if (!value) {
+                    throw std::out_of_range("the key is not in the map");
+                }
+
+                return *value;
+            }
+
+            /**
+             * @brief Looks up a key without throwing
+             *
+             * @param key Key to look up
+             * @return V* Pointer to the value, or nullptr if the key is absent
+             *
+             * @complexity O(1) on average
+             */
+            template <typename Q = K>
+            V* find(const Q& key) {
+                size_t index = table.find(key);
+                return index == table.NOT_FOUND ? nullptr : &table.slots[index].second;
+            }
+
+            /**
+             * @brief Const version of find()
+             */
+            template <typename Q = K>
+            const V* find(const Q& key) const {
+                size_t index = table.find(key);
+                return index == table.NOT_FOUND ? nullptr : &table.slots[index].second;
+            }
+
+            /**
+             * @brief Checks if a key exists in the map
+             *
+             * @param key Key to search for
+             * @return true If the key is found
+             * @return false Otherwise
+             *
+             * @complexity O(1) on average
+             */
+            template <typename Q = K>
+            bool contains(const Q& key) const {
+                return table.find(key) != table.NOT_FOUND;
+            }
+
+            /**
+             * @brief Removes the entry of a key
+             *
+             * @param key Key to remove
+             * @return true If an entry was removed
+             * @return false If the key was not in the map
+             *
+             * @complexity O(1) on average
+             */
+            template <typename Q = K>
+            bool remove(const Q& key) {
+                size_t index = table.find(key);
+                if (index == table.NOT_FOUND) {
+                    return false;
+                }
+
+                table.erase(index);
+                return true;
+            }
+
+            /**
+             * @brief Removes all entries and keeps the allocated capacity
+             *
+             * @complexity O(capacity)
+             */
+            void clear() {
+                table.clear();
+            }
+
+            /**
+             * @brief Allocates room for a number of entries
+             *
+             * @param count Number of entries the map must hold without growing
+             *
+             * @complexity O(n) if the table is rebuilt, O(1) otherwise
+             */
+            void reserve(size_t count) {
+                table.reserve(count);
+            }
+
+            /**
+             * @brief Checks if the map is empty
+             *
+             * @complexity O(1)
+             */
+            bool isEmpty() const {
+                return table.size == 0;
+            }
+
+            /**
+             * @brief Returns the number of entries
+             *
+             * @complexity O(1)
+             */
+            size_t getSize() const {
+                return table.size;
+            }
+
+            /**
+             * @brief Returns the number of allocated slots
+             *
+             * @complexity O(1)
+             */
+            size_t getCapacity() const {
+                return table.capacity;
+            }
+
+            iterator begin() {
+                return iterator(&table, 0);
+            }
+
+            iterator end() {
+                return iterator(&table, table.capacity);
+            }
+
+            const_iterator begin() const {
+                return const_iterator(&table, 0);
+            }
+
+            const_iterator end() const {
+                return const_iterator(&table, table.capacity);
+            }
+    };
+}
@@ -0,0 +1,228 @@
+#pragma once
+
+#include <initializer_list>
+#include <iterator>
+#include <utility>
+
+#include "HashTable.h"
+
+namespace zen::corex {
+    /**
+     * @brief An unordered set of unique keys using open addressing
+     *
+     * @tparam K The key type
+     * @tparam H Hash function (defaults to zen::corex::Hash<K>)
+     * @tparam E Key equality (defaults to zen::corex::Equal<K>)
+     *
+     * HashSet is the O(1) replacement for using Array::contains() as a set
+     * lookup. It shares its Swiss-table implementation with HashMap and
+     * supports the same heterogeneous lookup for String keys.
+     *
+     * Example usage:
+     * @code
+     * zen::corex::HashSet<zen::corex::String> seen;
+     * seen.add("localhost");
+     *
+     * bool known = seen.contains(std::string_view("localhost"));  // true
+     * @endcode
+     *
+     * @note Inserting may move keys, which invalidates pointers,
+     *       references and iterators to them. Removing does not.
+     */
+    template <typename K, typename H = Hash<K>, typename E = Equal<K>>
+    class HashSet {
+        private:
+            struct KeyOf {
+                static const K& key(const K& key) {
+                    return key;
+                }
+            };
+
+            detail::HashTable<K, KeyOf, H, E> table;  ///< Underlying open-addressing table
+
+        public:
+            /**
+             * @brief Forward iterator over the keys of a HashSet
+             */
+            class Iterator {
+                private:
+                    const detail::HashTable<K, KeyOf, H, E>* table;
+                    size_t index;
+
+                public:
+                    using iterator_category = std::forward_iterator_tag;
+                    using value_type = K;
+                    using difference_type = std::ptrdiff_t;
+                    using pointer = const K*;
+                    using reference = const K&;
+
+                    Iterator() : table(nullptr), index(0) {}
+
+                    Iterator(const detail::HashTable<K, KeyOf, H, E>* table, size_t index)
+                        : table(table), index(table->next(index)) {}
+
+                    reference operator*() const {
+                        return table->slots[index];
+                    }
+
+                    pointer operator->() const {
+                        return &table->slots[index];
+                    }
+
+                    Iterator& operator++() {
+                        index = table->next(index + 1);
+                        return *this;
+                    }
+
+                    Iterator operator++(int) {
+                        Iterator previous = *this;
+                        ++*this;
+
+                        return previous;
+                    }
+
+                    bool operator==(const Iterator& other) const {
+                        return index == other.index;
+                    }
+            };
+
+            using iterator = Iterator;
+            using const_iterator = Iterator;
+
+            /**
+             * @brief Constructs an empty set
+             *
+             * No memory is allocated until the first insertion.
+             */
+            HashSet() = default;
+
+            /**
+             * @brief Constructs an empty set that allocates from a memory resource
+             *
+             * @param resource Resource for the table storage, such as an Arena or
+             *                 ObjectPool; it must outlive the set
+             */
+            explicit HashSet(std::pmr::memory_resource* resource) : table(resource) {}
+
+            /**
+             * @brief Constructs a set from a list of keys
+             *
+             * @param items Keys to insert; duplicates are ignored
+             *
+             * @complexity O(n) on average
+             */
+            HashSet(std::initializer_list<K> items) {
+                reserve(items.size());
+
+                for (const K& item : items) {
+                    add(item);
+                }
+            }
+
+            /**
+             * @brief Inserts a key
+             *
+             * @param key Key to insert
+             * @return true If the key was inserted
+             * @return false If the key was already in the set
+             *
+             * @complexity O(1) on average
+             */
+            template <typename Q = K>
+            bool add(const Q& key) {
+                if (table.find(key) != table.NOT_FOUND) {
+                    return false;
+                }
+
+                table.insertUnique(detail::makeKey<K>(key));
+                return true;
+            }
+
+            /**
+             * @brief Checks if a key exists in the set
+             *
+             * @param key Key to search for
+             * @return true If the key is found
+             * @return false Otherwise
+             *
+             * @complexity O(1) on average
+             */
+            template <typename Q = K>
+            bool contains(const Q& key) const {
+                return table.find(key) != table.NOT_FOUND;
+            }
+
+            /**
+             * @brief Removes a key
+             *
+             * @param key Key to remove
+             * @return true If the key was removed
+             * @return false If the key was not in the set
+             *
+             * @complexity O(1) on average
+             */
+            template <typename Q = K>
+            bool remove(const Q& key) {
+                size_t index = table.find(key);
+                if (index == table.NOT_FOUND) {
+                    return false;
+                }
+
+                table.erase(index);
+                return true;
+            }
+
+            /**
+             * @brief Removes all keys and keeps the allocated capacity
+             *
+             * @complexity O(capacity)
+             */
+            void clear() {
+                table.clear();
+            }
+
+            /**
+             * @brief Allocates room for a number of keys
+             *
+             * @param count Number of keys the set must hold without growing
+             */
+            void reserve(size_t count) {
+                table.reserve(count);
+            }
+
+            /**
+             * @brief Checks if the set is empty
+             *
+             * @complexity O(1)
+             */
+            bool isEmpty() const {
+                return table.size == 0;
+            }
+
+            /**
+             * @brief Returns the number of keys
+             *
+             * @complexity O(1)
+             */
+            size_t getSize() const {
+                return table.size;
+            }
+
+            /**
+             * @brief Returns the number of allocated slots
+             *
+             * @complexity O(1)
+             */
+            size_t getCapacity() const {
+                return table.capacity;
+            }
+
+            Iterator begin() const {
+                return Iterator(&table, 0);
+            }
+
+            Iterator end() const {
+                return Iterator(&table, table.capacity);
+            }
+    };
+}
@@ -0,0 +1,478 @@
+#pragma once
+
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <memory_resource>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#include "String.h"
+
+namespace zen::corex {
+    /**
+     * @brief Default hash function used by HashMap and HashSet
+     *
+     * @tparam T The key type
+     *
+     * Forwards to std::hash. Specialize it to make your own types usable
+     * as keys. The tables mix the result themselves, so identity hashes
+     * such as std::hash<int> are fine.
+     */
+    template <typename T>
+    struct Hash {
+        size_t operator()(const T& key) const {
+            return std::hash<T>()(key);
+        }
+    };
+
+    /**
+     * @brief Hash for corex::String keys with heterogeneous lookup
+     *
+     * Hashes String, std::string, std::string_view and C-strings to the same
+     * value, so a HashMap<String, V> can be searched with any of them
+     * without building a temporary String.
+     */
+    template <>
+    struct Hash<String> {
+        using is_transparent = void;
+
+        size_t operator()(std::string_view key) const {
+            return std::hash<std::string_view>()(key);
+        }
+
+        size_t operator()(const String& key) const {
+            return (*this)(std::string_view(key.toCharArray(), key.getSize()));
+        }
+
+        size_t operator()(const std::string& key) const {
+            return (*this)(std::string_view(key));
+        }
+
+        size_t operator()(const char* key) const {
+            return (*this)(std::string_view(key));
+        }
+    };
+
+    /**
+     * @brief Default key comparison used by HashMap and HashSet
+     *
+     * @tparam T The key type
+     */
+    template <typename T>
+    struct Equal {
+        bool operator()(const T& first, const T& second) const {
+            return first == second;
+        }
+    };
+
+    /**
+     * @brief Key comparison for corex::String with heterogeneous lookup
+     *
+     * Compares by length and bytes, so embedded NUL characters are handled
+     * and no temporary String is created.
+     */
+    template <>
+    struct Equal<String> {
+        using is_transparent = void;
+
+        static std::string_view view(const String& key) {
+            return std::string_view(key.toCharArray(), key.getSize());
+        }
+
+        static std::string_view view(std::string_view key) {
+            return key;
+        }
+
+        static std::string_view view(const std::string& key) {
+            return key;
+        }
+
+        static std::string_view view(const char* key) {
+            return key;
+        }
+
+        template <typename A, typename B>
+        bool operator()(const A& first, const B& second) const {
+            return view(first) == view(second);
+        }
+    };
+
+    namespace detail {
+        /** @brief Control byte of a slot that was never used */
+        constexpr int8_t CONTROL_EMPTY = -128;
+
+        /** @brief Control byte of a slot whose element was removed (tombstone) */
+        constexpr int8_t CONTROL_DELETED = -2;
+
+        /** @brief Number of control bytes inspected per probe step */
+        constexpr size_t GROUP_WIDTH = 16;
+
+        /**
+         * @brief Spreads the entropy of a hash over all 64 bits
+         *
+         * The low 7 bits become the control byte and the rest selects the
+         * probe start, so weak hashes (identity for integers) must be mixed.
+         */
+        inline uint64_t mixHash(uint64_t hash) {
+            __uint128_t product = static_cast<__uint128_t>(hash) * 0x9E3779B97F4A7C15ull;
+            return static_cast<uint64_t>(product) ^ static_cast<uint64_t>(product >> 64);
+        }
+
+        /**
+         * @brief Sixteen control bytes compared in parallel
+         *
+         * Each match function returns a bit mask where bit i refers to the
+         * i-th control byte of the group.
+         */
+        class Group {
+            private:
+#ifdef __SSE2__
+                __m128i control;
+#else
+                int8_t control[GROUP_WIDTH];
+#endif
+
+            public:
+                explicit Group(const int8_t* position) {
+#ifdef __SSE2__
+                    control = _mm_loadu_si128(reinterpret_cast<const __m128i*>(position));
+#else
+                    std::memcpy(control, position, GROUP_WIDTH);
+#endif
+                }
+
+                uint32_t match(int8_t hash) const {
+#ifdef __SSE2__
+                    return _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(hash), control));
+#else
+                    uint32_t bits = 0;
+                    for (size_t i = 0; i < GROUP_WIDTH; i++) {
+                        bits |= static_cast<uint32_t>(control[i] == hash) << i;
+                    }
+
+                    return bits;
+#endif
+                }
+
+                uint32_t matchEmpty() const {
+                    return match(CONTROL_EMPTY);
+                }
+
+                uint32_t matchEmptyOrDeleted() const {
+#ifdef __SSE2__
+                    /* Empty (-128) and deleted (-2) are the only values below -1 */
+                    return _mm_movemask_epi8(_mm_cmpgt_epi8(_mm_set1_epi8(-1), control));
+#else
+                    uint32_t bits = 0;
+                    for (size_t i = 0; i < GROUP_WIDTH; i++) {
+                        bits |= static_cast<uint32_t>(control[i] < -1) << i;
+                    }
+
+                    return bits;
+#endif
+                }
+        };
+
+        /**
+         * @brief Open-addressing table shared by HashMap and HashSet
+         *
+         * @tparam Slot Stored element (the key for sets, a key/value pair for maps)
+         * @tparam KeyOf Policy with a static key(const Slot&) accessor
+         * @tparam H Hash function
+         * @tparam E Key equality
+         *
+         * Swiss-table layout: one control byte per slot holds either the 7 low
+         * bits of the element's hash or an empty/deleted marker. Lookups load
+         * 16 control bytes at a time and compare them with one SSE2
+         * instruction, so most probes touch a single cache line of control
+         * bytes and at most one slot. The first 16 control bytes are mirrored
+         * after the end so a group never needs to wrap around.
+         *
+         * Capacity is a power of two, at least 16, and the table grows when
+         * 7/8 of it is used (removed slots included).
+         */
+        template <typename Slot, typename KeyOf, typename H, typename E>
+        class HashTable {
+            public:
+                static constexpr size_t NOT_FOUND = static_cast<size_t>(-1);
+
+                int8_t* control = nullptr;   ///< capacity + GROUP_WIDTH control bytes
+                Slot* slots = nullptr;       ///< Uninitialized storage for capacity slots
+                size_t capacity = 0;         ///< Number of slots, 0 or a power of two >= 16
+                size_t size = 0;             ///< Number of stored elements
+                size_t growthLeft = 0;       ///< Empty slots that may be filled before growing
+
+                H hasher;
+                E equal;
+
+                std::pmr::memory_resource* resource = std::pmr::get_default_resource();   ///< Source of control bytes and slots
+
+                HashTable() = default;
+
+                explicit HashTable(std::pmr::memory_resource* resource) : resource(resource) {}
+
+                HashTable(const HashTable& other) : hasher(other.hasher), equal(other.equal), resource(other.resource) {
+                    reserve(other.size);
+
+                    for (size_t i = 0; i < other.capacity; i++) {
+                        if (other.control[i] >= 0) {
+                            insertUnique(other.slots[i]);
+                        }
+                    }
+                }
+
+                HashTable(HashTable&& other) noexcept
+                    : control(other.control), slots(other.slots), capacity(other.capacity),
+                      size(other.size), growthLeft(other.growthLeft), hasher(std::move(other.hasher)),
+                      equal(std::move(other.equal)), resource(other.resource) {
+                    other.control = nullptr;
+                    other.slots = nullptr;
+                    other.capacity = other.size = other.growthLeft = 0;
+                }
+
+                HashTable& operator=(HashTable other) noexcept {
+                    std::swap(control, other.control);
+                    std::swap(slots, other.slots);
+                    std::swap(capacity, other.capacity);
+                    std::swap(size, other.size);
+                    std::swap(growthLeft, other.growthLeft);
+                    std::swap(hasher, other.hasher);
+                    std::swap(equal, other.equal);
+                    std::swap(resource, other.resource);
+
+                    return *this;
+                }
+
+                ~HashTable() {
+                    destroyAll();
+                    release();
+                }
+
+                template <typename Q>
+                size_t hashOf(const Q& key) const {
+                    return mixHash(hasher(key));
+                }
+
+                template <typename Q>
+                size_t find(const Q& key) const {
+                    if (capacity == 0) {
+                        return NOT_FOUND;
+                    }
+
+                    size_t hash = hashOf(key);
+                    int8_t fingerprint = hash & 0x7F;
+
+                    size_t mask = capacity - 1;
+                    size_t position = (hash >> 7) & mask;
+                    size_t step = 0;
+
+                    while (true) {
+                        Group group(control + position);
+
+                        for (uint32_t bits = group.match(fingerprint); bits; bits &= bits - 1) {
+                            size_t index = (position + std::countr_zero(bits)) & mask;
+
+                            if (equal(KeyOf::key(slots[index]), key)) {
+                                return index;
+                            }
+                        }
+
+                        if (group.matchEmpty()) {
+                            return NOT_FOUND;
+                        }
+
+                        /* Triangular probing visits every group of a power-of-two table */
+                        step += GROUP_WIDTH;
+                        position = (position + step) & mask;
+                    }
+                }
+
+                /**
+                 * @brief Finds the slot for a new element and marks it used
+                 *
+                 * The caller must construct the slot at the returned index.
+                 */
+                size_t prepareInsert(size_t hash) {
+                    if (growthLeft == 0) {
+                        rehash(size + 1 > capacity * 7 / 16 ? capacity * 2 : capacity);
+                    }
+
+                    size_t index = findFree(hash);
+                    if (control[index] == CONTROL_EMPTY) {
+                        growthLeft--;
+                    }
+
+                    setControl(index, hash & 0x7F);
+                    size++;
+
+                    return index;
+                }
+
+                /**
+                 * @brief Inserts a slot known not to be present
+                 */
+                template <typename... Args>
+                size_t insertUnique(Args&&... args) {
+                    Slot slot(std::forward<Args>(args)...);
+                    size_t index = prepareInsert(hashOf(KeyOf::key(slot)));
+
+                    new (&slots[index]) Slot(std::move(slot));
+                    return index;
+                }
+
+                void erase(size_t index) {
+                    slots[index].~Slot();
+                    size--;
+
+                    /*
+                     * If no run of 16 used slots passes through this slot, no probe
+                     * sequence ever continued past it and it can become empty again.
+                     */
+                    size_t mask = capacity - 1;
+                    uint32_t emptyBefore = Group(control + ((index - GROUP_WIDTH) & mask)).matchEmpty();
+                    uint32_t emptyAfter = Group(control + index).matchEmpty();
+
+                    bool reusable = emptyBefore && emptyAfter &&
+                                    std::countl_zero(static_cast<uint16_t>(emptyBefore)) +
+                                    std::countr_zero(emptyAfter) < static_cast<int>(GROUP_WIDTH);
+
+                    if (reusable) {
+                        setControl(index, CONTROL_EMPTY);
+                        growthLeft++;
+                    } else {
+                        setControl(index, CONTROL_DELETED);
+                    }
+                }
+
+                void clear() {
+                    destroyAll();
+
+                    if (capacity > 0) {
+                        std::memset(control, CONTROL_EMPTY, capacity + GROUP_WIDTH);
+                        growthLeft = capacity - capacity / 8;
+                    }
+
+                    size = 0;
+                }
+
+                void reserve(size_t count) {
+                    if (count <= size + growthLeft) {
+                        return;
+                    }
+
+                    size_t target = GROUP_WIDTH;
+                    while (target - target / 8 < count) {
+                        target *= 2;
+                    }
+
+                    rehash(std::max(target, capacity));
+                }
+
+                size_t next(size_t index) const {
+                    while (index < capacity && control[index] < 0) {
+                        index++;
+                    }
+
+                    return index;
+                }
+
+            private:
+                size_t findFree(size_t hash) const {
+                    size_t mask = capacity - 1;
+                    size_t position = (hash >> 7) & mask;
+                    size_t step = 0;
+
+                    while (true) {
+                        uint32_t bits = Group(control + position).matchEmptyOrDeleted();
+                        if (bits) {
+                            return (position + std::countr_zero(bits)) & mask;
+                        }
+
+                        step += GROUP_WIDTH;
+                        position = (position + step) & mask;
+                    }
+                }
+
+                void setControl(size_t index, int8_t value) {
+                    control[index] = value;
+
+                    if (index < GROUP_WIDTH) {
+                        control[capacity + index] = value;
+                    }
+                }
+
+                void rehash(size_t newCapacity) {
+                    newCapacity = std::max(newCapacity, GROUP_WIDTH);
+
+                    int8_t* oldControl = control;
+                    Slot* oldSlots = slots;
+                    size_t oldCapacity = capacity;
+
+                    control = static_cast<int8_t*>(resource->allocate(newCapacity + GROUP_WIDTH, GROUP_WIDTH));
+                    slots = static_cast<Slot*>(resource->allocate(sizeof(Slot) * newCapacity, alignof(Slot)));
+                    capacity = newCapacity;
+                    growthLeft = newCapacity - newCapacity / 8 - size;
+
+                    std::memset(control, CONTROL_EMPTY, newCapacity + GROUP_WIDTH);
+
+                    for (size_t i = 0; i < oldCapacity; i++) {
+                        if (oldControl[i] >= 0) {
+                            size_t hash = hashOf(KeyOf::key(oldSlots[i]));
+                            size_t index = findFree(hash);
+
+                            setControl(index, hash & 0x7F);
+                            new (&slots[index]) Slot(std::move(oldSlots[i]));
+                            oldSlots[i].~Slot();
+                        }
+                    }
+
+                    if (oldCapacity > 0) {
+                        resource->deallocate(oldControl, oldCapacity + GROUP_WIDTH, GROUP_WIDTH);
+                        resource->deallocate(oldSlots, sizeof(Slot) * oldCapacity, alignof(Slot));
+                    }
+                }
+
+                void destroyAll() {
+                    if constexpr (!std::is_trivially_destructible_v<Slot>) {
+                        for (size_t i = 0; i < capacity; i++) {
+                            if (control[i] >= 0) {
+                                slots[i].~Slot();
+                            }
+                        }
+                    }
+                }
+
+                void release() {
+                    if (capacity > 0) {
+                        resource->deallocate(control, capacity + GROUP_WIDTH, GROUP_WIDTH);
+                        resource->deallocate(slots, sizeof(Slot) * capacity, alignof(Slot));
+                    }
+                }
+        };
+
+        /**
+         * @brief Builds a key from a heterogeneous lookup argument
+         *
+         * Used when inserting with a std::string_view into a table keyed by a
+         * type that is only constructible from std::string (such as String).
+         */
+        template <typename K, typename Q>
+        K makeKey(const Q& key) {
+            if constexpr (std::is_constructible_v<K, const Q&>) {
+                return K(key);
+            } else {
+                return K(std::string(key));
+            }
+        }
+    }
+}
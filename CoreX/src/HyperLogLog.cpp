@@ -0,0 +1,61 @@
+#include "HyperLogLog.h"
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+namespace zen::corex::detail {
+    double hyperLogLogEstimate(const uint8_t* registers, size_t size) {
+        /* 2^-rank for every possible rank; ranks stay below 64 */
+        static const std::vector<double> powers = [] {
+            std::vector<double> table(64);
+
+            for (size_t rank = 0; rank < table.size(); rank++) {
+                table[rank] = std::ldexp(1.0, -static_cast<int>(rank));
+            }
+
+            return table;
+        }();
+
+        double sum = 0;
+        size_t zeros = 0;
+
+        for (size_t i = 0; i < size; i++) {
+            sum += powers[registers[i]];
+            zeros += registers[i] == 0;
+        }
+
+        double m = static_cast<double>(size);
+        double alpha = size == 16 ? 0.673 : size == 32 ? 0.697 : size == 64 ? 0.709 : 0.7213 / (1 + 1.079 / m);
+        double estimate = alpha * m * m / sum;
+
+        /* Linear counting is more accurate while many registers are still empty */
+        if (estimate <= 2.5 * m && zeros > 0) {
+            return m * std::log(m / static_cast<double>(zeros));
+        }
+
+        return estimate;
+    }
+
+    void hyperLogLogMerge(uint8_t* target, const uint8_t* source, size_t size) {
+        size_t i = 0;
+
+#if defined(__AVX2__)
+        for (; i + 32 <= size; i += 32) {
+            __m256i left = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(target + i));
+            __m256i right = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(source + i));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(target + i), _mm256_max_epu8(left, right));
+        }
+#elif defined(__SSE2__)
+        for (; i + 16 <= size; i += 16) {
+            __m128i left = _mm_loadu_si128(reinterpret_cast<const __m128i*>(target + i));
+            __m128i right = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(target + i), _mm_max_epu8(left, right));
+        }
+#endif
+
+        for (; i < size; i++) {
+            target[i] = std::max(target[i], source[i]);
+        }
+    }
+}
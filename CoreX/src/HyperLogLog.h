@@ -0,0 +1,164 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+#include "HashTable.h"
+
+namespace zen::corex {
+    namespace detail {
+        /**
+         * @brief Cardinality estimate of a set of HyperLogLog registers
+         */
+        double hyperLogLogEstimate(const uint8_t* registers, size_t size);
+
+        /**
+         * @brief Takes the maximum of two register arrays into target (16 or 32 bytes per step)
+         */
+        void hyperLogLogMerge(uint8_t* target, const uint8_t* source, size_t size);
+    }
+
+    /**
+     * @brief Approximate distinct counting in constant memory
+     *
+     * @tparam T The key type
+     * @tparam H Hash function (defaults to zen::corex::Hash<T>)
+     *
+     * HyperLogLog keeps 2^precision one-byte registers. Each key's hash
+     * selects a register with its top bits and records the position of the
+     * first set bit of the rest; the harmonic mean of the registers
+     * estimates the number of distinct keys with a standard error of
+     * 1.04 / sqrt(2^precision) (0.81% for the default 16 KiB). Small
+     * cardinalities fall back to linear counting, which is nearly exact.
+     * It offers:
+     * - add() in O(1) with no allocation
+     * - merge() of sketches filled by different threads or files, a
+     *   register-wise maximum done with SSE2/AVX2
+     *
+     * Example usage:
+     * @code
+     * zen::corex::HyperLogLog<std::string> hosts;
+     *
+     * for (const std::string& host : log) {
+     *     hosts.add(host);
+     * }
+     *
+     * cout << hosts.count() << endl;   // about the number of different hosts
+     * @endcode
+     *
+     * @note Sketches can only be merged when they have the same precision
+     *       and hash function.
+     */
+    template <typename T, typename H = Hash<T>>
+    class HyperLogLog {
+        private:
+            std::vector<uint8_t> registers;
+            unsigned int precision;
+            H hasher;
+
+            /*
+             * HyperLogLog reads the bit pattern of the whole hash, so it needs
+             * a stronger finalizer (MurmurHash3's) than the tables' mixHash:
+             * that one keeps consecutive integers evenly spaced, which skews
+             * the ranks.
+             */
+            static uint64_t scramble(uint64_t hash) {
+                hash ^= hash >> 33;
+                hash *= 0xff51afd7ed558ccdull;
+                hash ^= hash >> 33;
+                hash *= 0xc4ceb9fe1a85ec53ull;
+                hash ^= hash >> 33;
+
+                return hash;
+            }
+
+        public:
+            /**
+             * @brief Constructs an empty sketch
+             *
+             * @param precision Log2 of the number of registers, from 4 to 18
+             * @throws std::invalid_argument if the precision is out of range
+             */
+            explicit HyperLogLog(unsigned int precision = 14) : precision(precision) {
+                if (precision < 4 || precision > 18) {
+                    throw std::invalid_argument("precision must be between 4 and 18");
+                }
+
+                registers.assign(size_t(1) << precision, 0);
+            }
+
+            /**
+             * @brief Adds a key
+             *
+             * @complexity O(1)
+             */
+            template <typename Q = T>
+            void add(const Q& key) {
+                uint64_t hash = scramble(hasher(key));
+                size_t index = hash >> (64 - precision);
+
+                /* The guard bit bounds the rank when the remaining bits are all zero */
+                uint64_t rest = (hash << precision) | (uint64_t(1) << (precision - 1));
+                uint8_t rank = static_cast<uint8_t>(std::countl_zero(rest) + 1);
+
+                registers[index] = std::max(registers[index], rank);
+            }
+
+            /**
+             * @brief Estimates the number of distinct keys added
+             *
+             * @complexity O(2^precision)
+             */
+            double count() const {
+                return detail::hyperLogLogEstimate(registers.data(), registers.size());
+            }
+
+            /**
+             * @brief Adds the keys of another sketch
+             *
+             * @throws std::invalid_argument if the precisions differ
+             *
+             * @complexity O(2^precision)
+             */
+            void merge(const HyperLogLog& other) {
+                if (other.precision != precision) {
+                    throw std::invalid_argument("sketches have different precisions");
+                }
+
+                detail::hyperLogLogMerge(registers.data(), other.registers.data(), registers.size());
+            }
+
+            /**
+             * @brief Removes all keys
+             */
+            void clear() {
+                std::fill(registers.begin(), registers.end(), 0);
+            }
+
+            /**
+             * @brief Returns the expected relative standard error of count()
+             */
+            double getRelativeError() const {
+                return 1.04 / std::sqrt(static_cast<double>(registers.size()));
+            }
+
+            /**
+             * @brief Returns the precision given at construction
+             */
+            unsigned int getPrecision() const {
+                return precision;
+            }
+
+            /**
+             * @brief Returns the size of the registers in bytes
+             */
+            size_t getMemoryUsage() const {
+                return registers.size();
+            }
+    };
+}
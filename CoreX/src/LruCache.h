@@ -0,0 +1,382 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+#include "HashMap.h"
+#include "ObjectPool.h"
+#include "SpscQueue.h"
+
+namespace zen::corex {
+    /**
+     * @brief Settings of an LruCache
+     */
+    struct LruCacheOptions {
+        size_t capacity = 1024;                         ///< Total cost the cache may hold (entries when every cost is 1)
+        size_t shards = 0;                              ///< Number of independently locked shards; 0 picks 4 per hardware thread
+        std::chrono::steady_clock::duration ttl{0};     ///< Lifetime of an entry; 0 keeps entries until evicted
+    };
+
+    /**
+     * @brief Counters of an LruCache, summed over its shards
+     */
+    struct LruCacheStats {
+        uint64_t hits = 0;          ///< Lookups that found a live entry
+        uint64_t misses = 0;        ///< Lookups that found nothing or an expired entry
+        uint64_t evictions = 0;     ///< Entries dropped to make room
+        uint64_t expirations = 0;   ///< Entries dropped because their time to live had passed
+    };
+
+    /**
+     * @brief Thread-safe least-recently-used cache with lock striping
+     *
+     * @tparam K The key type
+     * @tparam V The value type
+     * @tparam H Hash function (defaults to zen::corex::Hash<K>)
+     * @tparam E Key equality (defaults to zen::corex::Equal<K>)
+     *
+     * The cache is split into shards chosen by key hash. Each shard has its
+     * own mutex, HashMap index and recency list, so threads working on
+     * different keys rarely wait for each other. get() and put() are O(1):
+     * a hash lookup plus relinking a list node. When a shard exceeds its
+     * share of the capacity, its least recently used entries are evicted.
+     * It offers:
+     * - Size-based eviction, or cost-based eviction with put(key, value, cost)
+     * - An optional time to live per cache
+     * - Hit, miss, eviction and expiration counters
+     *
+     * Example usage:
+     * @code
+     * zen::corex::LruCache<std::string, size_t> lineCounts({.capacity = 256});
+     *
+     * size_t lines = lineCounts.getOrCompute(path, [&] {
+     *     return TextFile(path).count(CountItem::LINES);
+     * });
+     * @endcode
+     *
+     * @note Values are copied out of the cache, so the lock is never held
+     *       while the caller uses them. Store a std::shared_ptr to share
+     *       large values instead of copying them.
+     */
+    template <typename K, typename V, typename H = Hash<K>, typename E = Equal<K>>
+    class LruCache {
+        private:
+            using Clock = std::chrono::steady_clock;
+
+            struct Node {
+                K key;
+                V value;
+                size_t cost;
+                Clock::time_point expiry;
+                Node* previous;     ///< Towards the most recently used end
+                Node* next;         ///< Towards the least recently used end
+            };
+
+            struct alignas(CACHE_LINE_SIZE) Shard {
+                std::mutex mutex;
+                HashMap<K, Node*, H, E> index;
+                ObjectPool<Node> nodes{64, false};  ///< The shard mutex already serializes access
+                Node* newest = nullptr;
+                Node* oldest = nullptr;
+                size_t cost = 0;
+                LruCacheStats stats;
+
+                void unlink(Node* node) {
+                    (node->previous ? node->previous->next : newest) = node->next;
+                    (node->next ? node->next->previous : oldest) = node->previous;
+                }
+
+                void pushFront(Node* node) {
+                    node->previous = nullptr;
+                    node->next = newest;
+                    (newest ? newest->previous : oldest) = node;
+                    newest = node;
+                }
+
+                void erase(Node* node) {
+                    unlink(node);
+                    index.remove(node->key);
+                    cost -= node->cost;
+                    nodes.destroy(node);
+                }
+            };
+
+            std::unique_ptr<Shard[]> shards;
+            size_t shardCount;
+            size_t shardCapacity;
+            Clock::duration ttl;
+            H hasher;
+
+            template <typename Q>
+            Shard& shardOf(const Q& key) const {
+                /* The table uses the low bits of the mixed hash, so pick shards with the high ones */
+                uint64_t hash = detail::mixHash(hasher(key));
+                return shards[(hash >> 40) % shardCount];
+            }
+
+            /* Looks a key up with the shard locked; drops it if it expired */
+            template <typename Q>
+            Node* lookup(Shard& shard, const Q& key) {
+                Node** found = shard.index.find(key);
+                if (!found) {
+                    shard.stats.misses++;
+                    return nullptr;
+                }
+
+                Node* node = *found;
+                if (ttl.count() > 0 && Clock::now() >= node->expiry) {
+                    shard.erase(node);
+                    shard.stats.misses++;
+                    shard.stats.expirations++;
+
+                    return nullptr;
+                }
+
+                shard.unlink(node);
+                shard.pushFront(node);
+                shard.stats.hits++;
+
+                return node;
+            }
+
+        public:
+            /**
+             * @brief Constructs an empty cache
+             *
+             * @param options Capacity, shard count and time to live
+             * @throws std::invalid_argument if the capacity is 0
+             */
+            explicit LruCache(const LruCacheOptions& options = {}) : ttl(options.ttl) {
+                if (options.capacity == 0) {
+                    throw std::invalid_argument("capacity must be positive");
+                }
+
+                shardCount = options.shards;
+                if (shardCount == 0) {
+                    shardCount = 4 * std::max(1u, std::thread::hardware_concurrency());
+                }
+
+                /* Small caches would evict far too early if split across many shards */
+                shardCount = std::clamp<size_t>(shardCount, 1, std::max<size_t>(1, options.capacity / 8));
+                shardCapacity = (options.capacity + shardCount - 1) / shardCount;
+                shards = std::make_unique<Shard[]>(shardCount);
+            }
+
+            LruCache(const LruCache&) = delete;
+
+            LruCache& operator=(const LruCache&) = delete;
+
+            ~LruCache() {
+                clear();
+            }
+
+            /**
+             * @brief Returns a copy of the value of a key and marks it as recently used
+             *
+             * @param key Key to look up
+             * @return std::optional<V> The value, or std::nullopt on a miss
+             *
+             * @complexity O(1) on average
+             */
+            template <typename Q = K>
+            std::optional<V> get(const Q& key) {
+                Shard& shard = shardOf(key);
+                std::lock_guard<std::mutex> lock(shard.mutex);
+
+                Node* node = lookup(shard, key);
+                return node ? std::optional<V>(node->value) : std::nullopt;
+            }
+
+            /**
+             * @brief Inserts or replaces an entry and marks it as recently used
+             *
+             * @param key Key of the entry
+             * @param value Value to store
+             * @param cost Weight of the entry against the capacity
+             * @return false If the entry alone is costlier than a shard can hold; it is
+             *         not stored and any previous entry of the key is removed, so a
+             *         later get() does not return the stale value
+             *
+             * @complexity O(1) on average, plus O(k) for k evicted entries
+             */
+            bool put(const K& key, V value, size_t cost = 1) {
+                Shard& shard = shardOf(key);
+                std::lock_guard<std::mutex> lock(shard.mutex);
+
+                Node** found = shard.index.find(key);
+                if (cost > shardCapacity) {
+                    if (found) {
+                        shard.erase(*found);
+                    }
+
+                    return false;
+                }
+
+                Node* node;
+                if (found) {
+                    node = *found;
+                    node->value = std::move(value);
+
+                    shard.cost = shard.cost - node->cost + cost;
+                    node->cost = cost;
+                    shard.unlink(node);
+                } else {
+                    node = shard.nodes.create(Node{key, std::move(value), cost, {}, nullptr, nullptr});
+
+                    try {
+                        shard.index.put(key, node);
+                    } catch (...) {
+                        /* The node is not linked yet, so returning it to the pool is enough */
+                        shard.nodes.destroy(node);
+                        throw;
+                    }
+
+                    shard.cost += cost;
+                }
+
+                node->expiry = ttl.count() > 0 ? Clock::now() + ttl : Clock::time_point::max();
+                shard.pushFront(node);
+
+                while (shard.cost > shardCapacity) {
+                    shard.erase(shard.oldest);
+                    shard.stats.evictions++;
+                }
+
+                return true;
+            }
+
+            /**
+             * @brief Returns the cached value of a key, computing and storing it on a miss
+             *
+             * The computation runs without any lock held, so two threads
+             * missing the same key at once may both compute it; the last
+             * one stored wins.
+             *
+             * @param key Key to look up
+             * @param compute Callable returning the value
+             * @param cost Weight of a newly stored entry
+             * @return V The cached or computed value
+             */
+            template <typename F>
+            V getOrCompute(const K& key, F&& compute, size_t cost = 1) {
+                if (std::optional<V> cached = get(key)) {
+                    return std::move(*cached);
+                }
+
+                V value = compute();
+                put(key, value, cost);
+
+                return value;
+            }
+
+            /**
+             * @brief Checks if a live entry exists without changing its recency
+             *
+             * @complexity O(1) on average
+             */
+            template <typename Q = K>
+            bool contains(const Q& key) const {
+                Shard& shard = shardOf(key);
+                std::lock_guard<std::mutex> lock(shard.mutex);
+
+                Node* const* found = shard.index.find(key);
+                return found && (ttl.count() == 0 || Clock::now() < (*found)->expiry);
+            }
+
+            /**
+             * @brief Removes the entry of a key
+             *
+             * @return true If an entry was removed
+             */
+            template <typename Q = K>
+            bool remove(const Q& key) {
+                Shard& shard = shardOf(key);
+                std::lock_guard<std::mutex> lock(shard.mutex);
+
+                Node** found = shard.index.find(key);
+                if (!found) {
+                    return false;
+                }
+
+                shard.erase(*found);
+                return true;
+            }
+
+            /**
+             * @brief Removes every entry; the counters are kept
+             *
+             * @complexity O(n)
+             */
+            void clear() {
+                for (size_t i = 0; i < shardCount; i++) {
+                    Shard& shard = shards[i];
+                    std::lock_guard<std::mutex> lock(shard.mutex);
+
+                    while (shard.oldest) {
+                        shard.erase(shard.oldest);
+                    }
+                }
+            }
+
+            /**
+             * @brief Returns the number of entries, expired ones included (snapshot)
+             */
+            size_t getSize() const {
+                size_t total = 0;
+
+                for (size_t i = 0; i < shardCount; i++) {
+                    std::lock_guard<std::mutex> lock(shards[i].mutex);
+                    total += shards[i].index.getSize();
+                }
+
+                return total;
+            }
+
+            /**
+             * @brief Returns the summed cost of the entries (snapshot)
+             */
+            size_t getCost() const {
+                size_t total = 0;
+
+                for (size_t i = 0; i < shardCount; i++) {
+                    std::lock_guard<std::mutex> lock(shards[i].mutex);
+                    total += shards[i].cost;
+                }
+
+                return total;
+            }
+
+            /**
+             * @brief Returns the hit, miss, eviction and expiration counters (snapshot)
+             */
+            LruCacheStats getStats() const {
+                LruCacheStats total;
+
+                for (size_t i = 0; i < shardCount; i++) {
+                    std::lock_guard<std::mutex> lock(shards[i].mutex);
+
+                    total.hits += shards[i].stats.hits;
+                    total.misses += shards[i].stats.misses;
+                    total.evictions += shards[i].stats.evictions;
+                    total.expirations += shards[i].stats.expirations;
+                }
+
+                return total;
+            }
+
+            /**
+             * @brief Returns the number of shards
+             */
+            size_t getShardCount() const {
+                return shardCount;
+            }
+    };
+}
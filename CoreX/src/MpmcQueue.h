@@ -0,0 +1,332 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+#include "SpscQueue.h"
+
+namespace zen::corex {
+    /**
+     * @brief Bounded lock-free multi-producer multi-consumer queue
+     *
+     * @tparam T The type of elements stored in the queue
+     *
+     * Dmitry Vyukov's bounded queue: every cell carries a sequence number
+     * telling whether it is ready to be written or read for the current lap
+     * of the ring, so producers and consumers only contend on their own
+     * position counter (one CAS each) and never on each other. Cells are
+     * padded to a cache line so neighbouring cells used by different threads
+     * do not false-share.
+     *
+     * Batch operations claim a whole range of positions with one CAS.
+     *
+     * A claimed cell must always be filled or emptied, otherwise the threads
+     * waiting behind it spin forever. Whatever runs after a claim therefore
+     * must not throw: popping needs a nothrow move assignment, tryPushBatch()
+     * a nothrow copy constructor, and tryEmplace() builds an element whose
+     * constructor may throw before claiming, then moves it in.
+     *
+     * Example usage:
+     * @code
+     * zen::corex::MpmcQueue<int> queue(4096);
+     *
+     * // any number of threads
+     * queue.tryPush(42);
+     *
+     * // any number of threads
+     * int value;
+     * if (queue.tryPop(value)) {
+     *     process(value);
+     * }
+     * @endcode
+     */
+    template <typename T>
+    class MpmcQueue {
+        private:
+            struct alignas(CACHE_LINE_SIZE) Cell {
+                std::atomic<size_t> sequence;
+                alignas(T) unsigned char storage[sizeof(T)];
+
+                T* value() {
+                    return std::launder(reinterpret_cast<T*>(storage));
+                }
+            };
+
+            size_t capacity;                ///< Number of cells, a power of two
+            size_t mask;                    ///< capacity - 1
+            std::unique_ptr<Cell[]> cells;
+
+            alignas(CACHE_LINE_SIZE) std::atomic<size_t> enqueuePosition{0};
+            alignas(CACHE_LINE_SIZE) std::atomic<size_t> dequeuePosition{0};
+
+            /* A claimed cell is released by a thread that is already past its CAS, so this is short */
+            static void waitFor(const Cell& cell, size_t sequence) {
+                for (int spins = 0; cell.sequence.load(std::memory_order_acquire) != sequence; spins++) {
+                    if (spins > 64) {
+                        std::this_thread::yield();
+                    }
+                }
+            }
+
+        public:
+            /**
+             * @brief Constructs an empty queue
+             *
+             * @param capacity Maximum number of queued elements, rounded up to a power of two (at least 2)
+             * @throws std::invalid_argument if capacity is 0
+             */
+            explicit MpmcQueue(size_t capacity) {
+                if (capacity == 0) {
+                    throw std::invalid_argument("capacity must be positive");
+                }
+
+                this->capacity = 2;
+                while (this->capacity < capacity) {
+                    this->capacity <<= 1;
+                }
+
+                mask = this->capacity - 1;
+                cells.reset(new Cell[this->capacity]);
+
+                for (size_t i = 0; i < this->capacity; i++) {
+                    cells[i].sequence.store(i, std::memory_order_relaxed);
+                }
+            }
+
+            MpmcQueue(const MpmcQueue&) = delete;
+
+            MpmcQueue& operator=(const MpmcQueue&) = delete;
+
+            /**
+             * @brief Destroys the queued elements
+             */
+            ~MpmcQueue() {
+                size_t end = enqueuePosition.load(std::memory_order_relaxed);
+
+                for (size_t i = dequeuePosition.load(std::memory_order_relaxed); i != end; i++) {
+                    cells[i & mask].value()->~T();
+                }
+            }
+
+            /**
+             * @brief Constructs an element in place at the back
+             *
+             * If the constructor may throw, the element is built before a
+             * cell is claimed and moved in, so an exception leaves the queue
+             * unchanged.
+             *
+             * @return true If the element was queued
+             * @return false If the queue is full
+             *
+             * @complexity O(1), lock-free
+             */
+            template <typename... Args>
+            bool tryEmplace(Args&&... args) {
+                if constexpr (!std::is_nothrow_constructible_v<T, Args...>) {
+                    static_assert(std::is_nothrow_move_constructible_v<T>, "a claimed cell must be filled without throwing");
+
+                    T element(std::forward<Args>(args)...);
+                    return tryEmplace(std::move(element));
+                }
+
+                size_t position = enqueuePosition.load(std::memory_order_relaxed);
+                Cell* cell;
+
+                while (true) {
+                    cell = &cells[position & mask];
+
+                    size_t sequence = cell->sequence.load(std::memory_order_acquire);
+                    intptr_t difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+
+                    if (difference == 0) {
+                        if (enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                            break;
+                        }
+                    } else if (difference < 0) {
+                        return false;
+                    } else {
+                        position = enqueuePosition.load(std::memory_order_relaxed);
+                    }
+                }
+
+                new (cell->storage) T(std::forward<Args>(args)...);
+                cell->sequence.store(position + 1, std::memory_order_release);
+
+                return true;
+            }
+
+            /**
+             * @brief Copies an element to the back
+             *
+             * @return false If the queue is full
+             */
+            bool tryPush(const T& input) {
+                return tryEmplace(input);
+            }
+
+            /**
+             * @brief Moves an element to the back
+             *
+             * @return false If the queue is full
+             */
+            bool tryPush(T&& input) {
+                return tryEmplace(std::move(input));
+            }
+
+            /**
+             * @brief Takes the element at the front
+             *
+             * @param output Receives the element
+             * @return false If the queue is empty
+             *
+             * @complexity O(1), lock-free
+             */
+            bool tryPop(T& output) {
+                static_assert(std::is_nothrow_move_assignable_v<T>, "a claimed cell must be emptied without throwing");
+
+                size_t position = dequeuePosition.load(std::memory_order_relaxed);
+                Cell* cell;
+
+                while (true) {
+                    cell = &cells[position & mask];
+
+                    size_t sequence = cell->sequence.load(std::memory_order_acquire);
+                    intptr_t difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position + 1);
+
+                    if (difference == 0) {
+                        if (dequeuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                            break;
+                        }
+                    } else if (difference < 0) {
+                        return false;
+                    } else {
+                        position = dequeuePosition.load(std::memory_order_relaxed);
+                    }
+                }
+
+                output = std::move(*cell->value());
+                cell->value()->~T();
+                cell->sequence.store(position + capacity, std::memory_order_release);
+
+                return true;
+            }
+
+            /**
+             * @brief Copies up to count elements to the back
+             *
+             * Claims as many consecutive positions as there is room for with a
+             * single CAS, then fills them.
+             *
+             * @param items Elements to queue
+             * @param count Number of elements in items
+             * @return Number of elements queued, from the start of items
+             */
+            size_t tryPushBatch(const T* items, size_t count) {
+                static_assert(std::is_nothrow_copy_constructible_v<T>, "a claimed cell must be filled without throwing");
+
+                size_t position = enqueuePosition.load(std::memory_order_relaxed);
+                size_t claimed;
+
+                while (true) {
+                    size_t dequeued = dequeuePosition.load(std::memory_order_acquire);
+
+                    /* A stale position can lag behind consumers; the CAS below then fails and retries */
+                    size_t used = position > dequeued ? position - dequeued : 0;
+                    size_t room = used < capacity ? capacity - used : 0;
+
+                    claimed = std::min(room, count);
+                    if (claimed == 0) {
+                        size_t current = enqueuePosition.load(std::memory_order_relaxed);
+                        if (current == position) {
+                            return 0;
+                        }
+
+                        position = current;
+                    } else if (enqueuePosition.compare_exchange_weak(position, position + claimed, std::memory_order_relaxed)) {
+                        break;
+                    }
+                }
+
+                for (size_t i = 0; i < claimed; i++) {
+                    Cell& cell = cells[(position + i) & mask];
+
+                    /* The previous occupant may still be in the middle of being popped */
+                    waitFor(cell, position + i);
+
+                    new (cell.storage) T(items[i]);
+                    cell.sequence.store(position + i + 1, std::memory_order_release);
+                }
+
+                return claimed;
+            }
+
+            /**
+             * @brief Takes up to count elements from the front
+             *
+             * @param output Destination for the elements
+             * @param count Maximum number of elements to take
+             * @return Number of elements taken
+             */
+            size_t tryPopBatch(T* output, size_t count) {
+                static_assert(std::is_nothrow_move_assignable_v<T>, "a claimed cell must be emptied without throwing");
+
+                size_t position = dequeuePosition.load(std::memory_order_relaxed);
+                size_t claimed;
+
+                do {
+                    size_t queued = enqueuePosition.load(std::memory_order_acquire) - position;
+
+                    /* position may be stale and ahead of a newer enqueue snapshot */
+                    if (static_cast<intptr_t>(queued) <= 0) {
+                        return 0;
+                    }
+
+                    claimed = std::min(queued, count);
+                } while (!dequeuePosition.compare_exchange_weak(position, position + claimed, std::memory_order_relaxed));
+
+                for (size_t i = 0; i < claimed; i++) {
+                    Cell& cell = cells[(position + i) & mask];
+
+                    /* A producer may have claimed the position but not finished writing */
+                    waitFor(cell, position + i + 1);
+
+                    output[i] = std::move(*cell.value());
+                    cell.value()->~T();
+                    cell.sequence.store(position + i + capacity, std::memory_order_release);
+                }
+
+                return claimed;
+            }
+
+            /**
+             * @brief Returns the number of queued elements (snapshot)
+             */
+            size_t getSize() const {
+                size_t dequeued = dequeuePosition.load(std::memory_order_acquire);
+                size_t enqueued = enqueuePosition.load(std::memory_order_acquire);
+
+                return enqueued > dequeued ? enqueued - dequeued : 0;
+            }
+
+            /**
+             * @brief Checks if the queue is empty (snapshot)
+             */
+            bool isEmpty() const {
+                return getSize() == 0;
+            }
+
+            /**
+             * @brief Returns the maximum number of queued elements
+             */
+            size_t getCapacity() const {
+                return capacity;
+            }
+    };
+}
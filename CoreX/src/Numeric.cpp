@@ -0,0 +1,608 @@
+#include <cstring>
+
+#include "Numeric.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define ZEN_COREX_X86 1
+#endif
+
+namespace zen::corex::detail {
+    namespace {
+        /* Blocks of at most this many elements are summed directly by pairwise summation */
+        constexpr size_t PAIRWISE_BLOCK = 256;
+
+        /* Largest chunk copied at once by fillPattern(), small enough to stay in L2 */
+        constexpr size_t FILL_CHUNK = 64 * 1024;
+
+        template <typename T, typename A>
+        A scalarSum(const T* data, size_t size) {
+            /* Four independent accumulators hide the latency of the additions */
+            A a = 0, b = 0, c = 0, d = 0;
+            size_t i = 0;
+
+            for (; i + 4 <= size; i += 4) {
+                a += data[i];
+                b += data[i + 1];
+                c += data[i + 2];
+                d += data[i + 3];
+            }
+
+            for (; i < size; i++) {
+                a += data[i];
+            }
+
+            return (a + b) + (c + d);
+        }
+
+        template <typename T>
+        T scalarKahan(const T* data, size_t size, T total = 0, T compensation = 0) {
+            for (size_t i = 0; i < size; i++) {
+                T corrected = data[i] - compensation;
+                T next = total + corrected;
+
+                compensation = (next - total) - corrected;
+                total = next;
+            }
+
+            return total;
+        }
+
+        template <typename T>
+        void scalarMinMax(const T* data, size_t size, T& min, T& max) {
+            T low = data[0];
+            T high = data[0];
+
+            for (size_t i = 1; i < size; i++) {
+                low = data[i] < low ? data[i] : low;
+                high = data[i] > high ? data[i] : high;
+            }
+
+            min = low;
+            max = high;
+        }
+
+#ifdef ZEN_COREX_X86
+        __attribute__((target("avx2"))) double sumAvx2(const double* data, size_t size) {
+            __m256d a = _mm256_setzero_pd(), b = _mm256_setzero_pd();
+            __m256d c = _mm256_setzero_pd(), d = _mm256_setzero_pd();
+            size_t i = 0;
+
+            for (; i + 16 <= size; i += 16) {
+                a = _mm256_add_pd(a, _mm256_loadu_pd(data + i));
+                b = _mm256_add_pd(b, _mm256_loadu_pd(data + i + 4));
+                c = _mm256_add_pd(c, _mm256_loadu_pd(data + i + 8));
+                d = _mm256_add_pd(d, _mm256_loadu_pd(data + i + 12));
+            }
+
+            alignas(32) double lanes[4];
+            _mm256_store_pd(lanes, _mm256_add_pd(_mm256_add_pd(a, b), _mm256_add_pd(c, d)));
+
+            return ((lanes[0] + lanes[1]) + (lanes[2] + lanes[3])) + scalarSum<double, double>(data + i, size - i);
+        }
+
+        __attribute__((target("avx2"))) float sumAvx2(const float* data, size_t size) {
+            __m256 a = _mm256_setzero_ps(), b = _mm256_setzero_ps();
+            __m256 c = _mm256_setzero_ps(), d = _mm256_setzero_ps();
+            size_t i = 0;
+
+            for (; i + 32 <= size; i += 32) {
+                a = _mm256_add_ps(a, _mm256_loadu_ps(data + i));
+                b = _mm256_add_ps(b, _mm256_loadu_ps(data + i + 8));
+                c = _mm256_add_ps(c, _mm256_loadu_ps(data + i + 16));
+                d = _mm256_add_ps(d, _mm256_loadu_ps(data + i + 24));
+            }
+
+            alignas(32) float lanes[8];
+            _mm256_store_ps(lanes, _mm256_add_ps(_mm256_add_ps(a, b), _mm256_add_ps(c, d)));
+
+            float total = 0;
+            for (float lane : lanes) {
+                total += lane;
+            }
+
+            return total + scalarSum<float, float>(data + i, size - i);
+        }
+
+        __attribute__((target("avx2"))) int64_t sumAvx2(const int32_t* data, size_t size) {
+            __m256i a = _mm256_setzero_si256(), b = _mm256_setzero_si256();
+            size_t i = 0;
+
+            /* Widen to 64 bits before adding so the sum cannot overflow */
+            for (; i + 8 <= size; i += 8) {
+                a = _mm256_add_epi64(a, _mm256_cvtepi32_epi64(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i))));
+                b = _mm256_add_epi64(b, _mm256_cvtepi32_epi64(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i + 4))));
+            }
+
+            alignas(32) int64_t lanes[4];
+            _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), _mm256_add_epi64(a, b));
+
+            return lanes[0] + lanes[1] + lanes[2] + lanes[3] + scalarSum<int32_t, int64_t>(data + i, size - i);
+        }
+
+        __attribute__((target("avx2"))) int64_t sumAvx2(const int64_t* data, size_t size) {
+            __m256i a = _mm256_setzero_si256(), b = _mm256_setzero_si256();
+            size_t i = 0;
+
+            for (; i + 8 <= size; i += 8) {
+                a = _mm256_add_epi64(a, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i)));
+                b = _mm256_add_epi64(b, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i + 4)));
+            }
+
+            alignas(32) int64_t lanes[4];
+            _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), _mm256_add_epi64(a, b));
+
+            return lanes[0] + lanes[1] + lanes[2] + lanes[3] + scalarSum<int64_t, int64_t>(data + i, size - i);
+        }
+
+        __attribute__((target("avx2"))) double kahanAvx2(const double* data, size_t size) {
+            __m256d total = _mm256_setzero_pd();
+            __m256d compensation = _mm256_setzero_pd();
+            size_t i = 0;
+
+            for (; i + 4 <= size; i += 4) {
+                __m256d corrected = _mm256_sub_pd(_mm256_loadu_pd(data + i), compensation);
+                __m256d next = _mm256_add_pd(total, corrected);
+
+                compensation = _mm256_sub_pd(_mm256_sub_pd(next, total), corrected);
+                total = next;
+            }
+
+            /* Fold the lanes with the same compensated addition, then the tail */
+            alignas(32) double sums[4];
+            alignas(32) double errors[4];
+            _mm256_store_pd(sums, total);
+            _mm256_store_pd(errors, compensation);
+
+            double terms[8];
+            for (size_t lane = 0; lane < 4; lane++) {
+                terms[lane] = sums[lane];
+                terms[lane + 4] = -errors[lane];
+            }
+
+            double result = scalarKahan(terms, 8);
+            return scalarKahan(data + i, size - i, result);
+        }
+
+        __attribute__((target("avx2"))) float kahanAvx2(const float* data, size_t size) {
+            __m256 total = _mm256_setzero_ps();
+            __m256 compensation = _mm256_setzero_ps();
+            size_t i = 0;
+
+            for (; i + 8 <= size; i += 8) {
+                __m256 corrected = _mm256_sub_ps(_mm256_loadu_ps(data + i), compensation);
+                __m256 next = _mm256_add_ps(total, corrected);
+
+                compensation = _mm256_sub_ps(_mm256_sub_ps(next, total), corrected);
+                total = next;
+            }
+
+            alignas(32) float sums[8];
+            alignas(32) float errors[8];
+            _mm256_store_ps(sums, total);
+            _mm256_store_ps(errors, compensation);
+
+            double result = 0;
+            for (size_t lane = 0; lane < 8; lane++) {
+                result += static_cast<double>(sums[lane]) - static_cast<double>(errors[lane]);
+            }
+
+            return static_cast<float>(result) + scalarKahan(data + i, size - i);
+        }
+
+        __attribute__((target("avx2"))) void minMaxAvx2(const double* data, size_t size, double& min, double& max) {
+            __m256d low = _mm256_set1_pd(data[0]);
+            __m256d high = low;
+            size_t i = 0;
+
+            for (; i + 4 <= size; i += 4) {
+                __m256d values = _mm256_loadu_pd(data + i);
+                low = _mm256_min_pd(low, values);
+                high = _mm256_max_pd(high, values);
+            }
+
+            alignas(32) double lows[4];
+            alignas(32) double highs[4];
+            _mm256_store_pd(lows, low);
+            _mm256_store_pd(highs, high);
+
+            scalarMinMax(lows, 4, min, max);
+            max = std::max(max, *std::max_element(highs, highs + 4));
+
+            for (; i < size; i++) {
+                min = std::min(min, data[i]);
+                max = std::max(max, data[i]);
+            }
+        }
+
+        __attribute__((target("avx2"))) void minMaxAvx2(const float* data, size_t size, float& min, float& max) {
+            __m256 low = _mm256_set1_ps(data[0]);
+            __m256 high = low;
+            size_t i = 0;
+
+            for (; i + 8 <= size; i += 8) {
+                __m256 values = _mm256_loadu_ps(data + i);
+                low = _mm256_min_ps(low, values);
+                high = _mm256_max_ps(high, values);
+            }
+
+            alignas(32) float lows[8];
+            alignas(32) float highs[8];
+            _mm256_store_ps(lows, low);
+            _mm256_store_ps(highs, high);
+
+            min = *std::min_element(lows, lows + 8);
+            max = *std::max_element(highs, highs + 8);
+
+            for (; i < size; i++) {
+                min = std::min(min, data[i]);
+                max = std::max(max, data[i]);
+            }
+        }
+
+        __attribute__((target("avx2"))) void minMaxAvx2(const int32_t* data, size_t size, int32_t& min, int32_t& max) {
+            __m256i low = _mm256_set1_epi32(data[0]);
+            __m256i high = low;
+            size_t i = 0;
+
+            for (; i + 8 <= size; i += 8) {
+                __m256i values = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+                low = _mm256_min_epi32(low, values);
+                high = _mm256_max_epi32(high, values);
+            }
+
+            alignas(32) int32_t lows[8];
+            alignas(32) int32_t highs[8];
+            _mm256_store_si256(reinterpret_cast<__m256i*>(lows), low);
+            _mm256_store_si256(reinterpret_cast<__m256i*>(highs), high);
+
+            min = *std::min_element(lows, lows + 8);
+            max = *std::max_element(highs, highs + 8);
+
+            for (; i < size; i++) {
+                min = std::min(min, data[i]);
+                max = std::max(max, data[i]);
+            }
+        }
+
+        __attribute__((target("avx2"))) void minMaxAvx2(const int64_t* data, size_t size, int64_t& min, int64_t& max) {
+            __m256i low = _mm256_set1_epi64x(data[0]);
+            __m256i high = low;
+            size_t i = 0;
+
+            /* AVX2 has no 64-bit min/max: compare, then blend */
+            for (; i + 4 <= size; i += 4) {
+                __m256i values = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+                low = _mm256_blendv_epi8(low, values, _mm256_cmpgt_epi64(low, values));
+                high = _mm256_blendv_epi8(high, values, _mm256_cmpgt_epi64(values, high));
+            }
+
+            alignas(32) int64_t lows[4];
+            alignas(32) int64_t highs[4];
+            _mm256_store_si256(reinterpret_cast<__m256i*>(lows), low);
+            _mm256_store_si256(reinterpret_cast<__m256i*>(highs), high);
+
+            min = *std::min_element(lows, lows + 4);
+            max = *std::max_element(highs, highs + 4);
+
+            for (; i < size; i++) {
+                min = std::min(min, data[i]);
+                max = std::max(max, data[i]);
+            }
+        }
+
+        __attribute__((target("avx2"))) void fillAvx2(char* destination, size_t bytes, const char* pattern) {
+            __m256i value = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pattern));
+            size_t i = 0;
+
+            for (; i + 128 <= bytes; i += 128) {
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(destination + i), value);
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(destination + i + 32), value);
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(destination + i + 64), value);
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(destination + i + 96), value);
+            }
+
+            for (; i + 32 <= bytes; i += 32) {
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(destination + i), value);
+            }
+
+            std::memcpy(destination + i, pattern, bytes - i);
+        }
+
+        /* Reverses the order of the objects of one size inside a 32-byte vector */
+        __attribute__((target("avx2"))) __m256i reverseVector(__m256i value, size_t size) {
+            switch (size) {
+                case 1:
+                    value = _mm256_shuffle_epi8(value, _mm256_setr_epi8(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0,
+                                                                         15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0));
+                    return _mm256_permute4x64_epi64(value, 0x4E);
+                case 2:
+                    value = _mm256_shuffle_epi8(value, _mm256_setr_epi8(14, 15, 12, 13, 10, 11, 8, 9, 6, 7, 4, 5, 2, 3, 0, 1,
+                                                                         14, 15, 12, 13, 10, 11, 8, 9, 6, 7, 4, 5, 2, 3, 0, 1));
+                    return _mm256_permute4x64_epi64(value, 0x4E);
+                case 4:
+                    return _mm256_permutevar8x32_epi32(value, _mm256_setr_epi32(7, 6, 5, 4, 3, 2, 1, 0));
+                default:
+                    return _mm256_permute4x64_epi64(value, 0x1B);
+            }
+        }
+
+        /* Swaps and reverses 32-byte blocks from both ends; returns the bytes done at each end */
+        __attribute__((target("avx2"))) size_t reverseAvx2(char* data, size_t bytes, size_t size) {
+            size_t left = 0;
+            size_t right = bytes;
+
+            while (right - left >= 64) {
+                __m256i front = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + left));
+                __m256i back = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + right - 32));
+
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(data + left), reverseVector(back, size));
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(data + right - 32), reverseVector(front, size));
+
+                left += 32;
+                right -= 32;
+            }
+
+            return left;
+        }
+
+        __attribute__((target("avx2"))) double deviationsAvx2(const double* data, size_t size, double mean) {
+            __m256d center = _mm256_set1_pd(mean);
+            __m256d a = _mm256_setzero_pd(), b = _mm256_setzero_pd();
+            size_t i = 0;
+
+            for (; i + 8 <= size; i += 8) {
+                __m256d first = _mm256_sub_pd(_mm256_loadu_pd(data + i), center);
+                __m256d second = _mm256_sub_pd(_mm256_loadu_pd(data + i + 4), center);
+                a = _mm256_add_pd(a, _mm256_mul_pd(first, first));
+                b = _mm256_add_pd(b, _mm256_mul_pd(second, second));
+            }
+
+            alignas(32) double lanes[4];
+            _mm256_store_pd(lanes, _mm256_add_pd(a, b));
+
+            return (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]) + genericSquaredDeviations(data + i, size - i, mean);
+        }
+
+        __attribute__((target("avx2"))) double deviationsAvx2(const float* data, size_t size, double mean) {
+            __m256d center = _mm256_set1_pd(mean);
+            __m256d a = _mm256_setzero_pd(), b = _mm256_setzero_pd();
+            size_t i = 0;
+
+            for (; i + 8 <= size; i += 8) {
+                __m256d first = _mm256_sub_pd(_mm256_cvtps_pd(_mm_loadu_ps(data + i)), center);
+                __m256d second = _mm256_sub_pd(_mm256_cvtps_pd(_mm_loadu_ps(data + i + 4)), center);
+                a = _mm256_add_pd(a, _mm256_mul_pd(first, first));
+                b = _mm256_add_pd(b, _mm256_mul_pd(second, second));
+            }
+
+            alignas(32) double lanes[4];
+            _mm256_store_pd(lanes, _mm256_add_pd(a, b));
+
+            return (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]) + genericSquaredDeviations(data + i, size - i, mean);
+        }
+
+        __attribute__((target("avx2"))) double deviationsAvx2(const int32_t* data, size_t size, double mean) {
+            __m256d center = _mm256_set1_pd(mean);
+            __m256d a = _mm256_setzero_pd(), b = _mm256_setzero_pd();
+            size_t i = 0;
+
+            for (; i + 8 <= size; i += 8) {
+                __m128i low = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+                __m128i high = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i + 4));
+                __m256d first = _mm256_sub_pd(_mm256_cvtepi32_pd(low), center);
+                __m256d second = _mm256_sub_pd(_mm256_cvtepi32_pd(high), center);
+                a = _mm256_add_pd(a, _mm256_mul_pd(first, first));
+                b = _mm256_add_pd(b, _mm256_mul_pd(second, second));
+            }
+
+            alignas(32) double lanes[4];
+            _mm256_store_pd(lanes, _mm256_add_pd(a, b));
+
+            return (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]) + genericSquaredDeviations(data + i, size - i, mean);
+        }
+#endif
+
+        template <typename T>
+        T fastSum(const T* data, size_t size) {
+#ifdef ZEN_COREX_X86
+            if (hasAvx2()) {
+                return sumAvx2(data, size);
+            }
+#endif
+
+            return scalarSum<T, T>(data, size);
+        }
+
+        template <typename T>
+        T pairwiseSum(const T* data, size_t size) {
+            if (size <= PAIRWISE_BLOCK) {
+                return fastSum(data, size);
+            }
+
+            /* Split on a multiple of the block size so the leaves stay full */
+            size_t half = (size / 2 + PAIRWISE_BLOCK - 1) / PAIRWISE_BLOCK * PAIRWISE_BLOCK;
+            return pairwiseSum(data, half) + pairwiseSum(data + half, size - half);
+        }
+
+        template <typename T>
+        T floatingSum(const T* data, size_t size, Summation method) {
+            switch (method) {
+                case Summation::Fast:
+                    return fastSum(data, size);
+                case Summation::Kahan:
+#ifdef ZEN_COREX_X86
+                    if (hasAvx2()) {
+                        return kahanAvx2(data, size);
+                    }
+#endif
+                    return scalarKahan(data, size);
+                default:
+                    return pairwiseSum(data, size);
+            }
+        }
+
+        template <typename T>
+        void dispatchMinMax(const T* data, size_t size, T& min, T& max) {
+#ifdef ZEN_COREX_X86
+            if (hasAvx2()) {
+                minMaxAvx2(data, size, min, max);
+                return;
+            }
+#endif
+
+            scalarMinMax(data, size, min, max);
+        }
+    }
+
+    bool hasAvx2() {
+#ifdef ZEN_COREX_X86
+        static const bool supported = __builtin_cpu_supports("avx2");
+        return supported;
+#else
+        return false;
+#endif
+    }
+
+    void fillPattern(void* destination, const void* value, size_t size, size_t count) {
+        char* output = static_cast<char*>(destination);
+        size_t bytes = size * count;
+
+        if (bytes == 0) {
+            return;
+        }
+
+        if (size == 1) {
+            std::memset(output, *static_cast<const unsigned char*>(value), count);
+            return;
+        }
+
+#ifdef ZEN_COREX_X86
+        if (32 % size == 0 && hasAvx2()) {
+            char pattern[32];
+            for (size_t i = 0; i < 32; i += size) {
+                std::memcpy(pattern + i, value, size);
+            }
+
+            fillAvx2(output, bytes, pattern);
+            return;
+        }
+#endif
+
+        /* Every chunk is a whole number of objects, so copies of the prefix stay aligned to the pattern */
+        std::memmove(output, value, size);
+
+        size_t limit = std::max(FILL_CHUNK / size, size_t(1)) * size;
+        for (size_t filled = size; filled < bytes;) {
+            size_t chunk = std::min({filled, bytes - filled, limit});
+
+            std::memcpy(output + filled, output, chunk);
+            filled += chunk;
+        }
+    }
+
+    void reverseElements(void* data, size_t size, size_t count) {
+        char* bytes = static_cast<char*>(data);
+        size_t done = 0;
+
+#ifdef ZEN_COREX_X86
+        if ((size == 1 || size == 2 || size == 4 || size == 8) && hasAvx2()) {
+            done = reverseAvx2(bytes, size * count, size) / size;
+        }
+#endif
+
+        /* Swap the remaining middle one object at a time */
+        for (size_t i = done, j = count - done; i + 1 < j; i++, j--) {
+            uint64_t first, last;
+            std::memcpy(&first, bytes + i * size, size);
+            std::memcpy(&last, bytes + (j - 1) * size, size);
+            std::memcpy(bytes + i * size, &last, size);
+            std::memcpy(bytes + (j - 1) * size, &first, size);
+        }
+    }
+
+    double simdSum(const double* data, size_t size, Summation method) {
+        return floatingSum(data, size, method);
+    }
+
+    float simdSum(const float* data, size_t size, Summation method) {
+        return floatingSum(data, size, method);
+    }
+
+    int64_t simdSum(const int32_t* data, size_t size, Summation) {
+#ifdef ZEN_COREX_X86
+        if (hasAvx2()) {
+            return sumAvx2(data, size);
+        }
+#endif
+
+        return scalarSum<int32_t, int64_t>(data, size);
+    }
+
+    int64_t simdSum(const int64_t* data, size_t size, Summation) {
+#ifdef ZEN_COREX_X86
+        if (hasAvx2()) {
+            return sumAvx2(data, size);
+        }
+#endif
+
+        /* Wrap around like the vector version instead of overflowing a signed integer */
+        uint64_t total = 0;
+        for (size_t i = 0; i < size; i++) {
+            total += static_cast<uint64_t>(data[i]);
+        }
+
+        return static_cast<int64_t>(total);
+    }
+
+    void simdMinMax(const double* data, size_t size, double& min, double& max) {
+        dispatchMinMax(data, size, min, max);
+    }
+
+    void simdMinMax(const float* data, size_t size, float& min, float& max) {
+        dispatchMinMax(data, size, min, max);
+    }
+
+    void simdMinMax(const int32_t* data, size_t size, int32_t& min, int32_t& max) {
+        dispatchMinMax(data, size, min, max);
+    }
+
+    void simdMinMax(const int64_t* data, size_t size, int64_t& min, int64_t& max) {
+        dispatchMinMax(data, size, min, max);
+    }
+
+    double simdSquaredDeviations(const double* data, size_t size, double mean) {
+#ifdef ZEN_COREX_X86
+        if (hasAvx2()) {
+            return deviationsAvx2(data, size, mean);
+        }
+#endif
+
+        return genericSquaredDeviations(data, size, mean);
+    }
+
+    double simdSquaredDeviations(const float* data, size_t size, double mean) {
+#ifdef ZEN_COREX_X86
+        if (hasAvx2()) {
+            return deviationsAvx2(data, size, mean);
+        }
+#endif
+
+        return genericSquaredDeviations(data, size, mean);
+    }
+
+    double simdSquaredDeviations(const int32_t* data, size_t size, double mean) {
+#ifdef ZEN_COREX_X86
+        if (hasAvx2()) {
+            return deviationsAvx2(data, size, mean);
+        }
+#endif
+
+        return genericSquaredDeviations(data, size, mean);
+    }
+
+    double simdSquaredDeviations(const int64_t* data, size_t size, double mean) {
+        /* AVX2 cannot convert 64-bit integers to double; the scalar loop is as fast */
+        return genericSquaredDeviations(data, size, mean);
+    }
+}
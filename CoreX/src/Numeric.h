@@ -0,0 +1,172 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+namespace zen::corex {
+    /**
+     * @brief Summation algorithm for floating-point sums
+     */
+    enum class Summation {
+        Fast,       ///< Several vector accumulators; error grows linearly with n
+        Pairwise,   ///< Fast sums of small blocks added as a tree; error grows with log n at nearly the same speed
+        Kahan       ///< Compensated summation; error independent of n, about 2x slower
+    };
+
+    /**
+     * @brief Type returned by Array<T>::sum(): T for floating point, a 64-bit integer of the same signedness otherwise
+     */
+    template <typename T>
+    using SumType = std::conditional_t<std::is_floating_point_v<T>, T,
+                                       std::conditional_t<std::is_signed_v<T>, int64_t, uint64_t>>;
+
+    namespace detail {
+        /*
+         * Vectorized kernels for the common element types. They pick the
+         * AVX2 version at run time when the CPU supports it and fall back to
+         * portable unrolled loops otherwise. Other arithmetic types use the
+         * generic templates below, which the compiler may vectorize itself.
+         */
+
+        double simdSum(const double* data, size_t size, Summation method);
+        float simdSum(const float* data, size_t size, Summation method);
+        int64_t simdSum(const int32_t* data, size_t size, Summation method);
+        int64_t simdSum(const int64_t* data, size_t size, Summation method);
+
+        void simdMinMax(const double* data, size_t size, double& min, double& max);
+        void simdMinMax(const float* data, size_t size, float& min, float& max);
+        void simdMinMax(const int32_t* data, size_t size, int32_t& min, int32_t& max);
+        void simdMinMax(const int64_t* data, size_t size, int64_t& min, int64_t& max);
+
+        /** @brief Sum of (x - mean)^2, computed in double precision */
+        double simdSquaredDeviations(const double* data, size_t size, double mean);
+        double simdSquaredDeviations(const float* data, size_t size, double mean);
+        double simdSquaredDeviations(const int32_t* data, size_t size, double mean);
+        double simdSquaredDeviations(const int64_t* data, size_t size, double mean);
+
+        /**
+         * @brief Checks if the vectorized kernels run with AVX2 on this CPU
+         */
+        bool hasAvx2();
+
+        /**
+         * @brief Fills count objects of size bytes with copies of the object at value
+         *
+         * Single bytes go to memset. Sizes dividing 32 are stored with AVX2
+         * from a repeated 32-byte pattern; anything else copies the filled
+         * prefix onto the rest in doubling chunks with memcpy. value may
+         * point into the destination.
+         */
+        void fillPattern(void* destination, const void* value, size_t size, size_t count);
+
+        /**
+         * @brief Reverses count objects of size bytes in place; size must be 1, 2, 4 or 8
+         *
+         * With AVX2, 32-byte blocks are swapped from both ends and reversed
+         * with shuffles; the middle is swapped one object at a time.
+         */
+        void reverseElements(void* data, size_t size, size_t count);
+
+        template <typename T>
+        SumType<T> genericSum(const T* data, size_t size) {
+            SumType<T> total = 0;
+
+            for (size_t i = 0; i < size; i++) {
+                total += data[i];
+            }
+
+            return total;
+        }
+
+        template <typename T>
+        void genericMinMax(const T* data, size_t size, T& min, T& max) {
+            min = max = data[0];
+
+            for (size_t i = 1; i < size; i++) {
+                min = std::min(min, data[i]);
+                max = std::max(max, data[i]);
+            }
+        }
+
+        template <typename T>
+        double genericSquaredDeviations(const T* data, size_t size, double mean) {
+            double total = 0;
+
+            for (size_t i = 0; i < size; i++) {
+                double deviation = static_cast<double>(data[i]) - mean;
+                total += deviation * deviation;
+            }
+
+            return total;
+        }
+
+        template <typename T>
+        SumType<T> sum(const T* data, size_t size, Summation method) {
+            if constexpr (requires { simdSum(data, size, method); }) {
+                return simdSum(data, size, method);
+            } else {
+                return genericSum(data, size);
+            }
+        }
+
+        template <typename T>
+        void minMax(const T* data, size_t size, T& min, T& max) {
+            if constexpr (requires { simdMinMax(data, size, min, max); }) {
+                simdMinMax(data, size, min, max);
+            } else {
+                genericMinMax(data, size, min, max);
+            }
+        }
+
+        template <typename T>
+        double squaredDeviations(const T* data, size_t size, double mean) {
+            if constexpr (requires { simdSquaredDeviations(data, size, mean); }) {
+                return simdSquaredDeviations(data, size, mean);
+            } else {
+                return genericSquaredDeviations(data, size, mean);
+            }
+        }
+
+        /**
+         * @brief Counts values into equal-width bins over [lower, upper]
+         *
+         * Four interleaved sub-histograms are filled and added at the end:
+         * consecutive values falling in the same bin would otherwise wait on
+         * each other's increment of the same counter.
+         */
+        template <typename T>
+        void histogram(const T* data, size_t size, size_t* counts, size_t bins, double lower, double upper) {
+            std::vector<size_t> partial(4 * bins, 0);
+            double scale = static_cast<double>(bins) / (upper - lower);
+
+            auto add = [&](size_t lane, T value) {
+                double position = (static_cast<double>(value) - lower) * scale;
+
+                /* Values outside [lower, upper] and NaN fail both comparisons and are skipped */
+                if (position >= 0 && position <= static_cast<double>(bins)) {
+                    size_t bin = std::min(static_cast<size_t>(position), bins - 1);
+                    partial[lane * bins + bin]++;
+                }
+            };
+
+            size_t i = 0;
+            for (; i + 4 <= size; i += 4) {
+                add(0, data[i]);
+                add(1, data[i + 1]);
+                add(2, data[i + 2]);
+                add(3, data[i + 3]);
+            }
+
+            for (; i < size; i++) {
+                add(0, data[i]);
+            }
+
+            for (size_t bin = 0; bin < bins; bin++) {
+                counts[bin] = partial[bin] + partial[bins + bin] + partial[2 * bins + bin] + partial[3 * bins + bin];
+            }
+        }
+    }
+}
@@ -0,0 +1,315 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace zen::corex {
+    /**
+     * @brief Fixed-size allocator with a free list and per-thread caches
+     *
+     * @tparam T The type of objects allocated from the pool
+     *
+     * ObjectPool carves blocks of sizeof(T) out of large slabs and recycles
+     * freed blocks through an intrusive free list, so allocating and freeing
+     * is a couple of pointer moves instead of a trip through malloc. Every
+     * thread keeps a small cache of free blocks and only touches the shared,
+     * mutex-protected list to move blocks in batches, so threads that
+     * allocate and free at the same time rarely contend.
+     *
+     * ObjectPool is also a std::pmr::memory_resource: requests that fit in
+     * one block are served from the pool, bigger ones go to the upstream
+     * resource. This lets a pool back the nodes of std::pmr::list or
+     * std::pmr::map.
+     *
+     * Example usage:
+     * @code
+     * zen::corex::ObjectPool<Order> orders;
+     *
+     * Order* order = orders.create(id, price);
+     * ...
+     * orders.destroy(order);
+     * @endcode
+     *
+     * @note Memory goes back to the system only when the pool is destroyed.
+     *       Objects still alive at that point are not destructed.
+     */
+    template <typename T>
+    class ObjectPool : public std::pmr::memory_resource {
+        private:
+            struct Node {
+                Node* next;
+            };
+
+            static constexpr size_t BLOCK_SIZE = std::max(sizeof(T), sizeof(Node));
+            static constexpr size_t BLOCK_ALIGNMENT = std::max(alignof(T), alignof(Node));
+            static constexpr size_t CACHE_LIMIT = 64;       ///< Blocks a thread keeps before giving some back
+            static constexpr size_t TRANSFER_COUNT = 32;    ///< Blocks moved per trip to the shared list
+
+            /* Outlives the pool while thread caches still point at it, so they can tell it is gone */
+            struct Shared {
+                std::mutex mutex;
+                Node* freeList = nullptr;
+                size_t slabSize;
+                std::vector<void*> slabs;
+                size_t capacity = 0;
+
+                ~Shared() {
+                    for (void* slab : slabs) {
+                        ::operator delete(slab, std::align_val_t(BLOCK_ALIGNMENT));
+                    }
+                }
+
+                /* Moves up to count blocks into a chain; the caller holds the mutex */
+                Node* take(size_t count, size_t& taken) {
+                    if (!freeList) {
+                        grow();
+                    }
+
+                    Node* head = freeList;
+                    Node* tail = head;
+                    taken = 1;
+
+                    while (taken < count && tail->next) {
+                        tail = tail->next;
+                        taken++;
+                    }
+
+                    freeList = tail->next;
+                    tail->next = nullptr;
+
+                    return head;
+                }
+
+                void grow() {
+                    char* slab = static_cast<char*>(::operator new(BLOCK_SIZE * slabSize, std::align_val_t(BLOCK_ALIGNMENT)));
+                    slabs.push_back(slab);
+                    capacity += slabSize;
+
+                    for (size_t i = slabSize; i-- > 0;) {
+                        Node* node = reinterpret_cast<Node*>(slab + i * BLOCK_SIZE);
+                        node->next = freeList;
+                        freeList = node;
+                    }
+                }
+            };
+
+            struct ThreadCache {
+                uint64_t owner;
+                std::weak_ptr<Shared> shared;
+                Node* head = nullptr;
+                size_t count = 0;
+
+                ~ThreadCache() {
+                    if (std::shared_ptr<Shared> alive = shared.lock(); alive && head) {
+                        Node* tail = head;
+                        while (tail->next) {
+                            tail = tail->next;
+                        }
+
+                        std::lock_guard<std::mutex> lock(alive->mutex);
+                        tail->next = alive->freeList;
+                        alive->freeList = head;
+                    }
+                }
+            };
+
+            static std::atomic<uint64_t>& nextId() {
+                static std::atomic<uint64_t> id{1};
+                return id;
+            }
+
+            uint64_t id;
+            bool threadCaches;
+            std::shared_ptr<Shared> shared;
+            std::pmr::memory_resource* upstream;
+
+            ThreadCache& localCache() {
+                /* Ids are never reused, so a stale entry can never be mistaken for this pool */
+                thread_local std::vector<std::unique_ptr<ThreadCache>> caches;
+                thread_local ThreadCache* last = nullptr;
+
+                if (last && last->owner == id) {
+                    return *last;
+                }
+
+                for (size_t i = 0; i < caches.size();) {
+                    if (caches[i]->owner == id) {
+                        last = caches[i].get();
+                        return *last;
+                    }
+
+                    if (caches[i]->shared.expired()) {
+                        caches[i] = std::move(caches.back());
+                        caches.pop_back();
+                    } else {
+                        i++;
+                    }
+                }
+
+                caches.push_back(std::make_unique<ThreadCache>());
+                last = caches.back().get();
+                last->owner = id;
+                last->shared = shared;
+
+                return *last;
+            }
+
+        public:
+            /**
+             * @brief Constructs an empty pool
+             *
+             * @param slabSize Number of blocks allocated at once when the pool runs dry
+             * @param threadCaches If false, every operation goes through the shared list
+             * @param upstream Resource for std::pmr requests larger than a block
+             */
+            explicit ObjectPool(size_t slabSize = 256, bool threadCaches = true,
+                                std::pmr::memory_resource* upstream = std::pmr::new_delete_resource())
+                : id(nextId().fetch_add(1, std::memory_order_relaxed)), threadCaches(threadCaches),
+                  shared(std::make_shared<Shared>()), upstream(upstream) {
+                shared->slabSize = std::max<size_t>(slabSize, 1);
+            }
+
+            ObjectPool(const ObjectPool&) = delete;
+
+            ObjectPool& operator=(const ObjectPool&) = delete;
+
+            /**
+             * @brief Takes an uninitialized block big enough for a T
+             *
+             * @complexity O(1); lock-free while the thread cache has blocks
+             */
+            void* allocate() {
+                if (!threadCaches) {
+                    std::lock_guard<std::mutex> lock(shared->mutex);
+                    size_t taken;
+
+                    return shared->take(1, taken);
+                }
+
+                ThreadCache& cache = localCache();
+
+                if (!cache.head) {
+                    std::lock_guard<std::mutex> lock(shared->mutex);
+                    cache.head = shared->take(TRANSFER_COUNT, cache.count);
+                }
+
+                Node* node = cache.head;
+                cache.head = node->next;
+                cache.count--;
+
+                return node;
+            }
+
+            /**
+             * @brief Returns a block taken with allocate()
+             *
+             * Any thread may return any block of this pool.
+             *
+             * @param block Block to return; its object must already be destroyed
+             */
+            void deallocate(void* block) {
+                Node* node = static_cast<Node*>(block);
+
+                if (!threadCaches) {
+                    std::lock_guard<std::mutex> lock(shared->mutex);
+                    node->next = shared->freeList;
+                    shared->freeList = node;
+
+                    return;
+                }
+
+                ThreadCache& cache = localCache();
+                node->next = cache.head;
+                cache.head = node;
+                cache.count++;
+
+                if (cache.count > CACHE_LIMIT) {
+                    /* Give the oldest part back so one freeing thread cannot hoard the pool */
+                    Node* tail = cache.head;
+                    for (size_t i = 1; i < CACHE_LIMIT - TRANSFER_COUNT; i++) {
+                        tail = tail->next;
+                    }
+
+                    Node* surplus = tail->next;
+                    Node* last = surplus;
+                    while (last->next) {
+                        last = last->next;
+                    }
+
+                    tail->next = nullptr;
+                    cache.count = CACHE_LIMIT - TRANSFER_COUNT;
+
+                    std::lock_guard<std::mutex> lock(shared->mutex);
+                    last->next = shared->freeList;
+                    shared->freeList = surplus;
+                }
+            }
+
+            /**
+             * @brief Allocates a block and constructs a T in it
+             *
+             * @param args Arguments forwarded to the constructor
+             * @return Pointer to the new object
+             */
+            template <typename... Args>
+            T* create(Args&&... args) {
+                void* block = allocate();
+
+                try {
+                    return new (block) T(std::forward<Args>(args)...);
+                } catch (...) {
+                    deallocate(block);
+                    throw;
+                }
+            }
+
+            /**
+             * @brief Destroys an object made by create() and returns its block
+             *
+             * @param object Object to destroy; nullptr is ignored
+             */
+            void destroy(T* object) {
+                if (object) {
+                    object->~T();
+                    deallocate(object);
+                }
+            }
+
+            /**
+             * @brief Returns the number of blocks the pool has allocated so far
+             */
+            size_t getCapacity() const {
+                std::lock_guard<std::mutex> lock(shared->mutex);
+                return shared->capacity;
+            }
+
+        protected:
+            void* do_allocate(size_t bytes, size_t alignment) override {
+                if (bytes <= BLOCK_SIZE && alignment <= BLOCK_ALIGNMENT) {
+                    return allocate();
+                }
+
+                return upstream->allocate(bytes, alignment);
+            }
+
+            void do_deallocate(void* pointer, size_t bytes, size_t alignment) override {
+                if (bytes <= BLOCK_SIZE && alignment <= BLOCK_ALIGNMENT) {
+                    deallocate(pointer);
+                } else {
+                    upstream->deallocate(pointer, bytes, alignment);
+                }
+            }
+
+            bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+                return this == &other;
+            }
+    };
+}
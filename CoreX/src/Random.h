@@ -0,0 +1,133 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <random>
+
+namespace zen::corex {
+    /**
+     * @brief A small, fast pseudo-random generator (xoshiro256**)
+     *
+     * Produces 64 random bits in a few cycles from 32 bytes of state and
+     * passes the usual statistical test suites, which makes it a good fit
+     * for shuffling, sampling and benchmarks. It satisfies
+     * std::uniform_random_bit_generator, so it also works with the
+     * <random> distributions and std::shuffle.
+     *
+     * Example usage:
+     * @code
+     * zen::corex::FastRandom random(42);
+     * numbers.shuffle(random);
+     * uint64_t die = random.nextBelow(6) + 1;
+     * @endcode
+     *
+     * @note Not suitable for cryptography. The same seed always produces the
+     *       same sequence, on every platform.
+     */
+    class FastRandom {
+        private:
+            uint64_t state[4];
+
+            static uint64_t rotateLeft(uint64_t value, int shift) {
+                return (value << shift) | (value >> (64 - shift));
+            }
+
+        public:
+            using result_type = uint64_t;
+
+            /**
+             * @brief Constructs a generator from a seed
+             *
+             * The 256-bit state is expanded from the seed with SplitMix64, so
+             * nearby seeds give unrelated sequences.
+             */
+            explicit FastRandom(uint64_t seed = 0x853c49e6748fea9bull) {
+                for (uint64_t& word : state) {
+                    seed += 0x9E3779B97F4A7C15ull;
+
+                    uint64_t mixed = seed;
+                    mixed = (mixed ^ (mixed >> 30)) * 0xBF58476D1CE4E5B9ull;
+                    mixed = (mixed ^ (mixed >> 27)) * 0x94D049BB133111EBull;
+                    word = mixed ^ (mixed >> 31);
+                }
+            }
+
+            /**
+             * @brief Returns the next 64 random bits
+             */
+            uint64_t next() {
+                uint64_t result = rotateLeft(state[1] * 5, 7) * 9;
+                uint64_t shifted = state[1] << 17;
+
+                state[2] ^= state[0];
+                state[3] ^= state[1];
+                state[1] ^= state[2];
+                state[0] ^= state[3];
+                state[2] ^= shifted;
+                state[3] = rotateLeft(state[3], 45);
+
+                return result;
+            }
+
+            /**
+             * @brief Returns a uniformly distributed integer in [0, bound)
+             *
+             * Uses Lemire's multiply-and-shift reduction, which needs no
+             * division except on the rare retry that keeps it unbiased.
+             *
+             * @param bound Exclusive upper limit; must not be 0
+             */
+            uint64_t nextBelow(uint64_t bound) {
+                __uint128_t product = static_cast<__uint128_t>(next()) * bound;
+                uint64_t low = static_cast<uint64_t>(product);
+
+                if (low < bound) {
+                    uint64_t threshold = -bound % bound;
+
+                    while (low < threshold) {
+                        product = static_cast<__uint128_t>(next()) * bound;
+                        low = static_cast<uint64_t>(product);
+                    }
+                }
+
+                return static_cast<uint64_t>(product >> 64);
+            }
+
+            /**
+             * @brief Returns a uniformly distributed double in [0, 1)
+             */
+            double nextDouble() {
+                return static_cast<double>(next() >> 11) * 0x1.0p-53;
+            }
+
+            uint64_t operator()() {
+                return next();
+            }
+
+            static constexpr uint64_t min() {
+                return 0;
+            }
+
+            static constexpr uint64_t max() {
+                return std::numeric_limits<uint64_t>::max();
+            }
+    };
+
+    namespace detail {
+        /**
+         * @brief Returns a uniformly distributed integer in [0, bound) from any generator
+         *
+         * FastRandom uses its division-free reduction; other generators go
+         * through std::uniform_int_distribution.
+         */
+        template <typename G>
+        size_t randomBelow(G& generator, size_t bound) {
+            if constexpr (requires { generator.nextBelow(bound); }) {
+                return static_cast<size_t>(generator.nextBelow(bound));
+            } else {
+                return std::uniform_int_distribution<size_t>(0, bound - 1)(generator);
+            }
+        }
+    }
+}
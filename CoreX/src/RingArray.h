@@ -0,0 +1,664 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace zen::corex {
+    /**
+     * @brief What a RingArray does when an element is pushed while it is full
+     */
+    enum class RingOverflow {
+        Grow,       ///< Double the capacity
+        Overwrite   ///< Drop the element at the opposite end (sliding window)
+    };
+
+    /**
+     * @brief A circular buffer with O(1) insertion and removal at both ends
+     *
+     * @tparam T The type of elements stored in the ring
+     *
+     * RingArray keeps its elements in a power-of-two buffer and wraps the
+     * indices with a mask, so pushing or popping at either end never moves
+     * other elements. It offers:
+     * - O(1) pushBack, pushFront, popBack and popFront
+     * - A growable mode, or a fixed mode that overwrites the oldest
+     *   element, which makes "last N items" windows trivial
+     * - The stored elements as at most two contiguous spans for bulk I/O
+     * - The query API of Array (contains, count, getSize, isEmpty)
+     *
+     * Example usage:
+     * @code
+     * zen::corex::RingArray<std::string> lastLines(100, zen::corex::RingOverflow::Overwrite);
+     *
+     * while (std::getline(file, line)) {
+     *     lastLines.pushBack(line);   // keeps only the newest 100 lines
+     * }
+     *
+     * auto [first, second] = lastLines.getSpans();
+     * @endcode
+     */
+    template <typename T>
+    class RingArray {
+        private:
+            T* data = nullptr;          ///< Uninitialized ring storage
+            size_t capacity = 0;        ///< 0 or a power of two
+            size_t head = 0;            ///< Physical index of the first element
+            size_t size = 0;            ///< Current number of elements
+            size_t limit = 0;           ///< Maximum size in Overwrite mode
+            RingOverflow overflow;
+
+            size_t physical(size_t index) const {
+                return (head + index) & (capacity - 1);
+            }
+
+            void reallocate(size_t newCapacity) {
+                T* newData = std::allocator<T>().allocate(newCapacity);
+
+                for (size_t i = 0; i < size; i++) {
+                    T& item = data[physical(i)];
+                    new (&newData[i]) T(std::move(item));
+                    item.~T();
+                }
+
+                if (data) {
+                    std::allocator<T>().deallocate(data, capacity);
+                }
+
+                data = newData;
+                capacity = newCapacity;
+                head = 0;
+            }
+
+            bool hasRoom() const {
+                return size < capacity && (overflow == RingOverflow::Grow || size < limit);
+            }
+
+            /* Makes room for one more element; false if the caller must overwrite instead */
+            bool prepareInsert() {
+                if (overflow == RingOverflow::Overwrite) {
+                    return size < limit;
+                }
+
+                if (size == capacity) {
+                    reallocate(capacity == 0 ? 8 : capacity * 2);
+                }
+
+                return true;
+            }
+
+            static size_t roundUp(size_t count) {
+                size_t result = 1;
+                while (result < count) {
+                    result <<= 1;
+                }
+
+                return result;
+            }
+
+        public:
+            /**
+             * @brief Random-access iterator from the front to the back of a RingArray
+             *
+             * @tparam Const true for const_iterator
+             */
+            template <bool Const>
+            class Iterator {
+                private:
+                    using Ring = std::conditional_t<Const, const RingArray, RingArray>;
+
+                    Ring* ring = nullptr;
+                    size_t index = 0;
+
+                public:
+                    using iterator_category = std::random_access_iterator_tag;
+                    using value_type = T;
+                    using difference_type = std::ptrdiff_t;
+                    using pointer = std::conditional_t<Const, const T*, T*>;
+                    using reference = std::conditional_t<Const, const T&, T&>;
+
+                    Iterator() = default;
+
+                    Iterator(Ring* ring, size_t index) : ring(ring), index(index) {}
+
+                    reference operator*() const {
+                        return ring->data[ring->physical(index)];
+                    }
+
+                    pointer operator->() const {
+                        return &**this;
+                    }
+
+                    reference operator[](difference_type offset) const {
+                        return *(*this + offset);
+                    }
+
+                    Iterator& operator++() {
+                        index++;
+                        return *this;
+                    }
+
+                    Iterator operator++(int) {
+                        Iterator previous = *this;
+                        index++;
+
+                        return previous;
+                    }
+
+                    Iterator& operator--() {
+                        index--;
+                        return *this;
+                    }
+
+                    Iterator operator--(int) {
+                        Iterator previous = *this;
+                        index--;
+
+                        return previous;
+                    }
+
+                    Iterator& operator+=(difference_type offset) {
+                        index += offset;
+                        return *this;
+                    }
+
+                    Iterator& operator-=(difference_type offset) {
+                        index -= offset;
+                        return *this;
+                    }
+
+                    Iterator operator+(difference_type offset) const {
+                        return Iterator(ring, index + offset);
+                    }
+
+                    friend Iterator operator+(difference_type offset, const Iterator& iterator) {
+                        return iterator + offset;
+                    }
+
+                    Iterator operator-(difference_type offset) const {
+                        return Iterator(ring, index - offset);
+                    }
+
+                    difference_type operator-(const Iterator& other) const {
+                        return static_cast<difference_type>(index) - static_cast<difference_type>(other.index);
+                    }
+
+                    bool operator==(const Iterator& other) const {
+                        return index == other.index;
+                    }
+
+                    auto operator<=>(const Iterator& other) const {
+                        return index <=> other.index;
+                    }
+            };
+
+            using iterator = Iterator<false>;
+            using const_iterator = Iterator<true>;
+
+            /**
+             * @brief Constructs an empty ring
+             *
+             * The buffer is always a power of two, but in Overwrite mode the
+             * ring holds exactly capacity elements.
+             *
+             * @param capacity Initial capacity (Grow) or window size (Overwrite); 0 allocates lazily
+             * @param overflow Behavior of a push into a full ring
+             * @throws std::invalid_argument if overflow is Overwrite and capacity is 0
+             */
+            explicit RingArray(size_t capacity = 0, RingOverflow overflow = RingOverflow::Grow)
+                : limit(capacity), overflow(overflow) {
+                if (overflow == RingOverflow::Overwrite && capacity == 0) {
+                    throw std::invalid_argument("a fixed ring array needs a positive capacity");
+                }
+
+                if (capacity > 0) {
+                    reallocate(roundUp(capacity));
+                }
+            }
+
+            /**
+             * @brief Copy constructor
+             *
+             * @complexity O(n)
+             */
+            RingArray(const RingArray& other) : limit(other.limit), overflow(other.overflow) {
+                if (other.capacity > 0) {
+                    data = std::allocator<T>().allocate(other.capacity);
+                    capacity = other.capacity;
+
+                    for (size_t i = 0; i < other.size; i++) {
+                        new (&data[i]) T(other[i]);
+                        size++;
+                    }
+                }
+            }
+
+            /**
+             * @brief Move constructor
+             *
+             * @complexity O(1)
+             */
+            RingArray(RingArray&& other) noexcept
+                : data(other.data), capacity(other.capacity), head(other.head), size(other.size),
+                  limit(other.limit), overflow(other.overflow) {
+                other.data = nullptr;
+                other.capacity = other.head = other.size = 0;
+            }
+
+            /**
+             * @brief Copy and move assignment
+             */
+            RingArray& operator=(RingArray other) noexcept {
+                std::swap(data, other.data);
+                std::swap(capacity, other.capacity);
+                std::swap(head, other.head);
+                std::swap(size, other.size);
+                std::swap(limit, other.limit);
+                std::swap(overflow, other.overflow);
+
+                return *this;
+            }
+
+            ~RingArray() {
+                clear();
+
+                if (data) {
+                    std::allocator<T>().deallocate(data, capacity);
+                }
+            }
+
+            /**
+             * @brief Accesses the element at a position counted from the front
+             *
+             * @param index Position of the element (0 is the front)
+             * @throws std::out_of_range if index is greater than or equal to size
+             *
+             * @complexity O(1)
+             */
+            T& operator[](size_t index) {
+                if (index >= size) {
+                    throw std::out_of_range("Index out of range");
+                }
+
+                return data[physical(index)];
+            }
+
+            /**
+             * @brief Const version of element access operator
+             *
+             * @throws std::out_of_range if index is greater than or equal to size
+             */
+            const T& operator[](size_t index) const {
+                if (index >= size) {
+                    throw std::out_of_range("Index out of range");
+                }
+
+                return data[physical(index)];
+            }
+
+            /**
+             * @brief Adds an element at the back
+             *
+             * In Overwrite mode a full ring drops its front element first.
+             *
+             * @complexity O(1) amortized
+             */
+            void pushBack(const T& input) {
+                emplaceBack(input);
+            }
+
+            /**
+             * @brief Moves an element to the back
+             */
+            void pushBack(T&& input) {
+                emplaceBack(std::move(input));
+            }
+
+            /**
+             * @brief Constructs an element in place at the back
+             *
+             * @return T& Reference to the new element
+             */
+            template <typename... Args>
+            T& emplaceBack(Args&&... args) {
+                if (!hasRoom()) {
+                    /* Build the element first: the arguments may refer to an element about to move or go */
+                    T value(std::forward<Args>(args)...);
+
+                    if (!prepareInsert()) {
+                        data[head].~T();
+                        head = (head + 1) & (capacity - 1);
+                        size--;
+                    }
+
+                    return emplaceBack(std::move(value));
+                }
+
+                T* slot = new (&data[physical(size)]) T(std::forward<Args>(args)...);
+                size++;
+
+                return *slot;
+            }
+
+            /**
+             * @brief Adds an element at the front
+             *
+             * In Overwrite mode a full ring drops its back element first.
+             *
+             * @complexity O(1) amortized
+             */
+            void pushFront(const T& input) {
+                emplaceFront(input);
+            }
+
+            /**
+             * @brief Moves an element to the front
+             */
+            void pushFront(T&& input) {
+                emplaceFront(std::move(input));
+            }
+
+            /**
+             * @brief Constructs an element in place at the front
+             *
+             * @return T& Reference to the new element
+             */
+            template <typename... Args>
+            T& emplaceFront(Args&&... args) {
+                if (!hasRoom()) {
+                    T value(std::forward<Args>(args)...);
+
+                    if (!prepareInsert()) {
+                        data[physical(size - 1)].~T();
+                        size--;
+                    }
+
+                    return emplaceFront(std::move(value));
+                }
+
+                size_t index = (head - 1) & (capacity - 1);
+                new (&data[index]) T(std::forward<Args>(args)...);
+
+                head = index;
+                size++;
+
+                return data[index];
+            }
+
+            /**
+             * @brief Appends count elements at the back
+             *
+             * Grows at most once. In Overwrite mode only the last capacity
+             * elements of the combined sequence are kept.
+             *
+             * @param items Elements to append
+             * @param count Number of elements in items
+             *
+             * @complexity O(count)
+             */
+            void append(const T* items, size_t count) {
+                if (overflow == RingOverflow::Grow && size + count > capacity) {
+                    reallocate(roundUp(std::max<size_t>(size + count, 8)));
+                }
+
+                for (size_t i = 0; i < count; i++) {
+                    emplaceBack(items[i]);
+                }
+            }
+
+            /**
+             * @brief Removes and returns the back element
+             *
+             * @throws std::out_of_range if the ring is empty
+             *
+             * @complexity O(1)
+             */
+            T popBack() {
+                if (size == 0) {
+                    throw std::out_of_range("the ring array is empty");
+                }
+
+                T& slot = data[physical(size - 1)];
+                T result = std::move(slot);
+
+                slot.~T();
+                size--;
+
+                return result;
+            }
+
+            /**
+             * @brief Removes and returns the front element
+             *
+             * @throws std::out_of_range if the ring is empty
+             *
+             * @complexity O(1)
+             */
+            T popFront() {
+                if (size == 0) {
+                    throw std::out_of_range("the ring array is empty");
+                }
+
+                T& slot = data[head];
+                T result = std::move(slot);
+
+                slot.~T();
+                head = (head + 1) & (capacity - 1);
+                size--;
+
+                return result;
+            }
+
+            /**
+             * @brief Drops up to count elements from the front
+             *
+             * @param count Number of elements to drop
+             * @return size_t Number of elements dropped
+             *
+             * @complexity O(count), O(1) for trivially destructible T
+             */
+            size_t dropFront(size_t count) {
+                count = std::min(count, size);
+
+                if constexpr (!std::is_trivially_destructible_v<T>) {
+                    for (size_t i = 0; i < count; i++) {
+                        data[physical(i)].~T();
+                    }
+                }
+
+                if (count > 0) {
+                    head = (head + count) & (capacity - 1);
+                    size -= count;
+                }
+
+                return count;
+            }
+
+            /**
+             * @brief Returns the front element
+             *
+             * @throws std::out_of_range if the ring is empty
+             */
+            T& front() {
+                if (size == 0) {
+                    throw std::out_of_range("the ring array is empty");
+                }
+
+                return data[head];
+            }
+
+            /**
+             * @brief Returns the back element
+             *
+             * @throws std::out_of_range if the ring is empty
+             */
+            T& back() {
+                if (size == 0) {
+                    throw std::out_of_range("the ring array is empty");
+                }
+
+                return data[physical(size - 1)];
+            }
+
+            /**
+             * @brief Returns the elements as two contiguous spans, front part first
+             *
+             * The second span is empty unless the elements wrap around the end
+             * of the buffer. Handy for writev() or memcpy-style bulk copies.
+             *
+             * @complexity O(1)
+             */
+            std::pair<std::span<T>, std::span<T>> getSpans() {
+                if (size == 0) {
+                    return {};
+                }
+
+                size_t firstLength = std::min(size, capacity - head);
+                return {std::span<T>(data + head, firstLength), std::span<T>(data, size - firstLength)};
+            }
+
+            /**
+             * @brief Const version of getSpans()
+             */
+            std::pair<std::span<const T>, std::span<const T>> getSpans() const {
+                if (size == 0) {
+                    return {};
+                }
+
+                size_t firstLength = std::min(size, capacity - head);
+                return {std::span<const T>(data + head, firstLength), std::span<const T>(data, size - firstLength)};
+            }
+
+            /**
+             * @brief Moves the elements to the start of the buffer and returns them as one span
+             *
+             * @complexity O(n) if the elements wrap, O(1) otherwise
+             */
+            std::span<T> linearize() {
+                if (head + size > capacity) {
+                    if (size == capacity) {
+                        std::rotate(data, data + head, data + capacity);
+                        head = 0;
+                    } else {
+                        /* The gap between back and front is uninitialized, so rotating is not an option */
+                        reallocate(capacity);
+                    }
+                }
+
+                return std::span<T>(data + head, size);
+            }
+
+            /**
+             * @brief Ensures room for a number of elements without growing
+             *
+             * @param count Number of elements the ring must hold
+             *
+             * @complexity O(n) if the buffer is reallocated
+             */
+            void reserve(size_t count) {
+                if (count > capacity) {
+                    reallocate(roundUp(count));
+                }
+            }
+
+            /**
+             * @brief Removes all elements and keeps the capacity
+             *
+             * @complexity O(n), O(1) for trivially destructible T
+             */
+            void clear() {
+                dropFront(size);
+                head = 0;
+            }
+
+            /**
+             * @brief Checks if an element exists in the ring
+             *
+             * @complexity O(n)
+             */
+            bool contains(const T& input) const {
+                auto [first, second] = getSpans();
+
+                return std::find(first.begin(), first.end(), input) != first.end() ||
+                       std::find(second.begin(), second.end(), input) != second.end();
+            }
+
+            /**
+             * @brief Counts occurrences of a specific element
+             *
+             * @complexity O(n)
+             */
+            size_t count(const T& key) const {
+                auto [first, second] = getSpans();
+
+                return std::count(first.begin(), first.end(), key) + std::count(second.begin(), second.end(), key);
+            }
+
+            /**
+             * @brief Checks if the ring is empty
+             */
+            bool isEmpty() const {
+                return size == 0;
+            }
+
+            /**
+             * @brief Checks if the next push would grow or overwrite
+             */
+            bool isFull() const {
+                return size == getCapacity();
+            }
+
+            /**
+             * @brief Returns the current number of elements
+             */
+            size_t getSize() const {
+                return size;
+            }
+
+            /**
+             * @brief Returns the number of elements the ring holds before growing or overwriting
+             */
+            size_t getCapacity() const {
+                return overflow == RingOverflow::Overwrite ? limit : capacity;
+            }
+
+            /**
+             * @brief Converts the ring to a std::vector, front first
+             *
+             * @complexity O(n)
+             */
+            std::vector<T> toVector() const {
+                std::vector<T> items;
+                items.reserve(size);
+
+                auto [first, second] = getSpans();
+                items.insert(items.end(), first.begin(), first.end());
+                items.insert(items.end(), second.begin(), second.end());
+
+                return items;
+            }
+
+            iterator begin() {
+                return iterator(this, 0);
+            }
+
+            iterator end() {
+                return iterator(this, size);
+            }
+
+            const_iterator begin() const {
+                return const_iterator(this, 0);
+            }
+
+            const_iterator end() const {
+                return const_iterator(this, size);
+            }
+    };
+}
@@ -0,0 +1,474 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "ThreadPool.h"
+
+namespace zen::corex {
+    namespace detail {
+        /**
+         * @brief Default number of elements per SegmentedArray chunk: about 64 KiB, a power of two
+         */
+        template <typename T>
+        constexpr size_t segmentSize() {
+            return std::bit_floor(std::max<size_t>(1, 65536 / sizeof(T)));
+        }
+    }
+
+    /**
+     * @brief A growable array made of fixed-size chunks whose elements never move
+     *
+     * @tparam T The type of elements stored in the array
+     * @tparam ChunkSize Elements per chunk, a power of two (about 64 KiB by default)
+     *
+     * SegmentedArray grows by allocating one more chunk instead of
+     * reallocating and copying everything, so appending is O(1) without
+     * the latency spikes and the temporary doubling of memory that a
+     * contiguous array suffers at multi-gigabyte sizes. Elements stay at
+     * the address they were created at until they are removed, so
+     * references and pointers to them remain valid while the array grows.
+     * It offers:
+     * - O(1) add(), emplace() and removeLast()
+     * - O(1) indexed access: a shift and a mask select chunk and slot
+     * - Chunk-wise access as contiguous spans for bulk processing
+     * - Parallel iteration with a ThreadPool, one task per group of chunks
+     *
+     * Example usage:
+     * @code
+     * zen::corex::SegmentedArray<Record> records;
+     * Record& first = records.emplace(1, "first");
+     *
+     * for (size_t i = 0; i < 100000000; i++) {
+     *     records.add(makeRecord(i));   // first stays valid
+     * }
+     *
+     * zen::corex::ThreadPool pool;
+     * records.parallelForEach(pool, [](Record& record) {
+     *     record.normalize();
+     * });
+     * @endcode
+     */
+    template <typename T, size_t ChunkSize = detail::segmentSize<T>()>
+    class SegmentedArray {
+        static_assert(std::has_single_bit(ChunkSize), "ChunkSize must be a power of two");
+
+        private:
+            static constexpr size_t SHIFT = std::countr_zero(ChunkSize);
+            static constexpr size_t MASK = ChunkSize - 1;
+
+            std::vector<T*> chunks;     ///< Uninitialized storage; the first size elements are constructed
+            size_t size = 0;
+
+            T& at(size_t index) {
+                return chunks[index >> SHIFT][index & MASK];
+            }
+
+            const T& at(size_t index) const {
+                return chunks[index >> SHIFT][index & MASK];
+            }
+
+            void checkIndex(size_t index) const {
+                if (index >= size) {
+                    throw std::out_of_range("Index out of range");
+                }
+            }
+
+            T* slotForAdd() {
+                if (size == chunks.size() * ChunkSize) {
+                    chunks.push_back(std::allocator<T>().allocate(ChunkSize));
+                }
+
+                return &chunks[size >> SHIFT][size & MASK];
+            }
+
+            void destroyFrom(size_t index) {
+                if constexpr (!std::is_trivially_destructible_v<T>) {
+                    for (size_t i = index; i < size; i++) {
+                        std::destroy_at(&at(i));
+                    }
+                }
+
+                size = index;
+            }
+
+        public:
+            /**
+             * @brief Random-access iterator over the elements
+             *
+             * @tparam Const true for const_iterator
+             */
+            template <bool Const>
+            class Iterator {
+                private:
+                    using Segmented = std::conditional_t<Const, const SegmentedArray, SegmentedArray>;
+
+                    Segmented* array = nullptr;
+                    size_t index = 0;
+
+                public:
+                    using iterator_category = std::random_access_iterator_tag;
+                    using value_type = T;
+                    using difference_type = std::ptrdiff_t;
+                    using pointer = std::conditional_t<Const, const T*, T*>;
+                    using reference = std::conditional_t<Const, const T&, T&>;
+
+                    Iterator() = default;
+
+                    Iterator(Segmented* array, size_t index) : array(array), index(index) {}
+
+                    reference operator*() const {
+                        return array->at(index);
+                    }
+
+                    pointer operator->() const {
+                        return &**this;
+                    }
+
+                    reference operator[](difference_type offset) const {
+                        return *(*this + offset);
+                    }
+
+                    Iterator& operator++() {
+                        index++;
+                        return *this;
+                    }
+
+                    Iterator operator++(int) {
+                        Iterator previous = *this;
+                        index++;
+
+                        return previous;
+                    }
+
+                    Iterator& operator--() {
+                        index--;
+                        return *this;
+                    }
+
+                    Iterator operator--(int) {
+                        Iterator previous = *this;
+                        index--;
+
+                        return previous;
+                    }
+
+                    Iterator& operator+=(difference_type offset) {
+                        index += offset;
+                        return *this;
+                    }
+
+                    Iterator& operator-=(difference_type offset) {
+                        index -= offset;
+                        return *this;
+                    }
+
+                    Iterator operator+(difference_type offset) const {
+                        return Iterator(array, index + offset);
+                    }
+
+                    friend Iterator operator+(difference_type offset, const Iterator& iterator) {
+                        return iterator + offset;
+                    }
+
+                    Iterator operator-(difference_type offset) const {
+                        return Iterator(array, index - offset);
+                    }
+
+                    difference_type operator-(const Iterator& other) const {
+                        return static_cast<difference_type>(index) - static_cast<difference_type>(other.index);
+                    }
+
+                    bool operator==(const Iterator& other) const {
+                        return index == other.index;
+                    }
+
+                    auto operator<=>(const Iterator& other) const {
+                        return index <=> other.index;
+                    }
+            };
+
+            using iterator = Iterator<false>;
+            using const_iterator = Iterator<true>;
+
+            /**
+             * @brief Constructs an empty array; no memory is allocated
+             */
+            SegmentedArray() = default;
+
+            /**
+             * @brief Copy constructor
+             *
+             * @complexity O(n)
+             */
+            SegmentedArray(const SegmentedArray& other) {
+                reserve(other.size);
+
+                for (size_t i = 0; i < other.size; i++) {
+                    new (slotForAdd()) T(other.at(i));
+                    size++;
+                }
+            }
+
+            /**
+             * @brief Move constructor
+             *
+             * @complexity O(1)
+             */
+            SegmentedArray(SegmentedArray&& other) noexcept : chunks(std::move(other.chunks)), size(other.size) {
+                other.chunks.clear();
+                other.size = 0;
+            }
+
+            /**
+             * @brief Copy and move assignment
+             */
+            SegmentedArray& operator=(SegmentedArray other) noexcept {
+                std::swap(chunks, other.chunks);
+                std::swap(size, other.size);
+
+                return *this;
+            }
+
+            ~SegmentedArray() {
+                clear();
+                shrinkToFit();
+            }
+
+            /**
+             * @brief Accesses the element at an index
+             *
+             * @throws std::out_of_range if index is greater than or equal to size
+             *
+             * @complexity O(1)
+             */
+            T& operator[](size_t index) {
+                checkIndex(index);
+                return at(index);
+            }
+
+            /**
+             * @brief Const version of element access operator
+             *
+             * @throws std::out_of_range if index is greater than or equal to size
+             */
+            const T& operator[](size_t index) const {
+                checkIndex(index);
+                return at(index);
+            }
+
+            /**
+             * @brief Adds an element at the end
+             *
+             * No existing element is moved or copied.
+             *
+             * @complexity O(1)
+             */
+            void add(const T& input) {
+                emplace(input);
+            }
+
+            /**
+             * @brief Moves an element to the end
+             */
+            void add(T&& input) {
+                emplace(std::move(input));
+            }
+
+            /**
+             * @brief Constructs an element in place at the end
+             *
+             * @return T& Reference to the new element, valid until it is removed
+             */
+            template <typename... Args>
+            T& emplace(Args&&... args) {
+                T* slot = new (slotForAdd()) T(std::forward<Args>(args)...);
+                size++;
+
+                return *slot;
+            }
+
+            /**
+             * @brief Removes the last element
+             *
+             * @throws std::out_of_range if the array is empty
+             */
+            void removeLast() {
+                if (size == 0) {
+                    throw std::out_of_range("the segmented array is empty");
+                }
+
+                destroyFrom(size - 1);
+            }
+
+            /**
+             * @brief Allocates chunks for a number of elements
+             *
+             * @complexity O(count / ChunkSize)
+             */
+            void reserve(size_t count) {
+                chunks.reserve((count + MASK) >> SHIFT);
+
+                while (chunks.size() * ChunkSize < count) {
+                    chunks.push_back(std::allocator<T>().allocate(ChunkSize));
+                }
+            }
+
+            /**
+             * @brief Removes all elements; the chunks are kept for reuse
+             *
+             * @complexity O(n) for non-trivial destructors, O(1) otherwise
+             */
+            void clear() {
+                destroyFrom(0);
+            }
+
+            /**
+             * @brief Frees the chunks that hold no element
+             */
+            void shrinkToFit() {
+                size_t used = (size + MASK) >> SHIFT;
+
+                for (size_t i = used; i < chunks.size(); i++) {
+                    std::allocator<T>().deallocate(chunks[i], ChunkSize);
+                }
+
+                chunks.resize(used);
+                chunks.shrink_to_fit();
+            }
+
+            /**
+             * @brief Returns the elements of one chunk as a contiguous span
+             *
+             * @param chunk Chunk number, below getChunkCount()
+             * @throws std::out_of_range if chunk is greater than or equal to getChunkCount()
+             */
+            std::span<T> getChunk(size_t chunk) {
+                if (chunk >= getChunkCount()) {
+                    throw std::out_of_range("Index out of range");
+                }
+
+                return std::span<T>(chunks[chunk], std::min(ChunkSize, size - (chunk << SHIFT)));
+            }
+
+            /**
+             * @brief Const version of getChunk()
+             */
+            std::span<const T> getChunk(size_t chunk) const {
+                if (chunk >= getChunkCount()) {
+                    throw std::out_of_range("Index out of range");
+                }
+
+                return std::span<const T>(chunks[chunk], std::min(ChunkSize, size - (chunk << SHIFT)));
+            }
+
+            /**
+             * @brief Returns the number of chunks holding elements
+             */
+            size_t getChunkCount() const {
+                return (size + MASK) >> SHIFT;
+            }
+
+            /**
+             * @brief Calls function(span, firstIndex) for every chunk in parallel
+             *
+             * Each chunk is handled by one task, so the function sees
+             * contiguous memory and threads never share a chunk.
+             *
+             * @param pool Pool running the tasks; the calling thread helps
+             * @param function Callable taking std::span<T> and the index of its first element
+             */
+            template <typename F>
+            void parallelForEachChunk(ThreadPool& pool, F&& function) {
+                pool.parallelFor(0, getChunkCount(), [this, &function](size_t chunk) {
+                    function(getChunk(chunk), chunk << SHIFT);
+                }, 1);
+            }
+
+            /**
+             * @brief Calls function(element) for every element in parallel
+             *
+             * @param pool Pool running the tasks; the calling thread helps
+             */
+            template <typename F>
+            void parallelForEach(ThreadPool& pool, F&& function) {
+                parallelForEachChunk(pool, [&function](std::span<T> chunk, size_t) {
+                    for (T& element : chunk) {
+                        function(element);
+                    }
+                });
+            }
+
+            /**
+             * @brief Checks if an element is in the array
+             *
+             * @complexity O(n)
+             */
+            bool contains(const T& input) const {
+                return std::find(begin(), end(), input) != end();
+            }
+
+            /**
+             * @brief Checks if the array is empty
+             */
+            bool isEmpty() const {
+                return size == 0;
+            }
+
+            /**
+             * @brief Returns the number of elements
+             */
+            size_t getSize() const {
+                return size;
+            }
+
+            /**
+             * @brief Returns the number of elements that fit in the allocated chunks
+             */
+            size_t getCapacity() const {
+                return chunks.size() * ChunkSize;
+            }
+
+            /**
+             * @brief Copies the elements into a std::vector
+             *
+             * @complexity O(n)
+             */
+            std::vector<T> toVector() const {
+                std::vector<T> result;
+                result.reserve(size);
+
+                for (size_t chunk = 0; chunk < getChunkCount(); chunk++) {
+                    std::span<const T> elements = getChunk(chunk);
+                    result.insert(result.end(), elements.begin(), elements.end());
+                }
+
+                return result;
+            }
+
+            iterator begin() {
+                return iterator(this, 0);
+            }
+
+            iterator end() {
+                return iterator(this, size);
+            }
+
+            const_iterator begin() const {
+                return const_iterator(this, 0);
+            }
+
+            const_iterator end() const {
+                return const_iterator(this, size);
+            }
+    };
+}
@@ -0,0 +1,191 @@
+#include "Serialization.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <fstream>
+#include <utility>
+
+namespace zen::corex {
+    namespace detail {
+        uint64_t checksum(const void* data, size_t bytes, uint64_t seed) {
+            const char* input = static_cast<const char*>(data);
+            uint64_t hash = seed;
+            size_t i = 0;
+
+            /* FNV-1a over 8-byte words: one multiply per word */
+            for (; i + 8 <= bytes; i += 8) {
+                uint64_t word;
+                std::memcpy(&word, input + i, 8);
+                hash = (hash ^ word) * 0x100000001b3ull;
+            }
+
+            for (; i < bytes; i++) {
+                hash = (hash ^ static_cast<unsigned char>(input[i])) * 0x100000001b3ull;
+            }
+
+            return hash;
+        }
+
+        void writeBinary(const std::string& path, BinaryHeader header, std::span<const std::span<const char>> parts) {
+            std::ofstream output(path, std::ios::binary | std::ios::trunc);
+            if (!output.is_open()) {
+                throw std::runtime_error("Failed to open file: " + path);
+            }
+
+            header.payloadSize = 0;
+            header.checksum = checksum(nullptr, 0);
+
+            for (std::span<const char> part : parts) {
+                header.payloadSize += part.size();
+                header.checksum = checksum(part.data(), part.size(), header.checksum);
+            }
+
+            output.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+            for (std::span<const char> part : parts) {
+                output.write(part.data(), part.size());
+            }
+
+            if (!output) {
+                throw std::runtime_error("Failed to write file: " + path);
+            }
+        }
+
+        void checkBinaryHeader(const BinaryHeader& header, BinaryKind kind, size_t fileSize, const std::string& path) {
+            bool valid = header.magic == BINARY_MAGIC && header.version == BINARY_VERSION && header.kind == kind &&
+                         fileSize >= sizeof(BinaryHeader) && header.payloadSize == fileSize - sizeof(BinaryHeader);
+
+            if (valid && kind == BinaryKind::Array) {
+                valid = header.elementSize > 0 && header.count <= header.payloadSize / header.elementSize &&
+                        header.count * header.elementSize == header.payloadSize;
+            } else if (valid && kind == BinaryKind::StringTable) {
+                valid = header.count < header.payloadSize / sizeof(uint64_t);
+            }
+
+            if (!valid) {
+                throw std::runtime_error("Invalid binary file: " + path);
+            }
+        }
+
+        void checkStringTable(const char* payload, const BinaryHeader& header, const std::string& path) {
+            size_t table = (header.count + 1) * sizeof(uint64_t);
+            uint64_t previous = 0;
+
+            for (size_t i = 0; i <= header.count; i++) {
+                uint64_t offset;
+                std::memcpy(&offset, payload + i * sizeof(uint64_t), sizeof(offset));
+
+                if (offset < previous || (i == 0 && offset != 0)) {
+                    throw std::runtime_error("Invalid binary file: " + path);
+                }
+
+                previous = offset;
+            }
+
+            if (previous != header.payloadSize - table) {
+                throw std::runtime_error("Invalid binary file: " + path);
+            }
+        }
+
+        std::vector<char> readBinary(const std::string& path, BinaryKind kind, BinaryHeader& header) {
+            std::ifstream input(path, std::ios::binary | std::ios::ate);
+            if (!input.is_open()) {
+                throw std::runtime_error("Failed to open file: " + path);
+            }
+
+            size_t fileSize = static_cast<size_t>(input.tellg());
+            input.seekg(0);
+
+            if (fileSize < sizeof(header) || !input.read(reinterpret_cast<char*>(&header), sizeof(header))) {
+                throw std::runtime_error("Invalid binary file: " + path);
+            }
+
+            checkBinaryHeader(header, kind, fileSize, path);
+
+            std::vector<char> payload(header.payloadSize);
+
+            if (!input.read(payload.data(), payload.size()) || checksum(payload.data(), payload.size()) != header.checksum) {
+                throw std::runtime_error("Invalid binary file: " + path);
+            }
+
+            if (kind == BinaryKind::StringTable) {
+                checkStringTable(payload.data(), header, path);
+            }
+
+            return payload;
+        }
+    }
+
+    MappedFile::MappedFile(const std::string& path) {
+        int descriptor = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (descriptor < 0) {
+            throw std::runtime_error("Failed to open file: " + path);
+        }
+
+        struct stat status;
+        if (::fstat(descriptor, &status) != 0) {
+            ::close(descriptor);
+            throw std::runtime_error("Failed to open file: " + path);
+        }
+
+        size = static_cast<size_t>(status.st_size);
+
+        if (size > 0) {
+            void* mapping = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+
+            if (mapping == MAP_FAILED) {
+                ::close(descriptor);
+                throw std::runtime_error("Failed to map file: " + path);
+            }
+
+            data = static_cast<const char*>(mapping);
+        }
+
+        /* The mapping keeps the file alive on its own */
+        ::close(descriptor);
+    }
+
+    MappedFile::MappedFile(MappedFile&& other) noexcept : data(other.data), size(other.size) {
+        other.data = nullptr;
+        other.size = 0;
+    }
+
+    MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+        std::swap(data, other.data);
+        std::swap(size, other.size);
+
+        return *this;
+    }
+
+    MappedFile::~MappedFile() {
+        if (data) {
+            ::munmap(const_cast<char*>(data), size);
+        }
+    }
+
+    MappedStringTable::MappedStringTable(const std::string& path, bool verify) : file(path) {
+        if (file.getSize() < sizeof(detail::BinaryHeader)) {
+            throw std::runtime_error("Invalid binary file: " + path);
+        }
+
+        detail::BinaryHeader header;
+        std::memcpy(&header, file.getData(), sizeof(header));
+        detail::checkBinaryHeader(header, detail::BinaryKind::StringTable, file.getSize(), path);
+
+        const char* payload = file.getData() + sizeof(header);
+
+        if (verify && detail::checksum(payload, header.payloadSize) != header.checksum) {
+            throw std::runtime_error("Invalid binary file: " + path);
+        }
+
+        /* Offsets are validated even without the checksum, so operator[] can never read outside the file */
+        detail::checkStringTable(payload, header, path);
+
+        offsets = reinterpret_cast<const uint64_t*>(payload);
+        blob = payload + (header.count + 1) * sizeof(uint64_t);
+        size = header.count;
+    }
+}
@@ -0,0 +1,295 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace zen::corex {
+    namespace detail {
+        /** @brief Signature of the binary files written by Array::save() and String::save() ("ZENB") */
+        constexpr uint32_t BINARY_MAGIC = 0x424e455a;
+
+        /** @brief Format version; readers reject other versions */
+        constexpr uint16_t BINARY_VERSION = 1;
+
+        /** @brief Payload of a binary file */
+        enum class BinaryKind : uint16_t {
+            Array = 1,          ///< count elements of elementSize bytes
+            StringTable = 2,    ///< count + 1 uint64_t offsets, then the concatenated bytes
+            String = 3          ///< The bytes of one string
+        };
+
+        /**
+         * @brief Fixed 64-byte header of a binary file
+         *
+         * The payload follows at offset 64, so once the file is mapped it is
+         * aligned for any element type. Values are stored in native byte
+         * order; a file from a machine of the other endianness fails the
+         * signature check.
+         */
+        struct BinaryHeader {
+            uint32_t magic = BINARY_MAGIC;
+            uint16_t version = BINARY_VERSION;
+            BinaryKind kind = BinaryKind::Array;
+            uint64_t elementSize = 0;
+            uint64_t count = 0;
+            uint64_t payloadSize = 0;   ///< Bytes after the header
+            uint64_t checksum = 0;      ///< checksum() of the payload
+            uint8_t reserved[24] = {};
+        };
+
+        static_assert(sizeof(BinaryHeader) == 64, "the binary header must stay 64 bytes");
+
+        /**
+         * @brief Fast 64-bit checksum for detecting truncated or corrupted files
+         *
+         * Can be chained over consecutive parts by passing the previous
+         * result as seed, as long as every part but the last is a multiple
+         * of 8 bytes long.
+         */
+        uint64_t checksum(const void* data, size_t bytes, uint64_t seed = 0xcbf29ce484222325ull);
+
+        /**
+         * @brief Writes a header and a payload made of consecutive parts
+         *
+         * Fills in the payload size and checksum of the header.
+         *
+         * @throws std::runtime_error if the file cannot be written
+         */
+        void writeBinary(const std::string& path, BinaryHeader header, std::span<const std::span<const char>> parts);
+
+        /**
+         * @brief Reads a file written by writeBinary() and checks its header and checksum
+         *
+         * @param header Receives the header
+         * @return std::vector<char> The payload
+         * @throws std::runtime_error if the file cannot be read or is invalid
+         */
+        std::vector<char> readBinary(const std::string& path, BinaryKind kind, BinaryHeader& header);
+
+        /**
+         * @brief Checks a header against the file it was read from
+         *
+         * @throws std::runtime_error if the header does not describe a valid file of this kind
+         */
+        void checkBinaryHeader(const BinaryHeader& header, BinaryKind kind, size_t fileSize, const std::string& path);
+
+        /**
+         * @brief Checks that a string table payload has ordered offsets inside the blob
+         *
+         * @throws std::runtime_error otherwise
+         */
+        void checkStringTable(const char* payload, const BinaryHeader& header, const std::string& path);
+
+        /**
+         * @brief Encodes strings as a string table payload: offsets, then the bytes
+         *
+         * @param view Callable returning the i-th string as std::string_view
+         */
+        template <typename F>
+        std::vector<char> encodeStringTable(size_t count, F&& view) {
+            std::vector<uint64_t> offsets(count + 1);
+
+            for (size_t i = 0; i < count; i++) {
+                offsets[i + 1] = offsets[i] + view(i).size();
+            }
+
+            std::vector<char> payload((count + 1) * sizeof(uint64_t) + offsets[count]);
+            std::memcpy(payload.data(), offsets.data(), offsets.size() * sizeof(uint64_t));
+
+            char* blob = payload.data() + offsets.size() * sizeof(uint64_t);
+            for (size_t i = 0; i < count; i++) {
+                std::string_view text = view(i);
+                std::memcpy(blob + offsets[i], text.data(), text.size());
+            }
+
+            return payload;
+        }
+    }
+
+    /**
+     * @brief A read-only memory mapping of a whole file
+     *
+     * The pages are loaded by the kernel on first access, so opening a
+     * large file is O(1) and unused parts are never read.
+     */
+    class MappedFile {
+        private:
+            const char* data = nullptr;
+            size_t size = 0;
+
+        public:
+            /**
+             * @brief Maps a file
+             *
+             * @throws std::runtime_error if the file cannot be opened or mapped
+             */
+            explicit MappedFile(const std::string& path);
+
+            MappedFile(MappedFile&& other) noexcept;
+
+            MappedFile& operator=(MappedFile&& other) noexcept;
+
+            MappedFile(const MappedFile&) = delete;
+
+            MappedFile& operator=(const MappedFile&) = delete;
+
+            ~MappedFile();
+
+            /**
+             * @brief Returns the first byte of the file
+             */
+            const char* getData() const {
+                return data;
+            }
+
+            /**
+             * @brief Returns the size of the file in bytes
+             */
+            size_t getSize() const {
+                return size;
+            }
+    };
+
+    /**
+     * @brief Zero-copy view of an array file written by Array<T>::save()
+     *
+     * @tparam T Trivially copyable element type, the same as when the file was saved
+     *
+     * The file is mapped into memory and the elements are used in place:
+     * opening checks the 64-byte header and, optionally, the checksum, and
+     * nothing is parsed or copied.
+     *
+     * Example usage:
+     * @code
+     * zen::corex::Array<double> prices = ...;
+     * prices.save("prices.bin");
+     *
+     * zen::corex::MappedArray<double> mapped("prices.bin");
+     * double total = std::accumulate(mapped.begin(), mapped.end(), 0.0);
+     * @endcode
+     */
+    template <typename T>
+    class MappedArray {
+        static_assert(std::is_trivially_copyable_v<T>, "MappedArray needs a trivially copyable type");
+
+        private:
+            MappedFile file;
+            const T* elements = nullptr;
+            size_t size = 0;
+
+        public:
+            /**
+             * @brief Maps an array file
+             *
+             * @param path File written by Array<T>::save()
+             * @param verify If true, the checksum is verified, which reads the whole file once
+             * @throws std::runtime_error if the file cannot be mapped or is not an array of T
+             */
+            explicit MappedArray(const std::string& path, bool verify = true) : file(path) {
+                if (file.getSize() < sizeof(detail::BinaryHeader)) {
+                    throw std::runtime_error("Invalid binary file: " + path);
+                }
+
+                detail::BinaryHeader header;
+                std::memcpy(&header, file.getData(), sizeof(header));
+                detail::checkBinaryHeader(header, detail::BinaryKind::Array, file.getSize(), path);
+
+                const char* payload = file.getData() + sizeof(header);
+
+                if (header.elementSize != sizeof(T) ||
+                    (verify && detail::checksum(payload, header.payloadSize) != header.checksum)) {
+                    throw std::runtime_error("Invalid binary file: " + path);
+                }
+
+                elements = reinterpret_cast<const T*>(payload);
+                size = header.count;
+            }
+
+            /**
+             * @brief Accesses the element at an index
+             *
+             * @throws std::out_of_range if index is greater than or equal to size
+             */
+            const T& operator[](size_t index) const {
+                if (index >= size) {
+                    throw std::out_of_range("Index out of range");
+                }
+
+                return elements[index];
+            }
+
+            /**
+             * @brief Returns the number of elements
+             */
+            size_t getSize() const {
+                return size;
+            }
+
+            /**
+             * @brief Returns the elements as a span
+             */
+            std::span<const T> getSpan() const {
+                return std::span<const T>(elements, size);
+            }
+
+            const T* begin() const {
+                return elements;
+            }
+
+            const T* end() const {
+                return elements + size;
+            }
+    };
+
+    /**
+     * @brief Zero-copy view of a string table written by Array<String>::save()
+     *
+     * Strings are stored as an offset array followed by their concatenated
+     * bytes, so each one is returned as a std::string_view into the mapped
+     * file without parsing or allocation.
+     */
+    class MappedStringTable {
+        private:
+            MappedFile file;
+            const uint64_t* offsets = nullptr;
+            const char* blob = nullptr;
+            size_t size = 0;
+
+        public:
+            /**
+             * @brief Maps a string table file
+             *
+             * @param path File written by Array<String>::save()
+             * @param verify If true, the checksum is verified, which reads the whole file once
+             * @throws std::runtime_error if the file cannot be mapped or is not a string table
+             */
+            explicit MappedStringTable(const std::string& path, bool verify = true);
+
+            /**
+             * @brief Returns the string at an index
+             *
+             * @throws std::out_of_range if index is greater than or equal to size
+             */
+            std::string_view operator[](size_t index) const {
+                if (index >= size) {
+                    throw std::out_of_range("Index out of range");
+                }
+
+                return std::string_view(blob + offsets[index], offsets[index + 1] - offsets[index]);
+            }
+
+            /**
+             * @brief Returns the number of strings
+             */
+            size_t getSize() const {
+                return size;
+            }
+    };
+}
@@ -0,0 +1,276 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace zen::corex {
+    /** @brief Assumed size of a cache line, used to keep hot atomics apart */
+    constexpr size_t CACHE_LINE_SIZE = 64;
+
+    /**
+     * @brief Bounded lock-free single-producer single-consumer queue
+     *
+     * @tparam T The type of elements stored in the queue
+     *
+     * A ring buffer where exactly one thread pushes and exactly one thread
+     * pops. The producer and consumer indices live on separate cache lines
+     * and each side keeps a cached copy of the other side's index, so in
+     * steady state a push or pop touches no cache line owned by the other
+     * thread. Batch operations publish many elements with a single atomic
+     * store.
+     *
+     * Example usage:
+     * @code
+     * zen::corex::SpscQueue<std::string> lines(1024);
+     *
+     * std::thread producer([&] { lines.tryPush("first line"); });
+     *
+     * std::string line;
+     * while (!lines.tryPop(line)) {
+     * }
+     * @endcode
+     *
+     * @note Calling push functions from more than one thread, or pop
+     *       functions from more than one thread, is undefined behavior.
+     *       Use MpmcQueue for that.
+     */
+    template <typename T>
+    class SpscQueue {
+        private:
+            size_t capacity;                ///< Number of slots, a power of two
+            size_t mask;                    ///< capacity - 1
+            T* slots;                       ///< Uninitialized ring storage
+
+            alignas(CACHE_LINE_SIZE) std::atomic<size_t> tail{0};   ///< Next position to write (producer)
+            size_t cachedHead = 0;                                  ///< Producer's last view of head
+
+            alignas(CACHE_LINE_SIZE) std::atomic<size_t> head{0};   ///< Next position to read (consumer)
+            size_t cachedTail = 0;                                  ///< Consumer's last view of tail
+
+            size_t freeSlots(size_t position) {
+                if (position - cachedHead >= capacity) {
+                    cachedHead = head.load(std::memory_order_acquire);
+                }
+
+                return capacity - (position - cachedHead);
+            }
+
+            size_t readySlots(size_t position) {
+                if (cachedTail == position) {
+                    cachedTail = tail.load(std::memory_order_acquire);
+                }
+
+                return cachedTail - position;
+            }
+
+        public:
+            /**
+             * @brief Constructs an empty queue
+             *
+             * @param capacity Maximum number of queued elements, rounded up to a power of two
+             * @throws std::invalid_argument if capacity is 0
+             */
+            explicit SpscQueue(size_t capacity) {
+                if (capacity == 0) {
+                    throw std::invalid_argument("capacity must be positive");
+                }
+
+                this->capacity = 1;
+                while (this->capacity < capacity) {
+                    this->capacity <<= 1;
+                }
+
+                mask = this->capacity - 1;
+                slots = std::allocator<T>().allocate(this->capacity);
+            }
+
+            SpscQueue(const SpscQueue&) = delete;
+
+            SpscQueue& operator=(const SpscQueue&) = delete;
+
+            /**
+             * @brief Destroys the queued elements and releases the ring
+             */
+            ~SpscQueue() {
+                size_t end = tail.load(std::memory_order_relaxed);
+
+                for (size_t i = head.load(std::memory_order_relaxed); i != end; i++) {
+                    slots[i & mask].~T();
+                }
+
+                std::allocator<T>().deallocate(slots, capacity);
+            }
+
+            /**
+             * @brief Constructs an element in place at the back (producer only)
+             *
+             * @return true If the element was queued
+             * @return false If the queue is full
+             *
+             * @complexity O(1), wait-free
+             */
+            template <typename... Args>
+            bool tryEmplace(Args&&... args) {
+                size_t position = tail.load(std::memory_order_relaxed);
+                if (freeSlots(position) == 0) {
+                    return false;
+                }
+
+                new (&slots[position & mask]) T(std::forward<Args>(args)...);
+                tail.store(position + 1, std::memory_order_release);
+
+                return true;
+            }
+
+            /**
+             * @brief Copies an element to the back (producer only)
+             *
+             * @return false If the queue is full
+             */
+            bool tryPush(const T& input) {
+                return tryEmplace(input);
+            }
+
+            /**
+             * @brief Moves an element to the back (producer only)
+             *
+             * @return false If the queue is full
+             */
+            bool tryPush(T&& input) {
+                return tryEmplace(std::move(input));
+            }
+
+            /**
+             * @brief Takes the element at the front (consumer only)
+             *
+             * @param output Receives the element
+             * @return false If the queue is empty
+             *
+             * @complexity O(1), wait-free
+             */
+            bool tryPop(T& output) {
+                size_t position = head.load(std::memory_order_relaxed);
+                if (readySlots(position) == 0) {
+                    return false;
+                }
+
+                T& slot = slots[position & mask];
+                output = std::move(slot);
+                slot.~T();
+
+                head.store(position + 1, std::memory_order_release);
+                return true;
+            }
+
+            /**
+             * @brief Copies up to count elements to the back (producer only)
+             *
+             * @param items Elements to queue
+             * @param count Number of elements in items
+             * @return Number of elements queued, from the start of items
+             *
+             * If a copy throws, none of the batch is queued.
+             *
+             * @complexity O(k) for k queued elements, one release store
+             */
+            size_t tryPushBatch(const T* items, size_t count) {
+                size_t position = tail.load(std::memory_order_relaxed);
+                size_t room = freeSlots(position);
+
+                if (room < count) {
+                    /* The cached head may be stale; refresh it once before giving up on the rest */
+                    cachedHead = head.load(std::memory_order_acquire);
+                    room = capacity - (position - cachedHead);
+                }
+
+                size_t pushed = std::min(room, count);
+                size_t i = 0;
+
+                try {
+                    for (; i < pushed; i++) {
+                        new (&slots[(position + i) & mask]) T(items[i]);
+                    }
+                } catch (...) {
+                    /* Nothing is published yet, so undo the copies made so far */
+                    while (i > 0) {
+                        slots[(position + --i) & mask].~T();
+                    }
+
+                    throw;
+                }
+
+                tail.store(position + pushed, std::memory_order_release);
+                return pushed;
+            }
+
+            /**
+             * @brief Takes up to count elements from the front (consumer only)
+             *
+             * @param output Destination for the elements
+             * @param count Maximum number of elements to take
+             * @return Number of elements taken
+             *
+             * If a move throws, the elements before it stay taken and the
+             * rest remain queued.
+             *
+             * @complexity O(k) for k taken elements, one release store
+             */
+            size_t tryPopBatch(T* output, size_t count) {
+                size_t position = head.load(std::memory_order_relaxed);
+                size_t ready = readySlots(position);
+
+                if (ready < count) {
+                    cachedTail = tail.load(std::memory_order_acquire);
+                    ready = cachedTail - position;
+                }
+
+                size_t popped = std::min(ready, count);
+                size_t i = 0;
+
+                try {
+                    for (; i < popped; i++) {
+                        T& slot = slots[(position + i) & mask];
+                        output[i] = std::move(slot);
+                        slot.~T();
+                    }
+                } catch (...) {
+                    /* The elements already taken are destroyed; release their slots */
+                    head.store(position + i, std::memory_order_release);
+                    throw;
+                }
+
+                head.store(position + popped, std::memory_order_release);
+                return popped;
+            }
+
+            /**
+             * @brief Returns the number of queued elements
+             *
+             * Exact when called from the producer or consumer with the other
+             * side idle; a snapshot otherwise.
+             */
+            size_t getSize() const {
+                return tail.load(std::memory_order_acquire) - head.load(std::memory_order_acquire);
+            }
+
+            /**
+             * @brief Checks if the queue is empty (snapshot)
+             */
+            bool isEmpty() const {
+                return getSize() == 0;
+            }
+
+            /**
+             * @brief Returns the maximum number of queued elements
+             */
+            size_t getCapacity() const {
+                return capacity;
+            }
+    };
+}
@@ -1,6 +1,26 @@
 #include "String.h"
 
+#include <algorithm>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#include "Serialization.h"
+
 namespace zen::corex {
+    namespace {
+        /* Lexicographic order of two byte ranges, bytes compared as unsigned like std::string */
+        std::strong_ordering compareBytes(const char* first, size_t firstSize, const char* second, size_t secondSize) {
+            size_t common = std::min(firstSize, secondSize);
+            int result = common == 0 ? 0 : memcmp(first, second, common);
+
+            if (result != 0) {
+                return result < 0 ? std::strong_ordering::less : std::strong_ordering::greater;
+            }
+
+            return firstSize <=> secondSize;
+        }
+    }
 
     void String::initialize(const std::string& input) {
         if (input.empty()) {
@@ -8,6 +28,7 @@ namespace zen::corex {
             capacity = DEFAULT_CAPACITY;
 
             data = new char[DEFAULT_CAPACITY];
+            data[0] = '\0';
         } else {
             size = input.length();
 
@@ -40,24 +61,28 @@ namespace zen::corex {
     }
 
     String::~String() {
-        delete data;
+        delete [] data;
+    }
+
+    void String::swap(String& other) noexcept {
+        std::swap(data, other.data);
+        std::swap(size, other.size);
+        std::swap(capacity, other.capacity);
     }
 
     String& String::operator=(const String& input) {
-        if (this == &input || input.isEmpty() == 0) {
+        if (this == &input) {
             return *this;
         }
 
-        initialize(input.toString());
+        String copy(input);
+        swap(copy);
         return *this;
     }
 
     String& String::operator=(const std::string& input) {
-        if (input.empty()) {
-            return *this;
-        }
-
-        initialize(input);
+        String copy(input);
+        swap(copy);
         return *this;
     }
 
@@ -66,7 +91,9 @@ namespace zen::corex {
             return *this;
         }
 
-        initialize(std::string(input));
+        /* The copy is made before the old buffer is released, so input may point into it */
+        String copy(input);
+        swap(copy);
         return *this;
     }
 
@@ -117,7 +144,7 @@ namespace zen::corex {
             return false;
         }
     
-        return strcmp(data, input.data) == 0;
+        return size == 0 || memcmp(data, input.data, size) == 0;
     }
 
     bool String::operator==(const std::string& input) const {
@@ -125,7 +152,7 @@ namespace zen::corex {
             return input.empty();
         }
     
-        return input == data; 
+        return input.size() == size && (size == 0 || memcmp(data, input.data(), size) == 0);
     }
 
     bool String::operator==(const char* input) const {
@@ -148,6 +175,18 @@ namespace zen::corex {
         return !(*this == input);
     }
 
+    std::strong_ordering String::operator<=>(const String& input) const {
+        return compareBytes(data, size, input.data, input.size);
+    }
+
+    std::strong_ordering String::operator<=>(const std::string& input) const {
+        return compareBytes(data, size, input.data(), input.size());
+    }
+
+    std::strong_ordering String::operator<=>(const char* input) const {
+        return compareBytes(data, size, input, input ? strlen(input) : 0);
+    }
+
     char& String::operator[](size_t index) {
         if (index >= size) {
             throw std::out_of_range("Index out of range");
@@ -409,4 +448,25 @@ namespace zen::corex {
     char* String::toCharArray() const {
         return data;
     }
-}
\ No newline at end of file
+
+    void String::save(const std::string& path) const {
+        detail::BinaryHeader header;
+        header.kind = detail::BinaryKind::String;
+        header.elementSize = 1;
+        header.count = size;
+
+        std::span<const char> parts[] = {{data, size}};
+        detail::writeBinary(path, header, parts);
+    }
+
+    String String::load(const std::string& path) {
+        detail::BinaryHeader header;
+        std::vector<char> payload = detail::readBinary(path, detail::BinaryKind::String, header);
+
+        if (header.count != payload.size()) {
+            throw std::runtime_error("Invalid binary file: " + path);
+        }
+
+        return String(std::string(payload.data(), payload.size()));
+    }
+}
@@ -3,6 +3,7 @@
 #include <iostream>
 #include <string>
 #include <cstring>
+#include <compare>
 
 using std::cout, std::cin, std::endl;
 
@@ -51,6 +52,15 @@ namespace zen::corex {
              */
             void initialize(const std::string& input);
 
+            /**
+             * @brief Exchanges the buffers of two strings
+             * @param other String to exchange with
+             *
+             * Used by the assignment operators, which build the new buffer
+             * in a temporary first so a failure leaves this string intact.
+             */
+            void swap(String& other) noexcept;
+
         public:
             /**
              * @brief Constructs an empty string
@@ -192,7 +202,7 @@ namespace zen::corex {
              * @param input String to compare with
              * @return true If strings are identical
              * @return false Otherwise
-             * @complexity O(n) where n is the length of the strings
+             * @complexity O(1) if the sizes differ, otherwise O(n) with memcmp; embedded NUL characters are compared too
              */
             bool operator==(const String& input) const;
 
@@ -241,6 +251,31 @@ namespace zen::corex {
              */
             bool operator!=(const char* input) const;
 
+            /**
+             * @brief Three-way comparison with String
+             * @param input String to compare with
+             * @return std::strong_ordering Lexicographic order of the bytes, compared as unsigned;
+             *         a proper prefix orders first
+             * @complexity O(n), a single memcmp of the common prefix
+             */
+            std::strong_ordering operator<=>(const String& input) const;
+
+            /**
+             * @brief Three-way comparison with std::string
+             * @param input std::string to compare with
+             * @return std::strong_ordering Same order as for two Strings
+             * @complexity O(n)
+             */
+            std::strong_ordering operator<=>(const std::string& input) const;
+
+            /**
+             * @brief Three-way comparison with C-string
+             * @param input C-string to compare with (null-terminated)
+             * @return std::strong_ordering Same order as for two Strings
+             * @complexity O(n)
+             */
+            std::strong_ordering operator<=>(const char* input) const;
+
             /**
              * @brief Accesses character at specified index (non-const)
              * @param index Position of the character to access (0-based)
@@ -446,5 +481,27 @@ namespace zen::corex {
              * @complexity O(n)
              */
             char* toCharArray() const;
+
+            /**
+             * @brief Writes the string to a compact binary file
+             *
+             * The file holds a 64-byte header with the length and a checksum,
+             * followed by the raw bytes; embedded NUL characters are kept.
+             *
+             * @param path File to create or overwrite
+             * @throws std::runtime_error if the file cannot be written
+             * @complexity O(n)
+             */
+            void save(const std::string& path) const;
+
+            /**
+             * @brief Reads a string written by save()
+             *
+             * @param path File written by save()
+             * @return String The loaded string
+             * @throws std::runtime_error if the file cannot be read or fails its checksum
+             * @complexity O(n)
+             */
+            static String load(const std::string& path);
     };
-}
\ No newline at end of file
+}
@@ -0,0 +1,254 @@
+#include "ThreadPool.h"
+
+#include <pthread.h>
+#include <sched.h>
+
+namespace zen::corex {
+    namespace detail {
+        WorkDeque::Ring::Ring(int64_t capacity) : capacity(capacity), items(new std::atomic<TaskBase*>[capacity]) {}
+
+        TaskBase* WorkDeque::Ring::get(int64_t index) const {
+            return items[index & (capacity - 1)].load(std::memory_order_relaxed);
+        }
+
+        void WorkDeque::Ring::put(int64_t index, TaskBase* task) {
+            items[index & (capacity - 1)].store(task, std::memory_order_relaxed);
+        }
+
+        WorkDeque::WorkDeque() {
+            rings.push_back(std::make_unique<Ring>(256));
+            ring.store(rings.back().get(), std::memory_order_relaxed);
+        }
+
+        void WorkDeque::push(TaskBase* task) {
+            int64_t b = bottom.load(std::memory_order_relaxed);
+            int64_t t = top.load(std::memory_order_acquire);
+            Ring* current = ring.load(std::memory_order_relaxed);
+
+            if (b - t > current->capacity - 1) {
+                auto grown = std::make_unique<Ring>(current->capacity * 2);
+                for (int64_t i = t; i < b; i++) {
+                    grown->put(i, current->get(i));
+                }
+
+                current = grown.get();
+                rings.push_back(std::move(grown));
+                ring.store(current, std::memory_order_release);
+            }
+
+            current->put(b, task);
+            std::atomic_thread_fence(std::memory_order_release);
+            bottom.store(b + 1, std::memory_order_relaxed);
+        }
+
+        TaskBase* WorkDeque::pop() {
+            int64_t b = bottom.load(std::memory_order_relaxed) - 1;
+            Ring* current = ring.load(std::memory_order_relaxed);
+
+            bottom.store(b, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            int64_t t = top.load(std::memory_order_relaxed);
+
+            if (t > b) {
+                bottom.store(b + 1, std::memory_order_relaxed);
+                return nullptr;
+            }
+
+            TaskBase* task = current->get(b);
+
+            if (t == b) {
+                /* Last task: race against thieves for it */
+                if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+                    task = nullptr;
+                }
+
+                bottom.store(b + 1, std::memory_order_relaxed);
+            }
+
+            return task;
+        }
+
+        TaskBase* WorkDeque::steal() {
+            int64_t t = top.load(std::memory_order_acquire);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            int64_t b = bottom.load(std::memory_order_acquire);
+
+            if (t >= b) {
+                return nullptr;
+            }
+
+            TaskBase* task = ring.load(std::memory_order_acquire)->get(t);
+            if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+                return nullptr;
+            }
+
+            return task;
+        }
+
+        size_t WorkDeque::getSize() const {
+            int64_t size = bottom.load(std::memory_order_relaxed) - top.load(std::memory_order_relaxed);
+            return size > 0 ? size : 0;
+        }
+    }
+
+    static thread_local const ThreadPool* currentPool = nullptr;
+    static thread_local size_t currentIndex = static_cast<size_t>(-1);
+
+    ThreadPool::ThreadPool(size_t threads, bool pinThreads) {
+        if (threads == 0) {
+            threads = std::max(1u, std::thread::hardware_concurrency());
+        }
+
+        for (size_t i = 0; i < threads; i++) {
+            workers.push_back(std::make_unique<Worker>());
+        }
+
+        for (size_t i = 0; i < threads; i++) {
+            workers[i]->thread = std::thread(&ThreadPool::workerLoop, this, i, pinThreads);
+        }
+    }
+
+    ThreadPool::~ThreadPool() {
+        stopping.store(true);
+        signal.fetch_add(1);
+        signal.notify_all();
+
+        for (auto& worker : workers) {
+            worker->thread.join();
+        }
+    }
+
+    size_t ThreadPool::getThreadCount() const {
+        return workers.size();
+    }
+
+    size_t ThreadPool::currentWorker() const {
+        return currentPool == this ? currentIndex : static_cast<size_t>(-1);
+    }
+
+    ThreadPool& ThreadPool::global() {
+        static ThreadPool pool;
+        return pool;
+    }
+
+    void ThreadPool::wake() {
+        /* Pairs with the seq_cst increment of sleeping in workerLoop */
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        if (sleeping.load(std::memory_order_relaxed) > 0) {
+            signal.fetch_add(1, std::memory_order_release);
+            signal.notify_one();
+        }
+    }
+
+    void ThreadPool::push(detail::TaskBase* task) {
+        size_t self = currentWorker();
+
+        if (self != static_cast<size_t>(-1)) {
+            workers[self]->deque.push(task);
+        } else {
+            std::lock_guard<std::mutex> lock(sharedMutex);
+            shared.push_back(task);
+            sharedSize.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        wake();
+    }
+
+    detail::TaskBase* ThreadPool::findTask(size_t self, uint64_t& seed) {
+        if (self != static_cast<size_t>(-1)) {
+            if (detail::TaskBase* task = workers[self]->deque.pop()) {
+                return task;
+            }
+        }
+
+        if (sharedSize.load(std::memory_order_relaxed) > 0) {
+            std::lock_guard<std::mutex> lock(sharedMutex);
+
+            if (!shared.empty()) {
+                detail::TaskBase* task = shared.front();
+                shared.pop_front();
+                sharedSize.fetch_sub(1, std::memory_order_relaxed);
+
+                return task;
+            }
+        }
+
+        /* Start at a random victim so thieves spread out */
+        seed ^= seed << 13;
+        seed ^= seed >> 7;
+        seed ^= seed << 17;
+
+        size_t count = workers.size();
+        size_t start = seed % count;
+
+        for (size_t i = 0; i < count; i++) {
+            size_t victim = (start + i) % count;
+
+            if (victim != self) {
+                if (detail::TaskBase* task = workers[victim]->deque.steal()) {
+                    return task;
+                }
+            }
+        }
+
+        return nullptr;
+    }
+
+    void ThreadPool::workerLoop(size_t index, bool pin) {
+        currentPool = this;
+        currentIndex = index;
+
+        if (pin) {
+            cpu_set_t allowed;
+            CPU_ZERO(&allowed);
+
+            if (sched_getaffinity(0, sizeof(allowed), &allowed) == 0 && CPU_COUNT(&allowed) > 0) {
+                /* Bind to the (index mod allowed)-th CPU this process may run on */
+                int target = index % CPU_COUNT(&allowed);
+
+                for (int cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+                    if (CPU_ISSET(cpu, &allowed) && target-- == 0) {
+                        cpu_set_t single;
+                        CPU_ZERO(&single);
+                        CPU_SET(cpu, &single);
+
+                        pthread_setaffinity_np(pthread_self(), sizeof(single), &single);
+                        break;
+                    }
+                }
+            }
+        }
+
+        uint64_t seed = 0x9E3779B97F4A7C15ull * (index + 1);
+
+        while (true) {
+            detail::TaskBase* task = findTask(index, seed);
+
+            if (task) {
+                task->run();
+                delete task;
+                continue;
+            }
+
+            uint32_t seen = signal.load(std::memory_order_acquire);
+            sleeping.fetch_add(1, std::memory_order_seq_cst);
+
+            /* Look once more: a task may have been pushed before we were counted as sleeping */
+            task = findTask(index, seed);
+            if (!task && !stopping.load()) {
+                signal.wait(seen, std::memory_order_acquire);
+            }
+
+            sleeping.fetch_sub(1, std::memory_order_relaxed);
+
+            if (task) {
+                task->run();
+                delete task;
+            } else if (stopping.load()) {
+                /* Our own deque is empty and only we can refill it, so nothing is left behind */
+                break;
+            }
+        }
+    }
+}
@@ -0,0 +1,337 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <deque>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace zen::corex {
+    namespace detail {
+        /**
+         * @brief Type-erased unit of work owned by a ThreadPool
+         */
+        struct TaskBase {
+            virtual ~TaskBase() = default;
+
+            virtual void run() = 0;
+        };
+
+        template <typename F>
+        struct TaskImpl : TaskBase {
+            F function;
+
+            template <typename G>
+            explicit TaskImpl(G&& function) : function(std::forward<G>(function)) {}
+
+            void run() override {
+                function();
+            }
+        };
+
+        /**
+         * @brief Chase-Lev work-stealing deque
+         *
+         * The owning worker pushes and pops at the bottom without locking;
+         * other workers steal from the top with a single CAS. The ring grows
+         * when full; old rings are kept until destruction because a thief may
+         * still be reading from them.
+         */
+        class WorkDeque {
+            private:
+                struct Ring {
+                    int64_t capacity;
+                    std::unique_ptr<std::atomic<TaskBase*>[]> items;
+
+                    explicit Ring(int64_t capacity);
+
+                    TaskBase* get(int64_t index) const;
+
+                    void put(int64_t index, TaskBase* task);
+                };
+
+                alignas(64) std::atomic<int64_t> top{0};
+                alignas(64) std::atomic<int64_t> bottom{0};
+                alignas(64) std::atomic<Ring*> ring;
+
+                std::vector<std::unique_ptr<Ring>> rings;   ///< Every ring ever used, owned by the deque
+
+            public:
+                WorkDeque();
+
+                /** @brief Adds a task at the bottom (owner only) */
+                void push(TaskBase* task);
+
+                /** @brief Takes the newest task (owner only), nullptr if empty */
+                TaskBase* pop();
+
+                /** @brief Takes the oldest task (any thread), nullptr if empty or lost a race */
+                TaskBase* steal();
+
+                /** @brief Approximate number of queued tasks */
+                size_t getSize() const;
+        };
+    }
+
+    /**
+     * @brief Fixed-size pool of worker threads with work stealing
+     *
+     * Every worker owns a lock-free deque. Tasks submitted from a worker go
+     * to its own deque and are run newest-first, which keeps recently
+     * touched data in cache; idle workers steal the oldest task of a random
+     * victim, which is usually the biggest remaining piece of work. Tasks
+     * submitted from other threads go through a shared queue.
+     *
+     * Idle workers sleep on a futex and cost nothing until work arrives.
+     *
+     * Example usage:
+     * @code
+     * zen::corex::ThreadPool pool;
+     *
+     * auto answer = pool.submit([] { return 6 * 7; });
+     * cout << answer.get() << endl;   // 42
+     *
+     * std::vector<double> values(1000000);
+     * pool.parallelFor(0, values.size(), [&](size_t i) {
+     *     values[i] = i * 0.5;
+     * });
+     * @endcode
+     *
+     * @note Use wait() instead of std::future::get() inside a task: it runs
+     *       other tasks while waiting, so nested parallelism cannot deadlock.
+     */
+    class ThreadPool {
+        private:
+            struct Worker {
+                detail::WorkDeque deque;
+                std::thread thread;
+            };
+
+            std::vector<std::unique_ptr<Worker>> workers;
+
+            std::mutex sharedMutex;
+            std::deque<detail::TaskBase*> shared;   ///< Tasks submitted from outside the pool
+            std::atomic<size_t> sharedSize{0};
+
+            alignas(64) std::atomic<uint32_t> signal{0};   ///< Bumped to wake sleeping workers
+            alignas(64) std::atomic<size_t> sleeping{0};
+            std::atomic<bool> stopping{false};
+
+            void push(detail::TaskBase* task);
+
+            detail::TaskBase* findTask(size_t self, uint64_t& seed);
+
+            void workerLoop(size_t index, bool pin);
+
+            void wake();
+
+        public:
+            /**
+             * @brief Starts the worker threads
+             *
+             * @param threads Number of workers; 0 uses std::thread::hardware_concurrency()
+             * @param pinThreads If true, worker i is bound to the i-th CPU the process may use
+             */
+            explicit ThreadPool(size_t threads = 0, bool pinThreads = false);
+
+            /**
+             * @brief Runs all queued tasks and joins the workers
+             */
+            ~ThreadPool();
+
+            ThreadPool(const ThreadPool&) = delete;
+
+            ThreadPool& operator=(const ThreadPool&) = delete;
+
+            /**
+             * @brief Queues a fire-and-forget task
+             *
+             * @param function Callable with no arguments; it must not throw
+             *
+             * @complexity O(1), lock-free when called from a worker
+             */
+            template <typename F>
+            void execute(F&& function) {
+                push(new detail::TaskImpl<std::decay_t<F>>(std::forward<F>(function)));
+            }
+
+            /**
+             * @brief Queues a task and returns a future for its result
+             *
+             * @param function Callable to run
+             * @param args Arguments passed to the callable
+             * @return std::future holding the result or the thrown exception
+             */
+            template <typename F, typename... Args>
+            auto submit(F&& function, Args&&... args) -> std::future<std::invoke_result_t<F, Args...>> {
+                using R = std::invoke_result_t<F, Args...>;
+
+                std::packaged_task<R()> task(
+                    [function = std::forward<F>(function), ... args = std::forward<Args>(args)]() mutable {
+                        return std::invoke(function, args...);
+                    });
+
+                std::future<R> future = task.get_future();
+                execute(std::move(task));
+
+                return future;
+            }
+
+            /**
+             * @brief Runs queued tasks on the calling thread until a future is ready
+             *
+             * @param future Future returned by submit()
+             * @return The task's result
+             * @throws Whatever the task threw
+             */
+            template <typename R>
+            R wait(std::future<R>& future) {
+                helpWhile([&] {
+                    return future.wait_for(std::chrono::seconds(0)) != std::future_status::ready;
+                });
+
+                return future.get();
+            }
+
+            /**
+             * @brief Runs queued tasks on the calling thread while a condition holds
+             *
+             * @param busy Predicate checked between tasks
+             */
+            template <typename P>
+            void helpWhile(P&& busy) {
+                uint64_t seed = reinterpret_cast<uintptr_t>(&seed);
+                size_t self = currentWorker();
+
+                while (busy()) {
+                    detail::TaskBase* task = findTask(self, seed);
+
+                    if (task) {
+                        task->run();
+                        delete task;
+                    } else {
+                        std::this_thread::yield();
+                    }
+                }
+            }
+
+            /**
+             * @brief Calls function(from, to) on disjoint sub-ranges covering [begin, end)
+             *
+             * The range is cut into chunks of grain indices that workers (and
+             * the calling thread) claim dynamically, so uneven chunks balance
+             * themselves. Returns when every chunk has run.
+             *
+             * @param begin First index
+             * @param end One past the last index
+             * @param function Callable taking (size_t from, size_t to)
+             * @param grain Indices per chunk; 0 picks about 8 chunks per worker
+             * @throws The first exception thrown by function, after all chunks finished
+             */
+            template <typename F>
+            void parallelForRange(size_t begin, size_t end, F&& function, size_t grain = 0) {
+                if (begin >= end) {
+                    return;
+                }
+
+                size_t count = end - begin;
+                if (grain == 0) {
+                    grain = std::max<size_t>(1, count / (getThreadCount() * 8));
+                }
+
+                size_t chunks = (count + grain - 1) / grain;
+                if (chunks == 1 || getThreadCount() == 1) {
+                    function(begin, end);
+                    return;
+                }
+
+                struct State {
+                    std::atomic<size_t> next;
+                    std::atomic<size_t> active{0};
+                    std::exception_ptr error;
+                    std::mutex errorMutex;
+                };
+
+                auto state = std::make_shared<State>();
+                state->next = begin;
+
+                auto work = [state, end, grain, &function] {
+                    size_t from;
+
+                    while ((from = state->next.fetch_add(grain, std::memory_order_relaxed)) < end) {
+                        try {
+                            function(from, std::min(from + grain, end));
+                        } catch (...) {
+                            std::lock_guard<std::mutex> lock(state->errorMutex);
+                            if (!state->error) {
+                                state->error = std::current_exception();
+                            }
+                        }
+                    }
+                };
+
+                size_t helpers = std::min(chunks - 1, getThreadCount());
+                state->active.store(helpers, std::memory_order_relaxed);
+
+                for (size_t i = 0; i < helpers; i++) {
+                    execute([state, work] {
+                        work();
+                        state->active.fetch_sub(1, std::memory_order_release);
+                    });
+                }
+
+                work();
+                helpWhile([&] {
+                    return state->active.load(std::memory_order_acquire) > 0;
+                });
+
+                if (state->error) {
+                    std::rethrow_exception(state->error);
+                }
+            }
+
+            /**
+             * @brief Calls function(i) for every index in [begin, end) in parallel
+             *
+             * @param begin First index
+             * @param end One past the last index
+             * @param function Callable taking (size_t index)
+             * @param grain Indices per chunk; 0 picks about 8 chunks per worker
+             *
+             * @see parallelForRange()
+             */
+            template <typename F>
+            void parallelFor(size_t begin, size_t end, F&& function, size_t grain = 0) {
+                parallelForRange(begin, end, [&function](size_t from, size_t to) {
+                    for (size_t i = from; i < to; i++) {
+                        function(i);
+                    }
+                }, grain);
+            }
+
+            /**
+             * @brief Returns the number of worker threads
+             */
+            size_t getThreadCount() const;
+
+            /**
+             * @brief Returns the index of the calling worker in its pool
+             *
+             * @return Worker index, or (size_t)-1 if the caller is not a worker of this pool
+             */
+            size_t currentWorker() const;
+
+            /**
+             * @brief Returns the process-wide pool with one worker per hardware thread
+             */
+            static ThreadPool& global();
+    };
+}
@@ -0,0 +1,137 @@
+#include "Capabilities.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <string_view>
+#include <sys/ioctl.h>
+#include <unistd.h>
+
+namespace zen::terminal {
+    static std::atomic<ColorMode> colorMode{ColorMode::Auto};
+
+    static bool isSet(const char* name) {
+        const char* value = getenv(name);
+        return value && *value;
+    }
+
+    static ColorSupport detectColors(bool interactive, std::string_view term) {
+        if (isSet("NO_COLOR")) {
+            return ColorSupport::None;
+        }
+
+        bool forced = isSet("FORCE_COLOR") || isSet("CLICOLOR_FORCE");
+        if (!forced && (!interactive || term.empty() || term == "dumb")) {
+            return ColorSupport::None;
+        }
+
+        const char* colorTerm = getenv("COLORTERM");
+        if (colorTerm) {
+            std::string_view value = colorTerm;
+
+            if (value == "truecolor" || value == "24bit") {
+                return ColorSupport::TrueColor;
+            }
+        }
+
+        if (term.ends_with("-direct")) {
+            return ColorSupport::TrueColor;
+        }
+
+        if (term.find("256color") != std::string_view::npos) {
+            return ColorSupport::Extended;
+        }
+
+        return ColorSupport::Basic;
+    }
+
+    static Capabilities detect() {
+        Capabilities result;
+        const char* term = getenv("TERM");
+
+        result.outputInteractive = isatty(STDOUT_FILENO);
+        result.inputInteractive = isatty(STDIN_FILENO);
+        result.term = term ? term : "";
+        result.colors = detectColors(result.outputInteractive, result.term);
+        result.size = readTerminalSize();
+
+        return result;
+    }
+
+    const Capabilities& capabilities() {
+        static const Capabilities detected = detect();
+        return detected;
+    }
+
+    TerminalSize readTerminalSize() {
+        struct winsize size;
+
+        if (ioctl(STDOUT_FILENO, TIOCGWINSZ, &size) == 0 && size.ws_col > 0 && size.ws_row > 0) {
+            return {size.ws_col, size.ws_row};
+        }
+
+        return {80, 24};
+    }
+
+    void setColorMode(ColorMode mode) {
+        colorMode.store(mode, std::memory_order_relaxed);
+    }
+
+    ColorSupport colorSupport() {
+        switch (colorMode.load(std::memory_order_relaxed)) {
+            case ColorMode::Never:
+                return ColorSupport::None;
+
+            case ColorMode::Always: {
+                ColorSupport detected = capabilities().colors;
+                return detected == ColorSupport::None ? ColorSupport::Basic : detected;
+            }
+
+            case ColorMode::Auto:
+                break;
+        }
+
+        return capabilities().colors;
+    }
+
+    bool colorsEnabled() {
+        return colorSupport() != ColorSupport::None;
+    }
+
+    /* Index of the nearest level of the 6x6x6 palette cube: 0, 95, 135, 175, 215, 255 */
+    static int cubeLevel(uint8_t value) {
+        return value < 48 ? 0 : value < 115 ? 1 : (value - 35) / 40;
+    }
+
+    std::string foregroundColor(uint8_t red, uint8_t green, uint8_t blue, bool bold) {
+        std::string sequence = bold ? "\u001b[1;" : "\u001b[";
+
+        switch (colorSupport()) {
+            case ColorSupport::None:
+                return "";
+
+            case ColorSupport::TrueColor:
+                sequence += "38;2;" + std::to_string(red) + ";" + std::to_string(green) + ";" + std::to_string(blue);
+                break;
+
+            case ColorSupport::Extended: {
+                int index = 16 + 36 * cubeLevel(red) + 6 * cubeLevel(green) + cubeLevel(blue);
+
+                /* Grays map better onto the 24 step gray ramp */
+                if (red == green && green == blue) {
+                    index = red < 8 ? 16 : red >= 248 ? 231 : 232 + (red - 8) / 10;
+                }
+
+                sequence += "38;5;" + std::to_string(index);
+                break;
+            }
+
+            case ColorSupport::Basic: {
+                int code = (red >= 128 ? 1 : 0) | (green >= 128 ? 2 : 0) | (blue >= 128 ? 4 : 0);
+                sequence += std::to_string(30 + code);
+                break;
+            }
+        }
+
+        return sequence + "m";
+    }
+}
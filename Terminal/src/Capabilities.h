@@ -0,0 +1,128 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+namespace zen::terminal {
+
+    /**
+     * @enum ColorSupport
+     * @brief Color depth the output terminal understands.
+     */
+    enum class ColorSupport {
+        None,           /**< No escape sequences (pipe, file or dumb terminal) */
+        Basic,          /**< 8/16 ANSI colors */
+        Extended,       /**< 256 color palette */
+        TrueColor       /**< 24-bit RGB colors */
+    };
+
+    /**
+     * @enum ColorMode
+     * @brief Controls whether colored output is emitted.
+     */
+    enum class ColorMode {
+        Auto,       /**< Color only when the stream is an interactive terminal */
+        Always,     /**< Always emit ANSI color sequences */
+        Never       /**< Never emit ANSI color sequences */
+    };
+
+    /**
+     * @struct TerminalSize
+     * @brief Size of the terminal window in character cells.
+     */
+    struct TerminalSize {
+        /** @brief Number of columns */
+        size_t columns;
+
+        /** @brief Number of rows */
+        size_t rows;
+    };
+
+    /**
+     * @struct Capabilities
+     * @brief What the terminal attached to the process supports.
+     */
+    struct Capabilities {
+        /** @brief Standard output is a terminal */
+        bool outputInteractive;
+
+        /** @brief Standard input is a terminal */
+        bool inputInteractive;
+
+        /** @brief Color depth detected from TERM, COLORTERM, NO_COLOR and FORCE_COLOR */
+        ColorSupport colors;
+
+        /** @brief Window size at detection time (80x24 when unknown) */
+        TerminalSize size;
+
+        /** @brief Value of TERM, empty if unset */
+        std::string term;
+    };
+
+    /**
+     * @brief Returns the capabilities of the terminal.
+     *
+     * Detection runs once per process on first use and the result is
+     * cached, so calling this on every print is cheap.
+     *
+     * Rules, in order:
+     * - NO_COLOR set: no colors
+     * - FORCE_COLOR or CLICOLOR_FORCE set: colors even when piped
+     * - standard output is not a terminal, TERM unset or "dumb": no colors
+     * - COLORTERM is "truecolor"/"24bit" or TERM ends in "-direct": 24-bit
+     * - TERM contains "256color": 256 colors
+     * - otherwise: basic ANSI colors
+     *
+     * @return Reference to the cached capabilities
+     */
+    const Capabilities& capabilities();
+
+    /**
+     * @brief Queries the current window size.
+     *
+     * Unlike capabilities(), this asks the kernel every time, so it
+     * follows window resizes.
+     *
+     * @return Current size, or 80x24 if standard output is not a terminal
+     */
+    TerminalSize readTerminalSize();
+
+    /**
+     * @brief Overrides color detection for the whole process.
+     *
+     * @param mode Auto to follow capabilities(), Always or Never to force
+     */
+    void setColorMode(ColorMode mode);
+
+    /**
+     * @brief Returns the color depth output should use.
+     *
+     * @return capabilities().colors, adjusted by setColorMode()
+     */
+    ColorSupport colorSupport();
+
+    /**
+     * @brief Returns true if colored output should be emitted.
+     */
+    bool colorsEnabled();
+
+    /**
+     * @brief Builds the shortest foreground sequence for an RGB color.
+     *
+     * Emits a 24-bit sequence on true color terminals, the nearest entry of
+     * the 256 color palette on 256 color terminals, the nearest of the 8
+     * basic colors otherwise, and nothing when colors are disabled.
+     *
+     * @param red Red component
+     * @param green Green component
+     * @param blue Blue component
+     * @param bold If true, the sequence also selects bold text
+     * @return Escape sequence, or an empty string
+     *
+     * Example usage:
+     * @code
+     * std::cout << zen::terminal::foregroundColor(255, 128, 0) << "orange" << FR_RESET;
+     * @endcode
+     */
+    std::string foregroundColor(uint8_t red, uint8_t green, uint8_t blue, bool bold = false);
+}
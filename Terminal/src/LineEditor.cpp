@@ -0,0 +1,668 @@
+#include "LineEditor.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <csignal>
+#include <poll.h>
+#include <unistd.h>
+
+namespace zen::terminal {
+    static const std::string_view PASTE_END = "\x1b[201~";
+
+    /* Milliseconds to wait for the rest of an escape sequence before treating ESC as a key */
+    static const int ESCAPE_TIMEOUT = 30;
+
+    static bool isContinuation(char ch) {
+        return (static_cast<unsigned char>(ch) & 0xC0) == 0x80;
+    }
+
+    static size_t previousBoundary(std::string_view text, size_t position) {
+        while (position > 0 && isContinuation(text[--position])) {
+        }
+
+        return position;
+    }
+
+    static size_t nextBoundary(std::string_view text, size_t position) {
+        if (position < text.size()) {
+            position++;
+        }
+
+        while (position < text.size() && isContinuation(text[position])) {
+            position++;
+        }
+
+        return position;
+    }
+
+    static size_t countCharacters(std::string_view text) {
+        size_t count = 0;
+
+        for (char ch : text) {
+            count += !isContinuation(ch);
+        }
+
+        return count;
+    }
+
+    /* Printed width of a prompt, ignoring ANSI color sequences */
+    static size_t displayWidth(std::string_view text) {
+        size_t width = 0;
+
+        for (size_t i = 0; i < text.size(); i++) {
+            if (text[i] == '\x1b' && i + 1 < text.size() && text[i + 1] == '[') {
+                i += 2;
+                while (i < text.size() && (text[i] < 0x40 || text[i] > 0x7e)) {
+                    i++;
+                }
+            } else {
+                width += !isContinuation(text[i]);
+            }
+        }
+
+        return width;
+    }
+
+    static void writeAll(std::string_view text) {
+        while (!text.empty()) {
+            ssize_t written = ::write(STDOUT_FILENO, text.data(), text.size());
+
+            if (written < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+
+                return;
+            }
+
+            text.remove_prefix(written);
+        }
+    }
+
+    History::History(size_t limit) : limit(limit) {}
+
+    void History::add(const std::string& line) {
+        if (line.empty() || limit == 0 || (!entries.empty() && entries.back() == line)) {
+            return;
+        }
+
+        if (entries.size() == limit) {
+            entries.pop_front();
+        }
+
+        entries.push_back(line);
+    }
+
+    long History::search(std::string_view query, size_t before) const {
+        for (size_t i = std::min(before, entries.size()); i > 0; i--) {
+            if (entries[i - 1].find(query) != std::string::npos) {
+                return i - 1;
+            }
+        }
+
+        return -1;
+    }
+
+    void History::clear() {
+        entries.clear();
+    }
+
+    size_t History::getSize() const {
+        return entries.size();
+    }
+
+    const std::string& History::operator[](size_t index) const {
+        if (index >= entries.size()) {
+            throw std::out_of_range("Index out of range");
+        }
+
+        return entries[index];
+    }
+
+    LineEditor::LineEditor(size_t historyLimit) : history(historyLimit) {}
+
+    History& LineEditor::getHistory() {
+        return history;
+    }
+
+    void LineEditor::insert(std::string_view text) {
+        size_t room = options.inputLimit > buffer.size() ? options.inputLimit - buffer.size() : 0;
+
+        if (text.size() > room) {
+            /* Never cut a multi-byte character in half */
+            while (room > 0 && isContinuation(text[room])) {
+                room--;
+            }
+
+            text = text.substr(0, room);
+        }
+
+        buffer.insert(cursor, text);
+        cursor += text.size();
+    }
+
+    void LineEditor::erase(size_t from, size_t to) {
+        buffer.erase(from, to - from);
+        cursor = from;
+    }
+
+    void LineEditor::showHistory(size_t index) {
+        if (historyIndex == history.getSize()) {
+            stash = buffer;
+        }
+
+        historyIndex = index;
+        buffer = index == history.getSize() ? stash : history[index];
+        cursor = buffer.size();
+    }
+
+    void LineEditor::searchAgain(size_t before) {
+        long found = history.search(query, before);
+
+        /* Keep showing the previous match when nothing older matches */
+        if (found >= 0 || query.empty()) {
+            match = found;
+        }
+    }
+
+    void LineEditor::leaveSearch(bool accept) {
+        searching = false;
+
+        if (accept && match >= 0) {
+            buffer = history[match];
+            cursor = buffer.size();
+            historyIndex = history.getSize();
+        }
+    }
+
+    void LineEditor::press(Key key, bool& done) {
+        if (searching) {
+            switch (key) {
+                case Key::Search:
+                    searchAgain(match >= 0 ? match : history.getSize());
+                    return;
+
+                case Key::Backspace:
+                    query.erase(previousBoundary(query, query.size()));
+                    match = -1;
+                    searchAgain(history.getSize());
+                    return;
+
+                case Key::Cancel:
+                    leaveSearch(false);
+                    return;
+
+                default:
+                    leaveSearch(true);
+                    break;
+            }
+        }
+
+        switch (key) {
+            case Key::Enter:
+                done = true;
+                break;
+
+            case Key::Tab:
+                if (options.tabAccepts) {
+                    done = true;
+                } else {
+                    insert("\t");
+                }
+
+                break;
+
+            case Key::Backspace:
+                if (cursor > 0) {
+                    erase(previousBoundary(buffer, cursor), cursor);
+                }
+
+                break;
+
+            case Key::Delete:
+                if (cursor < buffer.size()) {
+                    size_t at = cursor;
+                    erase(at, nextBoundary(buffer, at));
+                }
+
+                break;
+
+            case Key::EndOfInput:
+                if (buffer.empty()) {
+                    done = true;
+                } else {
+                    press(Key::Delete, done);
+                }
+
+                break;
+
+            case Key::Left:
+                cursor = previousBoundary(buffer, cursor);
+                break;
+
+            case Key::Right:
+                cursor = nextBoundary(buffer, cursor);
+                break;
+
+            case Key::Home:
+                cursor = 0;
+                break;
+
+            case Key::End:
+                cursor = buffer.size();
+                break;
+
+            case Key::Up:
+                if (options.useHistory && historyIndex > 0) {
+                    showHistory(historyIndex - 1);
+                }
+
+                break;
+
+            case Key::Down:
+                if (options.useHistory && historyIndex < history.getSize()) {
+                    showHistory(historyIndex + 1);
+                }
+
+                break;
+
+            case Key::KillStart:
+                erase(0, cursor);
+                break;
+
+            case Key::KillEnd:
+                buffer.erase(cursor);
+                break;
+
+            case Key::KillWord: {
+                size_t from = cursor;
+
+                while (from > 0 && isspace(static_cast<unsigned char>(buffer[from - 1]))) {
+                    from--;
+                }
+
+                while (from > 0 && !isspace(static_cast<unsigned char>(buffer[from - 1]))) {
+                    from--;
+                }
+
+                erase(from, cursor);
+                break;
+            }
+
+            case Key::Search:
+                if (options.useHistory && !options.password) {
+                    searching = true;
+                    query.clear();
+                    match = -1;
+                }
+
+                break;
+
+            case Key::Interrupt:
+                interrupted = true;
+                done = true;
+                break;
+
+            case Key::Redraw:
+                writeAll("\x1b[H\x1b[2J");
+                break;
+
+            case Key::PasteStart:
+                pasting = true;
+                break;
+
+            case Key::Cancel:
+            case Key::Ignored:
+                break;
+        }
+    }
+
+    size_t LineEditor::consumePaste(std::string_view input) {
+        size_t end = input.find(PASTE_END);
+        size_t used;
+
+        if (end != std::string_view::npos) {
+            used = end + PASTE_END.size();
+            pasting = false;
+        } else {
+            /* Hold back a possible partial end marker until more input arrives */
+            size_t escape = input.find('\x1b', input.size() > PASTE_END.size() ? input.size() - PASTE_END.size() : 0);
+            end = escape == std::string_view::npos ? input.size() : escape;
+            used = end;
+        }
+
+        std::string text(input.substr(0, end));
+        size_t out = 0;
+
+        for (size_t i = 0; i < text.size(); i++) {
+            if (text[i] == '\r') {
+                text[out++] = '\n';
+
+                if (i + 1 < text.size() && text[i + 1] == '\n') {
+                    i++;
+                }
+            } else {
+                text[out++] = text[i];
+            }
+        }
+
+        text.resize(out);
+        insert(text);
+
+        return used;
+    }
+
+    size_t LineEditor::consume(std::string_view input, bool more, bool& done) {
+        size_t i = 0;
+
+        while (i < input.size() && !done) {
+            if (pasting) {
+                size_t used = consumePaste(input.substr(i));
+                if (used == 0) {
+                    break;
+                }
+
+                i += used;
+                continue;
+            }
+
+            unsigned char ch = input[i];
+
+            if (ch >= 0x20 && ch != 0x7f) {
+                /* Apply a whole run of printable bytes at once */
+                size_t end = i;
+                while (end < input.size() && static_cast<unsigned char>(input[end]) >= 0x20 && input[end] != 0x7f) {
+                    end++;
+                }
+
+                if (searching) {
+                    query.append(input.substr(i, end - i));
+                    searchAgain(match >= 0 ? match + 1 : history.getSize());
+                } else {
+                    insert(input.substr(i, end - i));
+                }
+
+                i = end;
+                continue;
+            }
+
+            if (ch != 0x1b) {
+                Key key = Key::Ignored;
+
+                switch (ch) {
+                    case 1: key = Key::Home; break;
+                    case 2: key = Key::Left; break;
+                    case 3: key = Key::Interrupt; break;
+                    case 4: key = Key::EndOfInput; break;
+                    case 5: key = Key::End; break;
+                    case 6: key = Key::Right; break;
+                    case 7: key = Key::Cancel; break;
+                    case 8: key = Key::Backspace; break;
+                    case TAB: key = Key::Tab; break;
+                    case ENTER: key = Key::Enter; break;
+                    case 11: key = Key::KillEnd; break;
+                    case 12: key = Key::Redraw; break;
+                    case 13: key = Key::Enter; break;
+                    case 14: key = Key::Down; break;
+                    case 16: key = Key::Up; break;
+                    case 18: key = Key::Search; break;
+                    case 21: key = Key::KillStart; break;
+                    case 23: key = Key::KillWord; break;
+                    case BKSP: key = Key::Backspace; break;
+                }
+
+                press(key, done);
+                i++;
+                continue;
+            }
+
+            std::string_view sequence = input.substr(i);
+
+            if (sequence.size() == 1) {
+                if (more) {
+                    break;
+                }
+
+                press(Key::Cancel, done);
+                i++;
+                continue;
+            }
+
+            Key key = Key::Ignored;
+            size_t length = 2;
+
+            if (sequence[1] == '[') {
+                size_t final = 2;
+                while (final < sequence.size() && (sequence[final] < 0x40 || sequence[final] > 0x7e)) {
+                    final++;
+                }
+
+                if (final == sequence.size()) {
+                    if (more) {
+                        break;
+                    }
+
+                    i = input.size();
+                    continue;
+                }
+
+                std::string_view parameter = sequence.substr(2, final - 2);
+                length = final + 1;
+
+                switch (sequence[final]) {
+                    case 'A': key = Key::Up; break;
+                    case 'B': key = Key::Down; break;
+                    case 'C': key = Key::Right; break;
+                    case 'D': key = Key::Left; break;
+                    case 'H': key = Key::Home; break;
+                    case 'F': key = Key::End; break;
+
+                    case '~':
+                        if (parameter == "1" || parameter == "7") {
+                            key = Key::Home;
+                        } else if (parameter == "4" || parameter == "8") {
+                            key = Key::End;
+                        } else if (parameter == "3") {
+                            key = Key::Delete;
+                        } else if (parameter == "200") {
+                            key = Key::PasteStart;
+                        }
+
+                        break;
+                }
+            } else if (sequence[1] == 'O') {
+                if (sequence.size() < 3) {
+                    if (more) {
+                        break;
+                    }
+
+                    i = input.size();
+                    continue;
+                }
+
+                length = 3;
+
+                switch (sequence[2]) {
+                    case 'A': key = Key::Up; break;
+                    case 'B': key = Key::Down; break;
+                    case 'C': key = Key::Right; break;
+                    case 'D': key = Key::Left; break;
+                    case 'H': key = Key::Home; break;
+                    case 'F': key = Key::End; break;
+                }
+            }
+
+            press(key, done);
+            i += length;
+        }
+
+        return i;
+    }
+
+    void LineEditor::refresh() {
+        if (!options.echo) {
+            return;
+        }
+
+        std::string searchPrompt;
+        std::string_view shownPrompt = prompt, text = buffer;
+        size_t at = cursor;
+
+        if (searching) {
+            searchPrompt = "(reverse-i-search)`" + query + "': ";
+            shownPrompt = searchPrompt;
+
+            if (match >= 0) {
+                text = history[match];
+                at = text.find(query);
+            } else {
+                text = "";
+                at = 0;
+            }
+        }
+
+        size_t promptWidth = displayWidth(shownPrompt);
+        size_t columns = readTerminalSize().columns;
+        size_t available = columns > promptWidth + 1 ? columns - promptWidth - 1 : 1;
+
+        size_t cursorColumn = countCharacters(text.substr(0, at));
+        size_t total = cursorColumn + countCharacters(text.substr(at));
+
+        /* Do not leave empty columns at the end when the line got shorter */
+        scroll = std::min(scroll, total + 1 > available ? total + 1 - available : 0);
+
+        if (cursorColumn < scroll) {
+            scroll = cursorColumn;
+        } else if (cursorColumn >= scroll + available) {
+            scroll = cursorColumn - available + 1;
+        }
+
+        std::string output = "\r";
+        output += shownPrompt;
+
+        size_t character = 0, shown = 0;
+        for (size_t i = 0; i < text.size() && shown < available; i = nextBoundary(text, i), character++) {
+            if (character < scroll) {
+                continue;
+            }
+
+            if (options.password) {
+                output += '*';
+            } else if (static_cast<unsigned char>(text[i]) < 0x20) {
+                output += ' ';
+            } else {
+                output.append(text.substr(i, nextBoundary(text, i) - i));
+            }
+
+            shown++;
+        }
+
+        output += "\x1b[K";
+
+        size_t back = shown - (cursorColumn - scroll);
+        if (back > 0) {
+            output += "\x1b[" + std::to_string(back) + "D";
+        }
+
+        writeAll(output);
+    }
+
+    std::string LineEditor::readFallback() {
+        cout << prompt << std::flush;
+
+        std::string line;
+        std::getline(cin, line);
+
+        if (line.size() > options.inputLimit) {
+            line.resize(options.inputLimit);
+        }
+
+        return line;
+    }
+
+    std::string LineEditor::readLine(const std::string& prompt, const LineEditorOptions& options) {
+        this->prompt = prompt;
+        this->options = options;
+
+        if (!isatty(STDIN_FILENO)) {
+            return readFallback();
+        }
+
+        buffer.clear();
+        cursor = 0;
+        scroll = 0;
+        historyIndex = history.getSize();
+        stash.clear();
+        searching = false;
+        pasting = false;
+        interrupted = false;
+
+        cout << std::flush;
+
+        struct termios saved, raw;
+        tcgetattr(STDIN_FILENO, &saved);
+
+        raw = saved;
+        raw.c_iflag &= ~(ICRNL | IXON);
+        raw.c_lflag &= ~(ICANON | ECHO | IEXTEN | ISIG);
+        raw.c_cc[VMIN] = 1;
+        raw.c_cc[VTIME] = 0;
+
+        tcsetattr(STDIN_FILENO, TCSANOW, &raw);
+        writeAll("\x1b[?2004h");
+
+        if (options.echo) {
+            refresh();
+        } else {
+            writeAll(prompt);
+        }
+
+        bool done = false;
+        char chunk[65536];
+
+        /* Type-ahead left over from the previous line is applied first */
+        pending.erase(0, consume(pending, true, done));
+
+        while (!done) {
+            refresh();
+
+            ssize_t length = ::read(STDIN_FILENO, chunk, sizeof(chunk));
+            if (length < 0 && errno == EINTR) {
+                continue;
+            }
+
+            if (length <= 0) {
+                break;
+            }
+
+            pending.append(chunk, length);
+            pending.erase(0, consume(pending, true, done));
+
+            if (!done && !pending.empty() && !pasting) {
+                struct pollfd input = {STDIN_FILENO, POLLIN, 0};
+
+                if (poll(&input, 1, ESCAPE_TIMEOUT) == 0) {
+                    pending.erase(0, consume(pending, false, done));
+                }
+            }
+        }
+
+        searching = false;
+        refresh();
+
+        writeAll("\x1b[?2004l\r\n");
+        tcsetattr(STDIN_FILENO, TCSANOW, &saved);
+
+        if (interrupted) {
+            buffer.clear();
+            raise(SIGINT);
+            return "";
+        }
+
+        if (options.useHistory && !options.password) {
+            history.add(buffer);
+        }
+
+        return buffer;
+    }
+}
@@ -0,0 +1,190 @@
+#pragma once
+
+#include <deque>
+#include <string>
+#include <string_view>
+
+#include "Terminal.h"
+
+namespace zen::terminal {
+
+    /**
+     * @class History
+     * @brief Bounded list of previously entered lines, oldest first.
+     */
+    class History {
+        private:
+            std::deque<std::string> entries;    ///< Stored lines, oldest first
+            size_t limit;                       ///< Maximum number of stored lines
+
+        public:
+            /**
+             * @brief Creates an empty history.
+             *
+             * @param limit Maximum number of lines kept; the oldest are evicted first
+             */
+            explicit History(size_t limit = 1000);
+
+            /**
+             * @brief Appends a line.
+             *
+             * Empty lines and repeats of the newest line are ignored.
+             *
+             * @param line Line to store
+             */
+            void add(const std::string& line);
+
+            /**
+             * @brief Finds the newest line containing a substring.
+             *
+             * @param query Substring to look for
+             * @param before Only lines with an index lower than this are searched
+             * @return Index of the matching line, or -1 if there is none
+             */
+            long search(std::string_view query, size_t before) const;
+
+            /**
+             * @brief Removes all lines.
+             */
+            void clear();
+
+            /**
+             * @brief Returns the number of stored lines.
+             */
+            size_t getSize() const;
+
+            /**
+             * @brief Accesses a stored line.
+             *
+             * @param index Position of the line, 0 is the oldest
+             * @throws std::out_of_range if index is greater than or equal to size
+             */
+            const std::string& operator[](size_t index) const;
+    };
+
+    /**
+     * @struct LineEditorOptions
+     * @brief Per-call behavior of LineEditor::readLine().
+     */
+    struct LineEditorOptions {
+        /** @brief Maximum number of bytes accepted; extra input is ignored */
+        size_t inputLimit = MAX_INPUT_LIMIT;
+
+        /** @brief Show the line while it is edited */
+        bool echo = true;
+
+        /** @brief Show '*' instead of the typed characters and keep the line out of history */
+        bool password = false;
+
+        /** @brief Accept the line on TAB as well as on Enter */
+        bool tabAccepts = false;
+
+        /** @brief Record the accepted line and allow history navigation */
+        bool useHistory = true;
+    };
+
+    /**
+     * @class LineEditor
+     * @brief Interactive line input with cursor movement, history and paste support.
+     *
+     * The editor switches the terminal to raw mode once per line and reads
+     * standard input in large chunks. A chunk is fully applied to the line
+     * before the screen is redrawn, and bracketed paste is enabled so pasted
+     * text is inserted in one step without being interpreted as keys. Lines
+     * wider than the terminal scroll horizontally around the cursor.
+     *
+     * Supported keys:
+     * - Left/Right, Ctrl-B/Ctrl-F: move one character
+     * - Home/End, Ctrl-A/Ctrl-E: move to start/end of line
+     * - Backspace, Delete, Ctrl-D: delete a character (Ctrl-D on an empty line ends input)
+     * - Ctrl-U/Ctrl-K: delete to start/end of line, Ctrl-W: delete previous word
+     * - Up/Down, Ctrl-P/Ctrl-N: walk the history
+     * - Ctrl-R: incremental reverse history search (Ctrl-R again for older matches, Ctrl-G to cancel)
+     * - Ctrl-C: restores the terminal and raises SIGINT
+     *
+     * If standard input is not a terminal the line is read with std::getline.
+     *
+     * Example usage:
+     * @code
+     * zen::terminal::LineEditor editor;
+     * std::string line;
+     *
+     * while (!(line = editor.readLine("> ")).empty()) {
+     *     process(line);
+     * }
+     * @endcode
+     *
+     * @note Input is read with read(2); bytes already buffered by stdio or
+     *       std::cin are not seen by the editor.
+     */
+    class LineEditor {
+        private:
+            enum class Key {
+                Enter, Tab, Backspace, Delete, Left, Right, Home, End, Up, Down,
+                KillStart, KillEnd, KillWord, Search, Cancel, Interrupt, EndOfInput,
+                Redraw, PasteStart, Ignored
+            };
+
+            History history;
+
+            std::string prompt;
+            LineEditorOptions options;
+
+            std::string buffer;         ///< Line being edited (UTF-8)
+            size_t cursor = 0;          ///< Byte offset of the cursor in buffer
+            size_t scroll = 0;          ///< First visible character when the line is wider than the terminal
+
+            size_t historyIndex = 0;    ///< Entry shown by Up/Down, history.getSize() for the edited line
+            std::string stash;          ///< Edited line saved while walking the history
+
+            bool searching = false;
+            std::string query;          ///< Reverse search text
+            long match = -1;            ///< History index of the current search match
+
+            bool pasting = false;       ///< Inside a bracketed paste
+            bool interrupted = false;   ///< Ctrl-C was pressed
+            std::string pending;        ///< Bytes read but not yet consumed
+
+            void insert(std::string_view text);
+
+            void erase(size_t from, size_t to);
+
+            void showHistory(size_t index);
+
+            void searchAgain(size_t before);
+
+            void leaveSearch(bool accept);
+
+            void press(Key key, bool& done);
+
+            size_t consume(std::string_view input, bool more, bool& done);
+
+            size_t consumePaste(std::string_view input);
+
+            void refresh();
+
+            std::string readFallback();
+
+        public:
+            /**
+             * @brief Creates an editor with an empty history.
+             *
+             * @param historyLimit Maximum number of lines kept in history
+             */
+            explicit LineEditor(size_t historyLimit = 1000);
+
+            /**
+             * @brief Reads one line from the user.
+             *
+             * @param prompt Text shown before the input
+             * @param options Echo, limit and history behavior for this line
+             * @return The entered line, without the terminating Enter
+             */
+            std::string readLine(const std::string& prompt = "", const LineEditorOptions& options = LineEditorOptions());
+
+            /**
+             * @brief Returns the history used by this editor.
+             */
+            History& getHistory();
+    };
+}
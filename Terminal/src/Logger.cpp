@@ -0,0 +1,265 @@
+#include "Logger.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <ctime>
+
+#include "../../TextFile/src/TextFile.h"
+
+namespace zen::terminal {
+    static std::atomic<uint64_t> nextLoggerId{1};
+
+    static bool detectColors(ColorMode mode) {
+        if (mode != ColorMode::Auto) {
+            return mode == ColorMode::Always;
+        }
+
+        return colorsEnabled();
+    }
+
+    static const char* colorOf(MessageType type) {
+        switch (type) {
+            case MessageType::Error:
+                return FR_RED_BOLD;
+
+            case MessageType::Warning:
+                return FR_YELLOW_BOLD;
+
+            case MessageType::Success:
+                return FR_GREEN_BOLD;
+
+            case MessageType::Information:
+                return FR_BLUE_BOLD;
+
+            case MessageType::Normal:
+                break;
+        }
+
+        return nullptr;
+    }
+
+    Logger::ThreadQueue::ThreadQueue(size_t capacity) {
+        size_t rounded = 2;
+        while (rounded < capacity) {
+            rounded <<= 1;
+        }
+
+        mask = rounded - 1;
+        slots = std::make_unique<Record[]>(rounded);
+    }
+
+    Logger::Logger(const LoggerOptions& options) : options(options), id(nextLoggerId++) {
+        colors = options.console && detectColors(options.colors);
+
+        if (!options.filePath.empty()) {
+            file = std::make_unique<zen::file::text::TextFile>(options.filePath);
+
+            /* Fail here instead of on the writer thread if the path is not writable */
+            file->write("", true);
+        }
+
+        writer = std::thread(&Logger::run, this);
+    }
+
+    Logger::~Logger() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+
+        wake.notify_one();
+        writer.join();
+    }
+
+    Logger::ThreadQueue& Logger::localQueue() {
+        /* A thread usually talks to one logger, so this is a one element scan */
+        thread_local std::vector<std::pair<uint64_t, std::shared_ptr<ThreadQueue>>> owned;
+
+        for (auto& [ownerId, queue] : owned) {
+            if (ownerId == id) {
+                return *queue;
+            }
+        }
+
+        auto queue = std::make_shared<ThreadQueue>(options.queueCapacity);
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            queues.push_back(queue);
+        }
+
+        owned.emplace_back(id, queue);
+        return *queue;
+    }
+
+    void Logger::push(std::string_view text, MessageType type) {
+        ThreadQueue& queue = localQueue();
+        size_t tail = queue.tail.load(std::memory_order_relaxed);
+
+        while (tail - queue.head.load(std::memory_order_acquire) > queue.mask) {
+            if (options.overflow == OverflowPolicy::Drop) {
+                dropped.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+
+            wake.notify_one();
+            std::this_thread::yield();
+        }
+
+        Record& record = queue.slots[tail & queue.mask];
+        record.time = std::chrono::system_clock::now();
+        record.type = type;
+        record.text.assign(text.data(), text.size());
+
+        queue.tail.store(tail + 1, std::memory_order_release);
+    }
+
+    void Logger::run() {
+        std::unique_lock<std::mutex> lock(mutex);
+
+        while (true) {
+            wake.wait_for(lock, options.flushInterval, [this] {
+                return stopping || flushRequests != flushCompleted;
+            });
+
+            bool stop = stopping;
+            uint64_t served = flushRequests;
+            auto snapshot = queues;
+
+            lock.unlock();
+            drain(snapshot);
+            snapshot.clear();
+            lock.lock();
+
+            /* Queues of exited threads are only referenced from here once they are empty */
+            std::erase_if(queues, [](const std::shared_ptr<ThreadQueue>& queue) {
+                return queue.use_count() == 1 &&
+                       queue->head.load(std::memory_order_relaxed) == queue->tail.load(std::memory_order_acquire);
+            });
+
+            flushCompleted = served;
+            flushed.notify_all();
+
+            if (stop) {
+                break;
+            }
+        }
+    }
+
+    void Logger::drain(const std::vector<std::shared_ptr<ThreadQueue>>& snapshot) {
+        struct Pending {
+            const Record* record;
+            size_t queue;
+        };
+
+        std::vector<Pending> pending;
+        std::vector<size_t> ends(snapshot.size());
+
+        for (size_t q = 0; q < snapshot.size(); q++) {
+            ThreadQueue& queue = *snapshot[q];
+
+            size_t head = queue.head.load(std::memory_order_relaxed);
+            ends[q] = queue.tail.load(std::memory_order_acquire);
+
+            for (size_t i = head; i != ends[q]; i++) {
+                pending.push_back({&queue.slots[i & queue.mask], q});
+            }
+        }
+
+        size_t droppedNow = dropped.load(std::memory_order_relaxed);
+        if (pending.empty() && droppedNow == droppedReported) {
+            return;
+        }
+
+        std::stable_sort(pending.begin(), pending.end(), [](const Pending& a, const Pending& b) {
+            return a.record->time < b.record->time;
+        });
+
+        std::string console, plain;
+        time_t cachedSecond = -1;
+        char stamp[32] = "";
+
+        auto append = [&](std::chrono::system_clock::time_point time, MessageType type, std::string_view text) {
+            if (options.timestamps) {
+                auto sinceEpoch = time.time_since_epoch();
+                time_t second = std::chrono::duration_cast<std::chrono::seconds>(sinceEpoch).count();
+                int millis = std::chrono::duration_cast<std::chrono::milliseconds>(sinceEpoch).count() % 1000;
+
+                if (second != cachedSecond) {
+                    tm localTime;
+                    localtime_r(&second, &localTime);
+                    strftime(stamp, sizeof(stamp), "%H:%M:%S", &localTime);
+                    cachedSecond = second;
+                }
+
+                char prefix[48];
+                int length = snprintf(prefix, sizeof(prefix), "[%s.%03d] ", stamp, millis);
+
+                console.append(prefix, length);
+                plain.append(prefix, length);
+            }
+
+            const char* color = colors ? colorOf(type) : nullptr;
+            if (color) {
+                console += color;
+            }
+
+            console += text;
+            if (color) {
+                console += FR_RESET;
+            }
+
+            console += '\n';
+
+            plain += text;
+            plain += '\n';
+        };
+
+        if (droppedNow != droppedReported) {
+            append(std::chrono::system_clock::now(), MessageType::Warning,
+                   std::to_string(droppedNow - droppedReported) + " log messages dropped, queue full");
+            droppedReported = droppedNow;
+        }
+
+        for (const Pending& item : pending) {
+            append(item.record->time, item.record->type, item.record->text);
+        }
+
+        /* Release the slots only after their text has been copied out */
+        for (size_t q = 0; q < snapshot.size(); q++) {
+            snapshot[q]->head.store(ends[q], std::memory_order_release);
+        }
+
+        if (options.console) {
+            fwrite(console.data(), 1, console.size(), stdout);
+            fflush(stdout);
+        }
+
+        if (file) {
+            try {
+                file->write(plain, true);
+            } catch (const std::exception&) {
+                /* The writer thread has nobody to report to, the batch is lost */
+            }
+        }
+    }
+
+    void Logger::flush() {
+        std::unique_lock<std::mutex> lock(mutex);
+
+        uint64_t ticket = ++flushRequests;
+        wake.notify_one();
+
+        flushed.wait(lock, [this, ticket] {
+            return flushCompleted >= ticket;
+        });
+    }
+
+    size_t Logger::getDroppedCount() const {
+        return dropped.load(std::memory_order_relaxed);
+    }
+
+    Logger& Logger::global() {
+        static Logger logger;
+        return logger;
+    }
+}
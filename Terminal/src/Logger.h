@@ -0,0 +1,275 @@
+#pragma once
+
+#include <atomic>
+#include <charconv>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "Terminal.h"
+
+/**
+ * @brief Minimum severity compiled into the binary
+ *
+ * Calls to zen::terminal::log<type>() below this level are removed at
+ * compile time. Severities are: 0 Normal, 1 Information, 2 Success,
+ * 3 Warning, 4 Error. Define it before including this header (or with
+ * -DZEN_LOG_MIN_LEVEL=3) to strip chatty output from release builds.
+ */
+#ifndef ZEN_LOG_MIN_LEVEL
+#define ZEN_LOG_MIN_LEVEL 0
+#endif
+
+namespace zen::file::text {
+    class TextFile;
+}
+
+namespace zen::terminal {
+
+    /**
+     * @brief Returns the numeric severity of a message type.
+     *
+     * @param type Message type
+     * @return Severity from 0 (Normal) to 4 (Error)
+     */
+    constexpr int severityOf(MessageType type) {
+        switch (type) {
+            case MessageType::Normal:
+                return 0;
+
+            case MessageType::Information:
+                return 1;
+
+            case MessageType::Success:
+                return 2;
+
+            case MessageType::Warning:
+                return 3;
+
+            case MessageType::Error:
+                return 4;
+        }
+
+        return 0;
+    }
+
+    /**
+     * @enum OverflowPolicy
+     * @brief Behavior of a log call when the calling thread's queue is full.
+     */
+    enum class OverflowPolicy {
+        Drop,       /**< Discard the message and count it as dropped */
+        Block       /**< Wait until the writer thread frees a slot */
+    };
+
+    /**
+     * @struct LoggerOptions
+     * @brief Configuration of a Logger instance.
+     */
+    struct LoggerOptions {
+        /** @brief Slots in each thread's queue (rounded up to a power of two) */
+        size_t queueCapacity = 4096;
+
+        /** @brief Longest time a message waits in a queue before being written */
+        std::chrono::milliseconds flushInterval{10};
+
+        /** @brief What to do when a thread produces faster than the writer drains */
+        OverflowPolicy overflow = OverflowPolicy::Drop;
+
+        /** @brief Color handling for the console sink */
+        ColorMode colors = ColorMode::Auto;
+
+        /** @brief Prefix every line with a HH:MM:SS.mmm timestamp */
+        bool timestamps = true;
+
+        /** @brief Write messages to standard output */
+        bool console = true;
+
+        /** @brief If not empty, messages are also appended to this file */
+        std::string filePath;
+
+        /** @brief Messages below this type are discarded at runtime */
+        MessageType minimumLevel = MessageType::Normal;
+    };
+
+    /**
+     * @class Logger
+     * @brief Asynchronous logger with lock-free per-thread queues.
+     *
+     * Every thread that logs gets its own single-producer ring buffer, so a
+     * log call never takes a lock: it copies the text into a preallocated
+     * slot and publishes it with one atomic store. A background thread
+     * drains all queues, orders the messages by time, formats them and
+     * writes each batch with a single write per sink.
+     *
+     * Slots keep their string capacity between uses, so in steady state a
+     * log call does not allocate.
+     *
+     * Example usage:
+     * @code
+     * zen::terminal::LoggerOptions options;
+     * options.filePath = "service.log";
+     *
+     * zen::terminal::Logger logger(options);
+     * logger.log("connection refused", zen::terminal::MessageType::Error);
+     * logger.flush();
+     * @endcode
+     *
+     * @note Messages are ordered per thread. Messages from different threads
+     *       are ordered by their timestamp within each written batch.
+     */
+    class Logger {
+        private:
+            struct Record {
+                std::chrono::system_clock::time_point time;
+                MessageType type;
+                std::string text;
+            };
+
+            struct ThreadQueue {
+                alignas(64) std::atomic<size_t> head{0};    ///< Next slot the writer reads
+                alignas(64) std::atomic<size_t> tail{0};    ///< Next slot the producer fills
+                alignas(64) size_t mask;
+                std::unique_ptr<Record[]> slots;
+
+                explicit ThreadQueue(size_t capacity);
+            };
+
+            LoggerOptions options;
+            uint64_t id;                                ///< Process-unique id used by thread-local lookup
+            bool colors;
+
+            std::unique_ptr<zen::file::text::TextFile> file;
+
+            std::mutex mutex;
+            std::condition_variable wake;
+            std::condition_variable flushed;
+            std::vector<std::shared_ptr<ThreadQueue>> queues;
+
+            uint64_t flushRequests = 0;
+            uint64_t flushCompleted = 0;
+            bool stopping = false;
+
+            std::atomic<size_t> dropped{0};
+            size_t droppedReported = 0;
+
+            std::thread writer;
+
+            ThreadQueue& localQueue();
+
+            void push(std::string_view text, MessageType type);
+
+            void run();
+
+            void drain(const std::vector<std::shared_ptr<ThreadQueue>>& snapshot);
+
+        public:
+            /**
+             * @brief Creates a logger and starts its writer thread.
+             *
+             * @param options Logger configuration
+             * @exception std::runtime_error Thrown if the log file cannot be opened.
+             */
+            explicit Logger(const LoggerOptions& options = LoggerOptions());
+
+            /**
+             * @brief Writes all pending messages and stops the writer thread.
+             */
+            ~Logger();
+
+            Logger(const Logger&) = delete;
+
+            Logger& operator=(const Logger&) = delete;
+
+            /**
+             * @brief Queues a message for asynchronous output.
+             *
+             * @tparam T Type of the value to log
+             * @param input Value to be logged
+             * @param messageType Type of message determining severity and color
+             *
+             * Strings are copied as-is, arithmetic values are converted with
+             * std::to_chars and every other type is formatted with operator<<.
+             */
+            template <typename T>
+            void log(const T& input, MessageType messageType = MessageType::Normal) {
+                if (severityOf(messageType) < severityOf(options.minimumLevel)) {
+                    return;
+                }
+
+                if constexpr (std::is_convertible_v<const T&, std::string_view>) {
+                    push(std::string_view(input), messageType);
+                } else if constexpr (std::is_arithmetic_v<T> && !std::is_same_v<T, bool> && !std::is_same_v<T, char>) {
+                    char buffer[64];
+                    auto [end, error] = std::to_chars(buffer, buffer + sizeof(buffer), input);
+                    push(std::string_view(buffer, end - buffer), messageType);
+                } else {
+                    std::ostringstream stream;
+                    stream << input;
+                    push(stream.str(), messageType);
+                }
+            }
+
+            /**
+             * @brief Queues a message whose type is known at compile time.
+             *
+             * @tparam messageType Type of message; calls below ZEN_LOG_MIN_LEVEL compile to nothing
+             * @tparam T Type of the value to log
+             * @param input Value to be logged
+             */
+            template <MessageType messageType, typename T>
+            void log(const T& input) {
+                if constexpr (severityOf(messageType) >= ZEN_LOG_MIN_LEVEL) {
+                    log(input, messageType);
+                }
+            }
+
+            /**
+             * @brief Blocks until every message queued before the call is written.
+             */
+            void flush();
+
+            /**
+             * @brief Returns the number of messages discarded because a queue was full.
+             *
+             * @return Dropped message count since construction
+             */
+            size_t getDroppedCount() const;
+
+            /**
+             * @brief Returns the process-wide logger used by zen::terminal::log().
+             *
+             * The global logger is created with default options on first use.
+             *
+             * @return Reference to the global logger
+             */
+            static Logger& global();
+    };
+
+    /**
+     * @brief Logs a value through the global logger.
+     *
+     * @tparam messageType Type of message; calls below ZEN_LOG_MIN_LEVEL compile to nothing
+     * @tparam T Type of the value to log
+     * @param input Value to be logged
+     *
+     * Example usage:
+     * @code
+     * zen::terminal::log<zen::terminal::MessageType::Warning>("disk almost full");
+     * @endcode
+     */
+    template <MessageType messageType, typename T>
+    void log(const T& input) {
+        if constexpr (severityOf(messageType) >= ZEN_LOG_MIN_LEVEL) {
+            Logger::global().log(input, messageType);
+        }
+    }
+}
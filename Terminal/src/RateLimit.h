@@ -0,0 +1,281 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+#include "Terminal.h"
+
+/**
+ * @brief Prints a line at most perSecond times per second from this call site
+ *
+ * Each expansion owns its own RateLimiter, so one noisy call site cannot
+ * silence another. Messages over the limit are counted and reported with
+ * the next message that gets through.
+ *
+ * @code
+ * ZEN_PRINTLN_LIMITED("read failed: " + reason, zen::terminal::MessageType::Error, 10, 20);
+ * @endcode
+ */
+#define ZEN_PRINTLN_LIMITED(input, messageType, perSecond, burst)                               \
+    do {                                                                                        \
+        static zen::terminal::RateLimiter zenRateLimiter((perSecond), (burst));                 \
+        zen::terminal::printlnLimited(zenRateLimiter, (input), (messageType));                  \
+    } while (false)
+
+/**
+ * @brief Prints a line unless it repeats the previous message of this call site
+ *
+ * Consecutive identical messages are collapsed into one line followed by
+ * "last message repeated N times" once a different message arrives.
+ */
+#define ZEN_PRINTLN_COALESCED(input, messageType)                                               \
+    do {                                                                                        \
+        static zen::terminal::MessageCoalescer zenCoalescer;                                    \
+        zen::terminal::printlnCoalesced(zenCoalescer, (input), (messageType));                  \
+    } while (false)
+
+namespace zen::terminal {
+
+    /**
+     * @class RateLimiter
+     * @brief Lock-free token bucket for throttling output.
+     *
+     * Implemented as a generic cell rate algorithm: the whole bucket state
+     * is one atomic timestamp, so admitting a message is a single CAS and
+     * rejecting one is a load, a compare and a relaxed counter increment.
+     *
+     * Example usage:
+     * @code
+     * static zen::terminal::RateLimiter limiter(5, 10);  // 5/s, bursts of 10
+     * if (limiter.tryAcquire()) {
+     *     zen::terminal::println("cache miss", zen::terminal::MessageType::Warning);
+     * }
+     * @endcode
+     */
+    class RateLimiter {
+        private:
+            int64_t interval;       ///< Nanoseconds between two tokens
+            int64_t tolerance;      ///< How far ahead of now the bucket may run (burst)
+
+            alignas(64) std::atomic<int64_t> theoretical{0};   ///< Time at which the bucket is full again
+            alignas(64) std::atomic<size_t> suppressed{0};     ///< Rejected calls since last takeSuppressed()
+
+            static int64_t now() {
+                return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now().time_since_epoch()).count();
+            }
+
+        public:
+            /**
+             * @brief Creates a limiter.
+             *
+             * @param perSecond Sustained number of messages allowed per second
+             * @param burst Number of messages allowed back to back after a quiet period
+             * @throws std::invalid_argument if perSecond is not positive or burst is 0
+             */
+            RateLimiter(double perSecond, size_t burst = 1) {
+                if (perSecond <= 0 || burst == 0) {
+                    throw std::invalid_argument("rate and burst must be positive");
+                }
+
+                interval = static_cast<int64_t>(1e9 / perSecond);
+                tolerance = interval * static_cast<int64_t>(burst - 1);
+            }
+
+            /**
+             * @brief Takes one token if available.
+             *
+             * @return true If the caller may print
+             * @return false If the message must be suppressed; it is counted
+             *
+             * @complexity O(1), lock-free
+             */
+            bool tryAcquire() {
+                int64_t current = now();
+                int64_t expected = theoretical.load(std::memory_order_relaxed);
+                int64_t next;
+
+                do {
+                    int64_t start = std::max(expected, current);
+                    if (start - current > tolerance) {
+                        suppressed.fetch_add(1, std::memory_order_relaxed);
+                        return false;
+                    }
+
+                    next = start + interval;
+                } while (!theoretical.compare_exchange_weak(expected, next, std::memory_order_relaxed));
+
+                return true;
+            }
+
+            /**
+             * @brief Returns and resets the number of suppressed calls.
+             *
+             * @return Calls rejected since the previous call
+             */
+            size_t takeSuppressed() {
+                if (suppressed.load(std::memory_order_relaxed) == 0) {
+                    return 0;
+                }
+
+                return suppressed.exchange(0, std::memory_order_relaxed);
+            }
+    };
+
+    /**
+     * @class MessageCoalescer
+     * @brief Collapses consecutive identical messages into a repeat count.
+     *
+     * Messages are identified by a 64-bit hash of their text. A repeat of
+     * the current message only increments an atomic counter; taking the
+     * mutex and printing is limited to messages that change.
+     *
+     * @note Under concurrent use a repeat racing with a message change may
+     *       be counted toward the new message.
+     */
+    class MessageCoalescer {
+        private:
+            alignas(64) std::atomic<uint64_t> lastHash{0};
+            alignas(64) std::atomic<size_t> repeats{0};
+
+            std::mutex mutex;
+            MessageType lastType = MessageType::Normal;
+
+            void printRepeats(size_t count) {
+                if (count > 0) {
+                    println("last message repeated " + std::to_string(count) + " times", lastType);
+                }
+            }
+
+        public:
+            MessageCoalescer() = default;
+
+            MessageCoalescer(const MessageCoalescer&) = delete;
+
+            MessageCoalescer& operator=(const MessageCoalescer&) = delete;
+
+            /**
+             * @brief Prints the pending repeat count, if any.
+             */
+            ~MessageCoalescer() {
+                flush();
+            }
+
+            /**
+             * @brief Offers a message to the coalescer.
+             *
+             * @tparam Emit Callable that prints the message
+             * @param hash Hash of the message text
+             * @param messageType Type of the message, used for the repeat summary
+             * @param emit Called under the coalescer lock when the message is new
+             * @return true If the message was printed
+             * @return false If it repeated the previous message and was counted
+             */
+            template <typename Emit>
+            bool submit(uint64_t hash, MessageType messageType, Emit&& emit) {
+                if (lastHash.load(std::memory_order_acquire) == hash) {
+                    repeats.fetch_add(1, std::memory_order_relaxed);
+                    return false;
+                }
+
+                std::lock_guard<std::mutex> lock(mutex);
+
+                if (lastHash.load(std::memory_order_relaxed) == hash) {
+                    repeats.fetch_add(1, std::memory_order_relaxed);
+                    return false;
+                }
+
+                printRepeats(repeats.exchange(0, std::memory_order_relaxed));
+
+                emit();
+                lastType = messageType;
+                lastHash.store(hash, std::memory_order_release);
+
+                return true;
+            }
+
+            /**
+             * @brief Prints the repeat count of the current message and resets it.
+             *
+             * The current message stays current, so further repeats keep being
+             * counted.
+             */
+            void flush() {
+                std::lock_guard<std::mutex> lock(mutex);
+                printRepeats(repeats.exchange(0, std::memory_order_relaxed));
+            }
+    };
+
+    /**
+     * @brief Hashes the printed form of a value.
+     *
+     * @tparam T Type of the value
+     * @param input Value to hash
+     * @return 64-bit hash, never 0
+     */
+    template <typename T>
+    uint64_t messageHash(const T& input) {
+        uint64_t hash;
+
+        if constexpr (std::is_convertible_v<const T&, std::string_view>) {
+            hash = std::hash<std::string_view>()(std::string_view(input));
+        } else {
+            std::ostringstream stream;
+            stream << input;
+            hash = std::hash<std::string>()(stream.str());
+        }
+
+        /* 0 marks "no message yet" */
+        return hash ? hash : 1;
+    }
+
+    /**
+     * @brief Prints a line if the limiter has a token available.
+     *
+     * If earlier calls were suppressed, their count is printed first.
+     *
+     * @tparam T Type of the value to print
+     * @param limiter Rate limiter owned by the call site
+     * @param input Value to be printed
+     * @param messageType Type of message determining text color
+     * @return true If the line was printed
+     */
+    template <typename T>
+    bool printlnLimited(RateLimiter& limiter, const T& input, MessageType messageType = MessageType::Normal) {
+        if (!limiter.tryAcquire()) {
+            return false;
+        }
+
+        size_t skipped = limiter.takeSuppressed();
+        if (skipped > 0) {
+            println(std::to_string(skipped) + " messages suppressed", messageType);
+        }
+
+        println(input, messageType);
+        return true;
+    }
+
+    /**
+     * @brief Prints a line unless it is identical to the previous one.
+     *
+     * @tparam T Type of the value to print
+     * @param coalescer Coalescer owned by the call site
+     * @param input Value to be printed
+     * @param messageType Type of message determining text color
+     * @return true If the line was printed
+     */
+    template <typename T>
+    bool printlnCoalesced(MessageCoalescer& coalescer, const T& input, MessageType messageType = MessageType::Normal) {
+        return coalescer.submit(messageHash(input), messageType, [&] {
+            println(input, messageType);
+        });
+    }
+}
@@ -1,6 +1,32 @@
 #include "Terminal.h"
+#include "LineEditor.h"
 
 namespace zen::terminal {
+    const char* messageColor(MessageType messageType) {
+        if (messageType == MessageType::Normal || !colorsEnabled()) {
+            return nullptr;
+        }
+
+        switch(messageType) {
+            case MessageType::Error:
+                return FR_RED_BOLD;
+
+            case MessageType::Warning:
+                return FR_YELLOW_BOLD;
+
+            case MessageType::Success:
+                return FR_GREEN_BOLD;
+
+            case MessageType::Information:
+                return FR_BLUE_BOLD;
+
+            case MessageType::Normal:
+                break;
+        }
+
+        return nullptr;
+    }
+
     void printCharacters(char ch, int length, bool nextLine) {
         for (int i = 0; i < length; i++) {
             cout << ch;
@@ -85,46 +111,16 @@ namespace zen::terminal {
     }
 
     std::string read(const std::string& message, int inputLimit, bool echo, bool password) {
-        std::string result;
+        /* Shared so consecutive reads can recall earlier answers with Up or Ctrl-R */
+        static LineEditor editor;
 
-        char ch;
-        int i = 0;
-
-        cout << message;
+        LineEditorOptions options;
+        options.inputLimit = inputLimit < 0 ? std::string::npos : inputLimit;
+        options.echo = echo;
+        options.password = password;
+        options.tabAccepts = true;
+        options.useHistory = !password;
 
-        do {
-            if (i == inputLimit) {
-                result[i] = '\0';
-                break;
-            }
-
-            ch = getch();
-
-            if (ch == ENTER || ch == TAB) {
-                result[i] = '\0';
-                break;
-            } else if (ch == BKSP) {
-                if (i > 0) {
-                    if (echo) {
-                        cout << "\b \b";
-                    }
-
-                    i--;
-                }
-            } else {
-                if (echo) {
-                    if (password) {
-                        cout << "*";
-                    } else {
-                        cout << ch;
-                    }
-                }
-
-                result[i++] = ch;
-            }
-        } while(true);
-
-        cout << endl;
-        return result.c_str();
+        return editor.readLine(message, options);
     }
 }
\ No newline at end of file
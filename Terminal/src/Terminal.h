@@ -3,6 +3,7 @@
 #include <iostream>
 #include <vector>
 
+#include "Capabilities.h"
 #include "Conio.h"
 
 #define ENTER 10
@@ -110,41 +111,52 @@ namespace zen::terminal {
      */
     int ask(const std::string& message, const std::vector<std::string>& options, bool repeat);
 
+    /**
+     * @brief Reads a line of input with editing support.
+     *
+     * Uses a shared LineEditor, so the user can move the cursor, recall
+     * previous answers and paste large text. Password input is masked and
+     * never stored in history.
+     *
+     * @param message Prompt displayed to the user
+     * @param inputLimit Maximum number of bytes accepted
+     * @param echo If false, the typed text is not shown
+     * @param password If true, '*' is shown for every typed character
+     * @return The entered text, ended by Enter or TAB
+     *
+     * @see LineEditor
+     */
     std::string read(const std::string& message = "", int inputLimit = MAX_INPUT_LIMIT,
                         bool echo = true, bool password = false);
 
+    /**
+     * @brief Returns the escape sequence used for a message type.
+     *
+     * @param messageType Type of message
+     * @return The FR_* sequence, or nullptr for Normal messages and when
+     *         colors are disabled (see colorsEnabled())
+     */
+    const char* messageColor(MessageType messageType);
+
     /**
      * @brief Prints a value to the terminal with optional colored formatting.
      *
+     * Escape sequences are only written when the terminal supports them,
+     * so output piped to a file contains the plain text.
+     *
      * @tparam T Type of the value to print
      * @param input Value to be printed
      * @param messageType Type of message determining text color
      */
     template <typename T>
     void print(T input, MessageType messageType = MessageType::Normal) {
-        switch(messageType) {
-            case MessageType::Normal:
-                cout << input;
-                break;
-
-            case MessageType::Error:
-                cout << FR_RED_BOLD << input;
-                break;
-
-            case MessageType::Warning:
-                cout << FR_YELLOW_BOLD << input;
-                break;
-
-            case MessageType::Success:
-                cout << FR_GREEN_BOLD << input;
-                break;
-
-            case MessageType::Information:
-                cout << FR_BLUE_BOLD << input;
-                break;
-        }
+        const char* color = messageColor(messageType);
 
-        cout << FR_RESET;
+        if (color) {
+            cout << color << input << FR_RESET;
+        } else {
+            cout << input;
+        }
     }
 
     /**